@@ -2,7 +2,7 @@
 
 CFLAGS="-Isrc -Wall -pedantic -Wextra -Werror -g -O0"
 # CFLAGS="-Isrc -O3"
-LDFLAGS="-ldl"
+LDFLAGS="-ldl -pthread"
 
 echo "CC jule"
 gcc -o jule src/driver.c ${CFLAGS} ${LDFLAGS} || exit $?
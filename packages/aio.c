@@ -0,0 +1,871 @@
+#define JULE_IMPL
+#include <jule.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <sys/syscall.h>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#ifdef __NR_io_uring_setup
+#define AIO_URING
+#endif
+#endif
+#endif
+
+/*
+ * Requests are whole-file (or ranged) reads and writes by path. Submitting
+ * one returns a handle right away; aio:wait turns a handle into its result
+ * (the string read, or the number of bytes written) and frees the request.
+ *
+ * With io_uring, the file is opened when the request is submitted and the
+ * transfer is queued on the ring. Queued requests are handed to the kernel
+ * in one io_uring_enter() call when somebody waits, so fanning out over many
+ * files costs few system calls. Short transfers are requeued for the rest.
+ *
+ * Without io_uring (or with JULE_AIO_BACKEND=threads in the environment),
+ * a pool of threads does the open, the transfer and the close.
+ */
+
+#define AIO_THREADS (16)
+#define AIO_ENTRIES (256)
+
+enum {
+    AIO_READ,
+    AIO_WRITE,
+};
+
+typedef struct Aio_Req {
+    int                 kind;
+    char               *path;
+    int                 flags;
+    int                 fd;
+    long long           offset;
+    long long           length;
+    char               *buff;
+    unsigned long long  len;
+    unsigned long long  moved;
+    Jule_String        *src;
+    long long           res;
+    int                 done;
+    struct iovec        iov;
+    struct Aio_Req     *next;
+} Aio_Req;
+
+enum {
+    AIO_NONE,
+    AIO_RING,
+    AIO_POOL,
+};
+
+static int aio_backend;
+
+static pthread_mutex_t  aio_lock      = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t   aio_work_cond = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t   aio_done_cond = PTHREAD_COND_INITIALIZER;
+static Aio_Req         *aio_queue_head;
+static Aio_Req         *aio_queue_tail;
+static pthread_t        aio_threads[AIO_THREADS];
+static int              aio_n_threads;
+static int              aio_stop;
+
+static void aio_free_req(Aio_Req *req) {
+    if (req->src != NULL) {
+        jule_string_release(req->src);
+    } else if (req->buff != NULL) {
+        JULE_FREE(req->buff);
+    }
+    JULE_FREE(req->path);
+    JULE_FREE(req);
+}
+
+/* Opens the request's file and, for reads, sizes and allocates the buffer.
+ * A read never asks for more than what's left of the file. Returns 0 (with
+ * req->res set) on failure. */
+static int aio_open(Aio_Req *req) {
+    struct stat st;
+
+    req->fd = open(req->path, req->flags, 0666);
+    if (req->fd < 0) {
+        req->res = -errno;
+        return 0;
+    }
+
+    if (req->kind == AIO_READ) {
+        if (fstat(req->fd, &st) < 0) {
+            req->res = -errno;
+            close(req->fd);
+            return 0;
+        }
+        req->len = st.st_size > req->offset ? st.st_size - req->offset : 0;
+        if (req->length >= 0 && (unsigned long long)req->length < req->len) {
+            req->len = req->length;
+        }
+        req->buff = JULE_MALLOC(req->len + 1);
+    }
+
+    return 1;
+}
+
+static void aio_transfer(Aio_Req *req) {
+    ssize_t n;
+
+    while (req->moved < req->len) {
+        if (req->kind == AIO_READ) {
+            n = pread(req->fd, req->buff + req->moved, req->len - req->moved, req->offset + req->moved);
+        } else {
+            n = pwrite(req->fd, req->buff + req->moved, req->len - req->moved, req->offset + req->moved);
+        }
+
+        if (n < 0) {
+            if (errno == EINTR) { continue; }
+            req->res = -errno;
+            return;
+        }
+        if (n == 0) { break; }
+
+        req->moved += n;
+    }
+
+    req->res = req->moved;
+}
+
+
+/*
+ * Thread pool.
+ */
+
+static void *aio_worker(void *arg) {
+    Aio_Req *req;
+
+    (void)arg;
+
+    for (;;) {
+        pthread_mutex_lock(&aio_lock);
+        while (aio_queue_head == NULL && !aio_stop) {
+            pthread_cond_wait(&aio_work_cond, &aio_lock);
+        }
+        if (aio_queue_head == NULL) {
+            pthread_mutex_unlock(&aio_lock);
+            break;
+        }
+        req            = aio_queue_head;
+        aio_queue_head = req->next;
+        if (aio_queue_head == NULL) {
+            aio_queue_tail = NULL;
+        }
+        pthread_mutex_unlock(&aio_lock);
+
+        if (aio_open(req)) {
+            aio_transfer(req);
+            close(req->fd);
+        }
+
+        pthread_mutex_lock(&aio_lock);
+        req->done = 1;
+        pthread_cond_broadcast(&aio_done_cond);
+        pthread_mutex_unlock(&aio_lock);
+    }
+
+    return NULL;
+}
+
+static void aio_pool_submit(Aio_Req *req) {
+    pthread_mutex_lock(&aio_lock);
+
+    if (aio_n_threads < AIO_THREADS && aio_queue_head != NULL) {
+        if (pthread_create(&aio_threads[aio_n_threads], NULL, aio_worker, NULL) == 0) {
+            aio_n_threads += 1;
+        }
+    }
+    if (aio_n_threads == 0) {
+        /* Make sure at least one worker exists. */
+        if (pthread_create(&aio_threads[aio_n_threads], NULL, aio_worker, NULL) == 0) {
+            aio_n_threads += 1;
+        }
+    }
+
+    req->next = NULL;
+    if (aio_queue_tail == NULL) {
+        aio_queue_head = req;
+    } else {
+        aio_queue_tail->next = req;
+    }
+    aio_queue_tail = req;
+
+    pthread_cond_signal(&aio_work_cond);
+    pthread_mutex_unlock(&aio_lock);
+}
+
+static int aio_pool_done(Aio_Req *req, int wait) {
+    int done;
+
+    pthread_mutex_lock(&aio_lock);
+    while (wait && !req->done) {
+        pthread_cond_wait(&aio_done_cond, &aio_lock);
+    }
+    done = req->done;
+    pthread_mutex_unlock(&aio_lock);
+
+    return done;
+}
+
+static void aio_pool_stop(void) {
+    int i;
+
+    pthread_mutex_lock(&aio_lock);
+    aio_stop = 1;
+    pthread_cond_broadcast(&aio_work_cond);
+    pthread_mutex_unlock(&aio_lock);
+
+    for (i = 0; i < aio_n_threads; i += 1) {
+        pthread_join(aio_threads[i], NULL);
+    }
+    aio_n_threads = 0;
+    aio_stop      = 0;
+}
+
+
+/*
+ * io_uring, driven with raw system calls.
+ */
+
+#ifdef AIO_URING
+
+typedef struct {
+    int                  fd;
+    unsigned            *sq_head;
+    unsigned            *sq_tail;
+    unsigned            *sq_mask;
+    unsigned            *sq_array;
+    unsigned            *cq_head;
+    unsigned            *cq_tail;
+    unsigned            *cq_mask;
+    struct io_uring_sqe *sqes;
+    struct io_uring_cqe *cqes;
+    void                *sq_ring;
+    size_t               sq_size;
+    void                *cq_ring;
+    size_t               cq_size;
+    size_t               sqes_size;
+    unsigned             sq_entries;
+    unsigned             cq_entries;
+    unsigned             queued;
+    unsigned             in_flight;
+} Aio_Ring;
+
+static Aio_Ring aio_ring;
+
+static int aio_ring_init(void) {
+    struct io_uring_params p;
+    Aio_Ring              *r;
+
+    r = &aio_ring;
+
+    memset(&p, 0, sizeof(p));
+
+    r->fd = syscall(__NR_io_uring_setup, AIO_ENTRIES, &p);
+    if (r->fd < 0) { return 0; }
+
+    r->sq_size   = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    r->cq_size   = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    r->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+
+    r->sq_ring = mmap(NULL, r->sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, r->fd, IORING_OFF_SQ_RING);
+    r->cq_ring = mmap(NULL, r->cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, r->fd, IORING_OFF_CQ_RING);
+    r->sqes    = mmap(NULL, r->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, r->fd, IORING_OFF_SQES);
+
+    if (r->sq_ring == MAP_FAILED || r->cq_ring == MAP_FAILED || r->sqes == MAP_FAILED) {
+        if (r->sq_ring != MAP_FAILED) { munmap(r->sq_ring, r->sq_size);   }
+        if (r->cq_ring != MAP_FAILED) { munmap(r->cq_ring, r->cq_size);   }
+        if (r->sqes    != MAP_FAILED) { munmap(r->sqes,    r->sqes_size); }
+        close(r->fd);
+        return 0;
+    }
+
+    r->sq_head    = (unsigned*)((char*)r->sq_ring + p.sq_off.head);
+    r->sq_tail    = (unsigned*)((char*)r->sq_ring + p.sq_off.tail);
+    r->sq_mask    = (unsigned*)((char*)r->sq_ring + p.sq_off.ring_mask);
+    r->sq_array   = (unsigned*)((char*)r->sq_ring + p.sq_off.array);
+    r->cq_head    = (unsigned*)((char*)r->cq_ring + p.cq_off.head);
+    r->cq_tail    = (unsigned*)((char*)r->cq_ring + p.cq_off.tail);
+    r->cq_mask    = (unsigned*)((char*)r->cq_ring + p.cq_off.ring_mask);
+    r->cqes       = (struct io_uring_cqe*)((char*)r->cq_ring + p.cq_off.cqes);
+    r->sq_entries = p.sq_entries;
+    r->cq_entries = p.cq_entries;
+
+    return 1;
+}
+
+static void aio_ring_done_all(void);
+
+static void aio_ring_fini(void) {
+    /* Let queued writes land before the ring goes away. */
+    aio_ring_done_all();
+
+    munmap(aio_ring.sq_ring, aio_ring.sq_size);
+    munmap(aio_ring.cq_ring, aio_ring.cq_size);
+    munmap(aio_ring.sqes,    aio_ring.sqes_size);
+    close(aio_ring.fd);
+}
+
+static int aio_ring_enter(unsigned min_complete) {
+    int n;
+
+    do {
+        n = syscall(__NR_io_uring_enter, aio_ring.fd, aio_ring.queued, min_complete,
+                    min_complete > 0 ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+    } while (n < 0 && errno == EINTR);
+
+    if (n < 0) { return -errno; }
+
+    aio_ring.queued    -= n;
+    aio_ring.in_flight += n;
+
+    return 0;
+}
+
+static void aio_ring_finish(Aio_Req *req);
+
+/* Fails the requests that are queued but that the kernel hasn't taken. */
+static void aio_ring_drop(int err) {
+    Aio_Ring *r;
+    unsigned  head;
+    unsigned  tail;
+    Aio_Req  *req;
+
+    r = &aio_ring;
+
+    head = __atomic_load_n(r->sq_head, __ATOMIC_ACQUIRE);
+    tail = *r->sq_tail;
+
+    while (head != tail) {
+        tail -= 1;
+        req   = (void*)r->sqes[r->sq_array[tail & *r->sq_mask]].user_data;
+        req->res = err;
+        aio_ring_finish(req);
+    }
+
+    __atomic_store_n(r->sq_tail, tail, __ATOMIC_RELEASE);
+
+    r->queued = 0;
+}
+
+/* Submits the queue and blocks until something completes. If the kernel
+ * refuses, wait on the ring's descriptor for the requests it already has
+ * instead, and once there are none, fail the ones it wouldn't take, so that
+ * the loops waiting on the ring always make progress. */
+static void aio_ring_wait(void) {
+    int           err;
+    struct pollfd pfd;
+
+    err = aio_ring_enter(1);
+
+    if (err == 0) { return; }
+
+    if (aio_ring.in_flight == 0) {
+        aio_ring_drop(err);
+        return;
+    }
+
+    pfd.fd      = aio_ring.fd;
+    pfd.events  = POLLIN;
+    pfd.revents = 0;
+
+    while (poll(&pfd, 1, -1) < 0 && errno == EINTR);
+}
+
+static void aio_ring_reap(void);
+
+static void aio_ring_queue(Aio_Req *req) {
+    Aio_Ring            *r;
+    unsigned             tail;
+    struct io_uring_sqe *sqe;
+
+    r = &aio_ring;
+
+    /* Keep everything that has been queued within what the completion
+     * queue can hold, and the submission queue from overflowing. */
+    while (r->queued + r->in_flight >= r->cq_entries) {
+        aio_ring_wait();
+        aio_ring_reap();
+    }
+    if (r->queued == r->sq_entries) {
+        aio_ring_enter(0);
+    }
+    while (r->queued == r->sq_entries) {
+        aio_ring_wait();
+        aio_ring_reap();
+    }
+
+    req->iov.iov_base = req->buff + req->moved;
+    req->iov.iov_len  = req->len  - req->moved;
+
+    tail = *r->sq_tail;
+    sqe  = &r->sqes[tail & *r->sq_mask];
+
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode    = req->kind == AIO_READ ? IORING_OP_READV : IORING_OP_WRITEV;
+    sqe->fd        = req->fd;
+    sqe->addr      = (unsigned long long)(void*)&req->iov;
+    sqe->len       = 1;
+    sqe->off       = req->offset + req->moved;
+    sqe->user_data = (unsigned long long)(void*)req;
+
+    r->sq_array[tail & *r->sq_mask] = tail & *r->sq_mask;
+
+    __atomic_store_n(r->sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+    r->queued += 1;
+}
+
+static void aio_ring_finish(Aio_Req *req) {
+    close(req->fd);
+    req->done = 1;
+}
+
+static void aio_ring_reap(void) {
+    Aio_Ring            *r;
+    unsigned             head;
+    struct io_uring_cqe *cqe;
+    Aio_Req             *req;
+
+    r = &aio_ring;
+
+    head = *r->cq_head;
+
+    while (head != __atomic_load_n(r->cq_tail, __ATOMIC_ACQUIRE)) {
+        cqe  = &r->cqes[head & *r->cq_mask];
+        req  = (void*)cqe->user_data;
+        head += 1;
+
+        r->in_flight -= 1;
+
+        if (cqe->res < 0) {
+            req->res = cqe->res;
+            aio_ring_finish(req);
+        } else if (cqe->res == 0) {
+            req->res = req->moved;
+            aio_ring_finish(req);
+        } else {
+            req->moved += cqe->res;
+            if (req->moved < req->len) {
+                /* Short transfer; go again for the rest. Publish the head
+                 * first since queueing may need to reap. */
+                __atomic_store_n(r->cq_head, head, __ATOMIC_RELEASE);
+                aio_ring_queue(req);
+                head = *r->cq_head;
+            } else {
+                req->res = req->moved;
+                aio_ring_finish(req);
+            }
+        }
+    }
+
+    __atomic_store_n(r->cq_head, head, __ATOMIC_RELEASE);
+}
+
+static void aio_ring_done_all(void) {
+    if (aio_ring.queued > 0) {
+        aio_ring_enter(0);
+    }
+
+    while (aio_ring.in_flight > 0 || aio_ring.queued > 0) {
+        aio_ring_wait();
+        aio_ring_reap();
+    }
+}
+
+static void aio_ring_submit(Aio_Req *req) {
+    if (!aio_open(req)) {
+        req->done = 1;
+        return;
+    }
+
+    if (req->len == 0) {
+        req->res = 0;
+        aio_ring_finish(req);
+        return;
+    }
+
+    aio_ring_queue(req);
+}
+
+static int aio_ring_done(Aio_Req *req, int wait) {
+    if (aio_ring.queued > 0) {
+        aio_ring_enter(0);
+    }
+
+    aio_ring_reap();
+
+    while (wait && !req->done) {
+        aio_ring_wait();
+        aio_ring_reap();
+    }
+
+    return req->done;
+}
+
+#endif
+
+
+static void aio_fini(void) {
+    if (aio_backend == AIO_POOL) {
+        aio_pool_stop();
+    }
+#ifdef AIO_URING
+    if (aio_backend == AIO_RING) {
+        aio_ring_fini();
+    }
+#endif
+    aio_backend = AIO_NONE;
+}
+
+static void aio_start(void) {
+    const char *env;
+
+    if (aio_backend != AIO_NONE) { return; }
+
+    env = getenv("JULE_AIO_BACKEND");
+
+#ifdef AIO_URING
+    if ((env == NULL || strcmp(env, "threads") != 0) && aio_ring_init()) {
+        aio_backend = AIO_RING;
+    }
+#else
+    (void)env;
+#endif
+
+    if (aio_backend == AIO_NONE) {
+        aio_backend = AIO_POOL;
+    }
+
+    atexit(aio_fini);
+}
+
+static void aio_submit(Aio_Req *req) {
+    aio_start();
+
+#ifdef AIO_URING
+    if (aio_backend == AIO_RING) {
+        aio_ring_submit(req);
+        return;
+    }
+#endif
+
+    aio_pool_submit(req);
+}
+
+static int aio_done(Aio_Req *req, int wait) {
+#ifdef AIO_URING
+    if (aio_backend == AIO_RING) {
+        return aio_ring_done(req, wait);
+    }
+#endif
+
+    return aio_pool_done(req, wait);
+}
+
+/* A request can't be freed while the kernel or a worker may still be using
+ * its buffer, so dropping an unwaited handle waits for it. */
+static void aio_finalize(void *data) {
+    aio_done(data, 1);
+    aio_free_req(data);
+}
+
+static const Jule_Handle_Type aio_req_type = { "aio", aio_finalize };
+
+static Aio_Req *aio_req(Jule_Value *handle) {
+    return jule_handle_data(handle, &aio_req_type);
+}
+
+/* Waits for the request behind a handle and returns its result, or nil if
+ * it failed or has already been waited on. */
+static Jule_Value *aio_wait_value(Jule_Interp *interp, Jule_Value *handle) {
+    Aio_Req    *req;
+    Jule_Value *result;
+
+    req = aio_req(handle);
+
+    if (req == NULL) {
+        return jule_nil_value();
+    }
+
+    aio_done(req, 1);
+
+    if (req->res < 0) {
+        result = jule_nil_value();
+    } else if (req->kind == AIO_WRITE) {
+        result = jule_number_value(req->res);
+    } else if ((unsigned long long)req->res <= JULE_SSTRING_MAX) {
+        result = jule_string_value_n(interp, req->buff, req->res);
+    } else {
+        req->buff[req->res] = 0;
+        result       = _jule_value();
+        result->type = JULE_STRING;
+        jule_set_heap_string(result, jule_heap_string_consume(req->buff, req->res));
+        req->buff = NULL;
+    }
+
+    jule_close_handle(handle);
+
+    return result;
+}
+
+/* Converts a script number to an offset or length, which must be a whole
+ * number. Makes an error about where and returns 0 if it isn't. */
+static int aio_whole(Jule_Interp *interp, Jule_Value *where, Jule_Value *n, long long *out) {
+    if (!(n->number >= 0) || n->number >= 9223372036854775808.0 || n->number != (double)(long long)n->number) {
+        jule_make_bad_index_error(interp, where, jule_number_value(n->number));
+        return 0;
+    }
+
+    *out = n->number;
+
+    return 1;
+}
+
+/* (aio:read path [offset length]) starts reading a file (or up to length
+ * bytes of it from offset) and returns a handle whose result is the string
+ * read. The offset and length must be whole numbers. */
+static Jule_Status aio_read(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status  status;
+    Jule_Value  *pathv;
+    Jule_Value  *offset;
+    Jule_Value  *length;
+    Aio_Req     *req;
+
+    offset = length = NULL;
+
+    if (n_values > 1) {
+        status = jule_args(interp, tree, "snn", n_values, values, &pathv, &offset, &length);
+    } else {
+        status = jule_args(interp, tree, "s", n_values, values, &pathv);
+    }
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    req = JULE_MALLOC(sizeof(*req));
+    memset(req, 0, sizeof(*req));
+    req->kind   = AIO_READ;
+    req->path   = jule_charptr_dup(jule_string_cstr(pathv));
+    req->flags  = O_RDONLY;
+    req->length = -1;
+
+    if (offset != NULL
+    &&  (!aio_whole(interp, values[1], offset, &req->offset) || !aio_whole(interp, values[2], length, &req->length))) {
+        status  = JULE_ERR_BAD_INDEX;
+        *result = NULL;
+        aio_free_req(req);
+        goto out_free;
+    }
+
+    aio_submit(req);
+
+    *result = jule_handle_value(&aio_req_type, req);
+
+out_free:;
+    jule_free_value(pathv);
+    if (offset != NULL) {
+        jule_free_value(offset);
+        jule_free_value(length);
+    }
+
+out:;
+    return status;
+}
+
+/* (aio:write path string [offset]) starts writing string to a file and
+ * returns a handle whose result is the number of bytes written. Without an
+ * offset the file is truncated first. */
+static Jule_Status aio_write(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status  status;
+    Jule_Value  *pathv;
+    Jule_Value  *string;
+    Jule_Value  *offset;
+    Aio_Req     *req;
+
+    offset = NULL;
+
+    if (n_values > 2) {
+        status = jule_args(interp, tree, "s*n", n_values, values, &pathv, &string, &offset);
+    } else {
+        status = jule_args(interp, tree, "s*", n_values, values, &pathv, &string);
+    }
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    if (string->type != JULE_STRING && string->type != JULE_BUILDER) {
+        status = JULE_ERR_TYPE;
+        jule_make_type_error(interp, values[1], JULE_STRING, string->type);
+        *result = NULL;
+        goto out_free;
+    }
+
+    req = JULE_MALLOC(sizeof(*req));
+    memset(req, 0, sizeof(*req));
+    req->kind  = AIO_WRITE;
+    req->path  = jule_charptr_dup(jule_string_cstr(pathv));
+    req->flags = O_WRONLY | O_CREAT;
+
+    if (offset == NULL) {
+        req->flags |= O_TRUNC;
+    } else if (!aio_whole(interp, values[2], offset, &req->offset)) {
+        status  = JULE_ERR_BAD_INDEX;
+        *result = NULL;
+        aio_free_req(req);
+        goto out_free;
+    }
+
+    /* The characters of heap strings don't change, so the request can just
+     * hold a reference. A view can be detached from its parent (and given
+     * its own copy) while the write is in flight, though, so the reference
+     * is to the string that actually owns the characters. Builders and
+     * inline strings are copied. */
+    if (string->type == JULE_STRING && !jule_string_is_inline(string)) {
+        req->src = string->string->parent != NULL
+                    ? string->string->parent
+                    : string->string;
+        req->buff = string->string->chars;
+        req->len  = string->string->len;
+        jule_string_retain(req->src);
+    } else if (string->type == JULE_BUILDER) {
+        req->len  = string->builder->len;
+        req->buff = JULE_MALLOC(req->len + 1);
+        memcpy(req->buff, string->builder->chars, req->len);
+    } else {
+        req->len  = jule_string_len(string);
+        req->buff = JULE_MALLOC(req->len + 1);
+        memcpy(req->buff, jule_string_chars(string), req->len);
+    }
+
+    aio_submit(req);
+
+    *result = jule_handle_value(&aio_req_type, req);
+
+out_free:;
+    jule_free_value(pathv);
+    jule_free_value(string);
+    if (offset != NULL) {
+        jule_free_value(offset);
+    }
+
+out:;
+    return status;
+}
+
+static Jule_Status aio_wait(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status  status;
+    Jule_Value  *handle;
+
+    status = jule_args(interp, tree, "h", n_values, values, &handle);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    *result = aio_wait_value(interp, handle);
+
+    jule_free_value(handle);
+
+out:;
+    return status;
+}
+
+/* (aio:wait-all handles) waits for every handle in the list and returns a
+ * list of their results in the same order. */
+static Jule_Status aio_wait_all(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status  status;
+    Jule_Value  *handles;
+    Jule_Value  *it;
+
+    status = jule_args(interp, tree, "l", n_values, values, &handles);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    FOR_EACH(handles->list, it) {
+        if (it->type != JULE_HANDLE) {
+            status = JULE_ERR_TYPE;
+            jule_make_type_error(interp, values[0], JULE_HANDLE, it->type);
+            *result = NULL;
+            goto out_free;
+        }
+    }
+
+    *result = jule_list_value();
+
+    FOR_EACH(handles->list, it) {
+        (*result)->list = jule_push((*result)->list, aio_wait_value(interp, it));
+    }
+
+out_free:;
+    jule_free_value(handles);
+
+out:;
+    return status;
+}
+
+/* (aio:done handle) is 1 if waiting on handle would not block. */
+static Jule_Status aio_done_fn(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status  status;
+    Jule_Value  *handle;
+    Aio_Req     *req;
+
+    status = jule_args(interp, tree, "h", n_values, values, &handle);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    req = aio_req(handle);
+
+    *result = jule_number_value(req == NULL || aio_done(req, 0));
+
+    jule_free_value(handle);
+
+out:;
+    return status;
+}
+
+static Jule_Status aio_backend_fn(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status status;
+
+    status = jule_args(interp, tree, "", n_values, values);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    aio_start();
+
+    *result = jule_string_value(interp, aio_backend == AIO_RING ? "io_uring" : "threads");
+
+out:;
+    return status;
+}
+
+Jule_Value *jule_init_package(Jule_Interp *interp) {
+#define JULE_INSTALL_FN(_name, _fn) jule_install_fn(interp, jule_get_string_id(interp, (_name)), (_fn))
+
+    JULE_INSTALL_FN("aio:read",     aio_read);
+    JULE_INSTALL_FN("aio:write",    aio_write);
+    JULE_INSTALL_FN("aio:wait",     aio_wait);
+    JULE_INSTALL_FN("aio:wait-all", aio_wait_all);
+    JULE_INSTALL_FN("aio:done",     aio_done_fn);
+    JULE_INSTALL_FN("aio:backend",  aio_backend_fn);
+
+    return jule_string_value(interp, "aio: Asynchronous file IO package.");
+}
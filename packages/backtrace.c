@@ -9,6 +9,7 @@ static Jule_Status j_backtrace_get(Jule_Interp *interp, Jule_Value *tree, unsign
     int                   status;
     int                   i;
     Jule_Backtrace_Entry *it;
+    Jule_Parse_Location   loc;
     char                 *s;
     char                  buff[4096];
 
@@ -26,12 +27,13 @@ static Jule_Status j_backtrace_get(Jule_Interp *interp, Jule_Value *tree, unsign
 
     for (i = jule_len(interp->backtrace); i > 0; i -= 1) {
         it = jule_elem(interp->backtrace, i - 1);
+        loc = jule_value_location(interp, it->file, it->tree);
 
         s = jule_to_string(interp, it->fn, 0);
         snprintf(buff, sizeof(buff), "%s:%u:%u %s",
                  it->file == NULL ? "<?>" : it->file->chars,
-                 it->fn->line,
-                 it->fn->col,
+                 loc.line,
+                 loc.col,
                  s);
         JULE_FREE(s);
         (*result)->list = jule_push((*result)->list, jule_string_value(interp, buff));
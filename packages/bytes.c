@@ -0,0 +1,1097 @@
+#define JULE_IMPL
+#include <jule.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+/*
+ * Mutable byte buffers for binary data, as "bytes" handle values. A buffer
+ * is a window onto reference counted storage, so bytes:slice shares memory
+ * with the buffer it was taken from and writes through either are visible
+ * in both. bytes:copy makes an independent buffer.
+ *
+ * bytes:pack and bytes:unpack convert between buffers and lists of values
+ * using a format string in the style of Python's struct module:
+ *
+ *     <  >  !  =    Byte order of the fields that follow: little endian
+ *                   (the default), big endian, network (big) or native.
+ *     b B           Signed/unsigned 8-bit integer.
+ *     h H           Signed/unsigned 16-bit integer.
+ *     i I           Signed/unsigned 32-bit integer.
+ *     q Q           Signed/unsigned 64-bit integer (numbers are doubles, so
+ *                   only exact up to 2^53).
+ *     f d           32/64-bit IEEE float.
+ *     Ns            Fixed string of N bytes. Packing pads with NULs and
+ *                   unpacking strips trailing NULs.
+ *     Nx            N bytes of padding (no value).
+ *
+ * A count before any other code repeats it, so "<3I" is three little endian
+ * unsigned 32-bit integers. Whitespace is ignored.
+ *
+ * Packing a number into an integer field truncates any fraction and
+ * saturates at the field's range, so 300 packs into "B" as 255 and -1 as 0.
+ * NaN packs as 0.
+ */
+
+typedef struct {
+    unsigned char      *data;
+    unsigned long long  len;
+    unsigned            refs;
+} B_Store;
+
+typedef struct {
+    B_Store            *store;
+    unsigned long long  off;
+    unsigned long long  len;
+} B_Buf;
+
+typedef struct {
+    char                code;
+    int                 big;
+    unsigned long long  count;
+} B_Field;
+
+typedef struct {
+    B_Field            *fields;
+    unsigned            n_fields;
+    unsigned long long  size;
+    unsigned long long  n_values;
+} B_Format;
+
+static void b_finalize(void *data) {
+    B_Buf *buf;
+
+    buf = data;
+
+    buf->store->refs -= 1;
+    if (buf->store->refs == 0) {
+        JULE_FREE(buf->store->data);
+        JULE_FREE(buf->store);
+    }
+    JULE_FREE(buf);
+}
+
+static const Jule_Handle_Type b_type = { "bytes", b_finalize };
+
+static B_Buf *b_buf(Jule_Value *value) {
+    return jule_handle_data(value, &b_type);
+}
+
+static inline unsigned char *b_data(B_Buf *buf) {
+    return buf->store->data + buf->off;
+}
+
+/* A new zero-filled buffer, or NULL if it can't be allocated. */
+static Jule_Value *b_new(unsigned long long len, B_Buf **out) {
+    B_Store *store;
+    B_Buf   *buf;
+
+    store       = JULE_MALLOC(sizeof(*store));
+    store->data = JULE_MALLOC(len == 0 ? 1 : len);
+    store->len  = len;
+    store->refs = 1;
+
+    if (store->data == NULL) {
+        JULE_FREE(store);
+        return NULL;
+    }
+
+    memset(store->data, 0, len);
+
+    buf        = JULE_MALLOC(sizeof(*buf));
+    buf->store = store;
+    buf->off   = 0;
+    buf->len   = len;
+
+    if (out != NULL) { *out = buf; }
+
+    return jule_handle_value(&b_type, buf);
+}
+
+static Jule_Value *b_view(B_Buf *of, unsigned long long off, unsigned long long len) {
+    B_Buf *buf;
+
+    of->store->refs += 1;
+
+    buf        = JULE_MALLOC(sizeof(*buf));
+    buf->store = of->store;
+    buf->off   = of->off + off;
+    buf->len   = len;
+
+    return jule_handle_value(&b_type, buf);
+}
+
+static int b_native_big(void) {
+    unsigned short x;
+
+    x = 1;
+
+    return *(unsigned char*)&x == 0;
+}
+
+static unsigned long long b_field_size(char code) {
+    switch (code) {
+        case 'b': case 'B': case 's': case 'x': return 1;
+        case 'h': case 'H':                     return 2;
+        case 'i': case 'I': case 'f':           return 4;
+        case 'q': case 'Q': case 'd':           return 8;
+    }
+    return 0;
+}
+
+static void b_free_format(B_Format *fmt) {
+    if (fmt->fields != NULL) {
+        JULE_FREE(fmt->fields);
+    }
+}
+
+/* Converts a number to an offset or length. Fails on NaN, negative,
+ * fractional or out of range numbers. */
+static int b_integer(double d, unsigned long long *out) {
+    if (!(d >= 0) || d >= 18446744073709551616.0 || d != (double)(unsigned long long)d) {
+        return 0;
+    }
+
+    *out = d;
+
+    return 1;
+}
+
+/* Fails if the format is malformed, or if a count or the record size
+ * overflows or is larger than max. */
+static int b_compile(const char *s, unsigned long long len, unsigned long long max, B_Format *fmt) {
+    const char         *end;
+    int                 big;
+    unsigned long long  count;
+    unsigned long long  size;
+    int                 have_count;
+    unsigned            cap;
+
+    memset(fmt, 0, sizeof(*fmt));
+
+    end = s + len;
+    big = 0;
+    cap = 0;
+
+    while (s < end) {
+        if (*s == ' ' || *s == '\t' || *s == '\n') { s += 1; continue; }
+
+        switch (*s) {
+            case '<': big = 0;               s += 1; continue;
+            case '>':
+            case '!': big = 1;               s += 1; continue;
+            case '=': big = b_native_big();  s += 1; continue;
+        }
+
+        count      = 0;
+        have_count = 0;
+        while (s < end && *s >= '0' && *s <= '9') {
+            if (count > (~0ULL - (*s - '0')) / 10) { goto bad; }
+            count      = count * 10 + (*s - '0');
+            have_count = 1;
+            s         += 1;
+        }
+        if (!have_count) { count = 1; }
+
+        if (s == end || (size = b_field_size(*s)) == 0) { goto bad; }
+        if (fmt->size > max || count > (max - fmt->size) / size) { goto bad; }
+
+        if (fmt->n_fields == cap) {
+            cap         = cap == 0 ? 8 : cap << 1;
+            fmt->fields = JULE_REALLOC(fmt->fields, cap * sizeof(*fmt->fields));
+        }
+
+        fmt->fields[fmt->n_fields].code  = *s;
+        fmt->fields[fmt->n_fields].big   = big;
+        fmt->fields[fmt->n_fields].count = count;
+        fmt->n_fields += 1;
+
+        fmt->size += count * size;
+
+        if (*s == 's') {
+            fmt->n_values += 1;
+        } else if (*s != 'x') {
+            fmt->n_values += count;
+        }
+
+        s += 1;
+    }
+
+    return 1;
+
+bad:;
+    b_free_format(fmt);
+    return 0;
+}
+
+static Jule_Status b_format_arg(Jule_Interp *interp, Jule_Value *tree, Jule_Value *fmtv, unsigned long long max, B_Format *fmt) {
+    if (!b_compile(jule_string_chars(fmtv), jule_string_len(fmtv), max, fmt)) {
+        jule_make_bad_value_error(interp, tree, jule_copy(fmtv));
+        return JULE_ERR_BAD_VALUE;
+    }
+
+    return JULE_SUCCESS;
+}
+
+static unsigned long long b_load(const unsigned char *p, int size, int big) {
+    unsigned long long v;
+    int                i;
+
+    v = 0;
+
+    if (big) {
+        for (i = 0; i < size; i += 1)     { v = (v << 8) | p[i]; }
+    } else {
+        for (i = size - 1; i >= 0; i -= 1) { v = (v << 8) | p[i]; }
+    }
+
+    return v;
+}
+
+static void b_store(unsigned char *p, int size, int big, unsigned long long v) {
+    int i;
+
+    if (big) {
+        for (i = size - 1; i >= 0; i -= 1) { p[i] = v & 0xff; v >>= 8; }
+    } else {
+        for (i = 0; i < size; i += 1)     { p[i] = v & 0xff; v >>= 8; }
+    }
+}
+
+static double b_load_number(const unsigned char *p, char code, int big) {
+    unsigned long long  u;
+    unsigned            u32;
+    float               f;
+    double              d;
+    int                 size;
+
+    size = b_field_size(code);
+    u    = b_load(p, size, big);
+
+    switch (code) {
+        case 'b': return (signed char)u;
+        case 'h': return (short)u;
+        case 'i': return (int)u;
+        case 'q': return (long long)u;
+        case 'f':
+            u32 = u;
+            memcpy(&f, &u32, sizeof(f));
+            return f;
+        case 'd':
+            memcpy(&d, &u, sizeof(d));
+            return d;
+    }
+
+    return u;
+}
+
+/* The bits of an integer field holding number, which saturates at the
+ * field's range. Fractions are truncated and NaN is 0. */
+static unsigned long long b_bits(double number, char code) {
+    int                 bits;
+    long long           smin;
+    long long           smax;
+    unsigned long long  umax;
+
+    bits = 8 * b_field_size(code);
+
+    if (number != number) { return 0; }
+
+    if (code == 'b' || code == 'h' || code == 'i' || code == 'q') {
+        smax = bits == 64 ? 0x7fffffffffffffffLL : (1LL << (bits - 1)) - 1;
+        smin = -smax - 1;
+
+        if (number <= (double)smin) { return smin; }
+        if (number >= (double)smax) { return smax; }
+
+        return (long long)number;
+    }
+
+    umax = bits == 64 ? ~0ULL : (1ULL << bits) - 1;
+
+    if (number <= 0)           { return 0;    }
+    if (number >= (double)umax) { return umax; }
+
+    return number;
+}
+
+static void b_store_number(unsigned char *p, char code, int big, double number) {
+    unsigned long long  u;
+    unsigned            u32;
+    float               f;
+
+    switch (code) {
+        case 'f':
+            f = number;
+            memcpy(&u32, &f, sizeof(u32));
+            u = u32;
+            break;
+        case 'd':
+            memcpy(&u, &number, sizeof(u));
+            break;
+        default:
+            u = b_bits(number, code);
+            break;
+    }
+
+    b_store(p, b_field_size(code), big, u);
+}
+
+/* Decodes one record at p into out[0 .. fmt->n_values). */
+static void b_unpack_record(Jule_Interp *interp, const B_Format *fmt, const unsigned char *p, Jule_Value **out) {
+    unsigned            i;
+    unsigned long long  j;
+    unsigned long long  len;
+    const B_Field      *field;
+
+    for (i = 0; i < fmt->n_fields; i += 1) {
+        field = fmt->fields + i;
+
+        switch (field->code) {
+            case 'x':
+                p += field->count;
+                break;
+            case 's':
+                len = field->count;
+                while (len > 0 && p[len - 1] == 0) { len -= 1; }
+                *out++ = jule_string_value_n(interp, (const char*)p, len);
+                p += field->count;
+                break;
+            default:
+                for (j = 0; j < field->count; j += 1) {
+                    *out++ = jule_number_value(b_load_number(p, field->code, field->big));
+                    p += b_field_size(field->code);
+                }
+                break;
+        }
+    }
+}
+
+/* Encodes values (a list holding fmt->n_values values) at p. */
+static Jule_Status b_pack_record(Jule_Interp *interp, Jule_Value *tree, const B_Format *fmt, Jule_Array *values, unsigned char *p) {
+    unsigned            i;
+    unsigned            k;
+    unsigned long long  j;
+    unsigned long long  len;
+    const B_Field      *field;
+    Jule_Value         *v;
+
+    if (jule_len(values) != fmt->n_values) {
+        jule_make_arity_error(interp, tree, fmt->n_values, jule_len(values), 0);
+        return JULE_ERR_ARITY;
+    }
+
+    k = 0;
+
+    for (i = 0; i < fmt->n_fields; i += 1) {
+        field = fmt->fields + i;
+
+        switch (field->code) {
+            case 'x':
+                memset(p, 0, field->count);
+                p += field->count;
+                break;
+            case 's':
+                v = jule_elem(values, k++);
+                if (v->type != JULE_STRING) {
+                    jule_make_type_error(interp, tree, JULE_STRING, v->type);
+                    return JULE_ERR_TYPE;
+                }
+                len = jule_string_len(v);
+                if (len > field->count) { len = field->count; }
+                memcpy(p, jule_string_chars(v), len);
+                memset(p + len, 0, field->count - len);
+                p += field->count;
+                break;
+            default:
+                for (j = 0; j < field->count; j += 1) {
+                    v = jule_elem(values, k++);
+                    if (v->type != JULE_NUMBER) {
+                        jule_make_type_error(interp, tree, JULE_NUMBER, v->type);
+                        return JULE_ERR_TYPE;
+                    }
+                    b_store_number(p, field->code, field->big, v->number);
+                    p += b_field_size(field->code);
+                }
+                break;
+        }
+    }
+
+    return JULE_SUCCESS;
+}
+
+/* Checks that off is a whole number and that [off, off + len) is inside buf.
+ * Sets *offp to the offset. */
+static Jule_Status b_check_range(Jule_Interp *interp, Jule_Value *where, B_Buf *buf, double off, unsigned long long len, unsigned long long *offp) {
+    if (!b_integer(off, offp) || *offp > buf->len || len > buf->len - *offp) {
+        jule_make_bad_index_error(interp, where, jule_number_value(off));
+        return JULE_ERR_BAD_INDEX;
+    }
+
+    return JULE_SUCCESS;
+}
+
+/* (bytes:new length) is a zero-filled buffer, or nil if there isn't enough
+ * memory for it. */
+static Jule_Status j_new(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status         status;
+    Jule_Value         *lenv;
+    unsigned long long  len;
+
+    status = jule_args(interp, tree, "n", n_values, values, &lenv);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    if (!b_integer(lenv->number, &len)) {
+        jule_make_bad_value_error(interp, values[0], jule_number_value(lenv->number));
+        status  = JULE_ERR_BAD_VALUE;
+        *result = NULL;
+    } else if ((*result = b_new(len, NULL)) == NULL) {
+        *result = jule_nil_value();
+    }
+
+    jule_free_value(lenv);
+
+out:;
+    return status;
+}
+
+/* (bytes:from string) copies the characters of a string or builder. */
+static Jule_Status j_from(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status         status;
+    Jule_Value         *string;
+    B_Buf              *buf;
+    const char         *chars;
+    unsigned long long  len;
+
+    status = jule_args(interp, tree, "*", n_values, values, &string);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    if (string->type == JULE_BUILDER) {
+        chars = string->builder->chars;
+        len   = string->builder->len;
+    } else if (string->type == JULE_STRING) {
+        chars = jule_string_chars(string);
+        len   = jule_string_len(string);
+    } else {
+        status = JULE_ERR_TYPE;
+        jule_make_type_error(interp, values[0], JULE_STRING, string->type);
+        *result = NULL;
+        goto out_free;
+    }
+
+    if ((*result = b_new(len, &buf)) == NULL) {
+        *result = jule_nil_value();
+    } else {
+        memcpy(b_data(buf), chars, len);
+    }
+
+out_free:;
+    jule_free_value(string);
+
+out:;
+    return status;
+}
+
+/* (bytes:to-string b) copies the bytes of b into a string. */
+static Jule_Status j_to_string(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status  status;
+    Jule_Value  *bv;
+    B_Buf       *buf;
+
+    status = jule_args(interp, tree, "h", n_values, values, &bv);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    buf = b_buf(bv);
+
+    *result = buf == NULL
+                ? jule_nil_value()
+                : jule_string_value_n(interp, (const char*)b_data(buf), buf->len);
+
+    jule_free_value(bv);
+
+out:;
+    return status;
+}
+
+static Jule_Status j_len(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status  status;
+    Jule_Value  *bv;
+    B_Buf       *buf;
+
+    status = jule_args(interp, tree, "h", n_values, values, &bv);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    buf = b_buf(bv);
+
+    *result = buf == NULL ? jule_nil_value() : jule_number_value(buf->len);
+
+    jule_free_value(bv);
+
+out:;
+    return status;
+}
+
+static Jule_Status j_get(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status         status;
+    Jule_Value         *bv;
+    Jule_Value         *idx;
+    B_Buf              *buf;
+    unsigned long long  i;
+
+    status = jule_args(interp, tree, "hn", n_values, values, &bv, &idx);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    buf = b_buf(bv);
+
+    if (buf == NULL) {
+        *result = jule_nil_value();
+        goto out_free;
+    }
+
+    status = b_check_range(interp, values[1], buf, idx->number, 1, &i);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out_free;
+    }
+
+    *result = jule_number_value(b_data(buf)[i]);
+
+out_free:;
+    jule_free_value(bv);
+    jule_free_value(idx);
+
+out:;
+    return status;
+}
+
+static Jule_Status j_set(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status         status;
+    Jule_Value         *bv;
+    Jule_Value         *idx;
+    Jule_Value         *byte;
+    B_Buf              *buf;
+    unsigned long long  i;
+
+    status = jule_args(interp, tree, "hnn", n_values, values, &bv, &idx, &byte);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    buf = b_buf(bv);
+
+    if (buf == NULL) {
+        *result = jule_nil_value();
+        goto out_free;
+    }
+
+    status = b_check_range(interp, values[1], buf, idx->number, 1, &i);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out_free;
+    }
+
+    b_data(buf)[i] = b_bits(byte->number, 'B');
+
+    *result = jule_number_value(b_data(buf)[i]);
+
+out_free:;
+    jule_free_value(bv);
+    jule_free_value(idx);
+    jule_free_value(byte);
+
+out:;
+    return status;
+}
+
+/* (bytes:slice b offset length) is a buffer that shares length bytes of b
+ * starting at offset. A negative length means through the end of b. */
+static Jule_Status j_slice(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status         status;
+    Jule_Value         *bv;
+    Jule_Value         *off;
+    Jule_Value         *len;
+    B_Buf              *buf;
+    unsigned long long  o;
+    unsigned long long  l;
+
+    status = jule_args(interp, tree, "hnn", n_values, values, &bv, &off, &len);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    buf = b_buf(bv);
+
+    if (buf == NULL) {
+        *result = jule_nil_value();
+        goto out_free;
+    }
+
+    if (len->number < 0) {
+        l = 0;
+    } else if (!b_integer(len->number, &l)) {
+        jule_make_bad_index_error(interp, values[2], jule_number_value(len->number));
+        status = JULE_ERR_BAD_INDEX;
+    }
+
+    if (status == JULE_SUCCESS) {
+        status = b_check_range(interp, values[1], buf, off->number, l, &o);
+    }
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out_free;
+    }
+
+    if (len->number < 0) {
+        l = buf->len - o;
+    }
+
+    *result = b_view(buf, o, l);
+
+out_free:;
+    jule_free_value(bv);
+    jule_free_value(off);
+    jule_free_value(len);
+
+out:;
+    return status;
+}
+
+static Jule_Status j_copy(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status  status;
+    Jule_Value  *bv;
+    B_Buf       *buf;
+    B_Buf       *copy;
+
+    status = jule_args(interp, tree, "h", n_values, values, &bv);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    buf = b_buf(bv);
+
+    if (buf == NULL || (*result = b_new(buf->len, &copy)) == NULL) {
+        *result = jule_nil_value();
+    } else {
+        memcpy(b_data(copy), b_data(buf), buf->len);
+    }
+
+    jule_free_value(bv);
+
+out:;
+    return status;
+}
+
+/* (bytes:pread path offset length) reads length bytes of a file starting at
+ * offset into a new buffer, or through the end of the file if length is
+ * negative. The buffer is shorter if the file is. Returns nil if the file
+ * can't be read or offset or length isn't a whole number. */
+static Jule_Status j_pread(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status         status;
+    Jule_Value         *pathv;
+    Jule_Value         *offv;
+    Jule_Value         *lenv;
+    int                 fd;
+    struct stat         st;
+    unsigned long long  off;
+    unsigned long long  len;
+    unsigned long long  r;
+    B_Buf              *buf;
+    ssize_t             n;
+
+    status = jule_args(interp, tree, "snn", n_values, values, &pathv, &offv, &lenv);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    fd = open(jule_string_cstr(pathv), O_RDONLY);
+    if (fd < 0) {
+        *result = jule_nil_value();
+        goto out_free;
+    }
+
+    len = 0;
+
+    if (!b_integer(offv->number, &off)
+    ||  (lenv->number >= 0 && !b_integer(lenv->number, &len))
+    ||  fstat(fd, &st) < 0) {
+        *result = jule_nil_value();
+        goto out_close;
+    }
+
+    /* Never allocate more than what's left of the file. */
+    if (off >= (unsigned long long)st.st_size) {
+        len = 0;
+    } else if (lenv->number < 0 || len > (unsigned long long)st.st_size - off) {
+        len = st.st_size - off;
+    }
+
+    if ((*result = b_new(len, &buf)) == NULL) {
+        *result = jule_nil_value();
+        goto out_close;
+    }
+
+    r = 0;
+    while (r < len) {
+        n = pread(fd, b_data(buf) + r, len - r, off + r);
+        if (n < 0) {
+            if (errno == EINTR) { continue; }
+            break;
+        }
+        if (n == 0) { break; }
+        r += n;
+    }
+
+    buf->len = r;
+
+out_close:;
+    close(fd);
+
+out_free:;
+    jule_free_value(pathv);
+    jule_free_value(offv);
+    jule_free_value(lenv);
+
+out:;
+    return status;
+}
+
+/* (bytes:pwrite path b offset) writes b into a file at offset, creating the
+ * file if needed, and returns the number of bytes written. */
+static Jule_Status j_pwrite(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status         status;
+    Jule_Value         *pathv;
+    Jule_Value         *bv;
+    Jule_Value         *offv;
+    B_Buf              *buf;
+    int                 fd;
+    unsigned long long  off;
+    unsigned long long  r;
+    ssize_t             n;
+
+    status = jule_args(interp, tree, "shn", n_values, values, &pathv, &bv, &offv);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    buf = b_buf(bv);
+
+    if (buf == NULL
+    ||  !b_integer(offv->number, &off)
+    ||  (fd = open(jule_string_cstr(pathv), O_WRONLY | O_CREAT, 0666)) < 0) {
+        *result = jule_nil_value();
+        goto out_free;
+    }
+
+    r = 0;
+    while (r < buf->len) {
+        n = pwrite(fd, b_data(buf) + r, buf->len - r, off + r);
+        if (n < 0) {
+            if (errno == EINTR) { continue; }
+            break;
+        }
+        r += n;
+    }
+
+    close(fd);
+
+    *result = jule_number_value(r);
+
+out_free:;
+    jule_free_value(pathv);
+    jule_free_value(bv);
+    jule_free_value(offv);
+
+out:;
+    return status;
+}
+
+/* (bytes:size fmt) is the number of bytes in a record of the format. */
+static Jule_Status j_size(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status  status;
+    Jule_Value  *fmtv;
+    B_Format     fmt;
+
+    status = jule_args(interp, tree, "s", n_values, values, &fmtv);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    status = b_format_arg(interp, values[0], fmtv, ~0ULL, &fmt);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out_free;
+    }
+
+    *result = jule_number_value(fmt.size);
+
+    b_free_format(&fmt);
+
+out_free:;
+    jule_free_value(fmtv);
+
+out:;
+    return status;
+}
+
+/* (bytes:pack fmt values) encodes a list of values into a new buffer. */
+static Jule_Status j_pack(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status  status;
+    Jule_Value  *fmtv;
+    Jule_Value  *list;
+    B_Format     fmt;
+    B_Buf       *buf;
+
+    status = jule_args(interp, tree, "sl", n_values, values, &fmtv, &list);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    *result = NULL;
+
+    status = b_format_arg(interp, values[0], fmtv, ~0ULL, &fmt);
+    if (status != JULE_SUCCESS) {
+        goto out_free;
+    }
+
+    if ((*result = b_new(fmt.size, &buf)) == NULL) {
+        *result = jule_nil_value();
+    } else {
+        status = b_pack_record(interp, values[1], &fmt, list->list, b_data(buf));
+        if (status != JULE_SUCCESS) {
+            jule_free_value(*result);
+            *result = NULL;
+        }
+    }
+
+    b_free_format(&fmt);
+
+out_free:;
+    jule_free_value(fmtv);
+    jule_free_value(list);
+
+out:;
+    return status;
+}
+
+/* (bytes:pack-into b offset fmt values) encodes a list of values into b at
+ * offset and returns the offset just past them. */
+static Jule_Status j_pack_into(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status         status;
+    Jule_Value         *bv;
+    Jule_Value         *offv;
+    Jule_Value         *fmtv;
+    Jule_Value         *list;
+    B_Buf              *buf;
+    B_Format            fmt;
+    unsigned long long  off;
+
+    status = jule_args(interp, tree, "hnsl", n_values, values, &bv, &offv, &fmtv, &list);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    *result = NULL;
+
+    buf = b_buf(bv);
+
+    if (buf == NULL) {
+        *result = jule_nil_value();
+        goto out_free;
+    }
+
+    status = b_format_arg(interp, values[2], fmtv, buf->len, &fmt);
+    if (status != JULE_SUCCESS) {
+        goto out_free;
+    }
+
+    status = b_check_range(interp, values[1], buf, offv->number, fmt.size, &off);
+    if (status == JULE_SUCCESS) {
+        status = b_pack_record(interp, values[3], &fmt, list->list, b_data(buf) + off);
+    }
+    if (status == JULE_SUCCESS) {
+        *result = jule_number_value(off + fmt.size);
+    }
+
+    b_free_format(&fmt);
+
+out_free:;
+    jule_free_value(bv);
+    jule_free_value(offv);
+    jule_free_value(fmtv);
+    jule_free_value(list);
+
+out:;
+    return status;
+}
+
+enum {
+    B_ONE,
+    B_ROWS,
+    B_COLUMNS,
+};
+
+/* Decodes one record at an offset, every whole record, or every whole record
+ * column by column, depending on mode. */
+static Jule_Status b_unpack(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result, int mode) {
+    Jule_Status          status;
+    Jule_Value          *fmtv;
+    Jule_Value          *bv;
+    Jule_Value          *offv;
+    B_Buf               *buf;
+    B_Format             fmt;
+    unsigned long long   off;
+    unsigned long long   n_records;
+    unsigned long long   r;
+    unsigned long long   i;
+    Jule_Value         **out;
+    Jule_Value          *record;
+
+    offv = NULL;
+
+    if (mode == B_ONE) {
+        status = jule_args(interp, tree, "shn", n_values, values, &fmtv, &bv, &offv);
+    } else {
+        status = jule_args(interp, tree, "sh", n_values, values, &fmtv, &bv);
+    }
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    *result = NULL;
+
+    buf = b_buf(bv);
+    off = 0;
+
+    if (buf == NULL) {
+        *result = jule_nil_value();
+        goto out_free;
+    }
+
+    status = b_format_arg(interp, values[0], fmtv, mode == B_ONE ? buf->len : ~0ULL, &fmt);
+    if (status != JULE_SUCCESS) {
+        goto out_free;
+    }
+
+    if (mode == B_ONE) {
+        status = b_check_range(interp, values[2], buf, offv->number, fmt.size, &off);
+        if (status != JULE_SUCCESS) {
+            goto out_format;
+        }
+        n_records = 1;
+    } else {
+        n_records = fmt.size == 0 ? 0 : buf->len / fmt.size;
+    }
+
+    out = JULE_MALLOC((fmt.n_values + 1) * sizeof(*out));
+
+    if (mode == B_COLUMNS) {
+        *result = jule_list_value();
+        for (i = 0; i < fmt.n_values; i += 1) {
+            (*result)->list = jule_push((*result)->list, jule_list_value());
+        }
+    } else if (mode == B_ROWS) {
+        *result = jule_list_value();
+    }
+
+    for (r = 0; r < n_records; r += 1) {
+        b_unpack_record(interp, &fmt, b_data(buf) + off + r * fmt.size, out);
+
+        if (mode == B_COLUMNS) {
+            for (i = 0; i < fmt.n_values; i += 1) {
+                record       = jule_elem((*result)->list, i);
+                record->list = jule_push(record->list, out[i]);
+            }
+        } else {
+            record = jule_list_value();
+            for (i = 0; i < fmt.n_values; i += 1) {
+                record->list = jule_push(record->list, out[i]);
+            }
+            if (mode == B_ROWS) {
+                (*result)->list = jule_push((*result)->list, record);
+            } else {
+                *result = record;
+            }
+        }
+    }
+
+    JULE_FREE(out);
+
+out_format:;
+    b_free_format(&fmt);
+
+out_free:;
+    jule_free_value(fmtv);
+    jule_free_value(bv);
+    if (offv != NULL) {
+        jule_free_value(offv);
+    }
+
+out:;
+    return status;
+}
+
+/* (bytes:unpack fmt b offset) decodes one record at offset into a list. */
+static Jule_Status j_unpack(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    return b_unpack(interp, tree, n_values, values, result, B_ONE);
+}
+
+/* (bytes:unpack-all fmt b) decodes b as back-to-back records into a list of
+ * lists. Trailing bytes that don't make up a whole record are ignored. */
+static Jule_Status j_unpack_all(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    return b_unpack(interp, tree, n_values, values, result, B_ROWS);
+}
+
+/* (bytes:unpack-columns fmt b) is like bytes:unpack-all, but returns one list
+ * per value in the format. */
+static Jule_Status j_unpack_columns(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    return b_unpack(interp, tree, n_values, values, result, B_COLUMNS);
+}
+
+Jule_Value *jule_init_package(Jule_Interp *interp) {
+#define JULE_INSTALL_FN(_name, _fn) jule_install_fn(interp, jule_get_string_id(interp, (_name)), (_fn))
+
+    JULE_INSTALL_FN("bytes:new",            j_new);
+    JULE_INSTALL_FN("bytes:from",           j_from);
+    JULE_INSTALL_FN("bytes:to-string",      j_to_string);
+    JULE_INSTALL_FN("bytes:len",            j_len);
+    JULE_INSTALL_FN("bytes:get",            j_get);
+    JULE_INSTALL_FN("bytes:set",            j_set);
+    JULE_INSTALL_FN("bytes:slice",          j_slice);
+    JULE_INSTALL_FN("bytes:copy",           j_copy);
+    JULE_INSTALL_FN("bytes:pread",          j_pread);
+    JULE_INSTALL_FN("bytes:pwrite",         j_pwrite);
+    JULE_INSTALL_FN("bytes:size",           j_size);
+    JULE_INSTALL_FN("bytes:pack",           j_pack);
+    JULE_INSTALL_FN("bytes:pack-into",      j_pack_into);
+    JULE_INSTALL_FN("bytes:unpack",         j_unpack);
+    JULE_INSTALL_FN("bytes:unpack-all",     j_unpack_all);
+    JULE_INSTALL_FN("bytes:unpack-columns", j_unpack_columns);
+
+    return jule_string_value(interp, "bytes: Binary data package.");
+}
@@ -0,0 +1,539 @@
+#define JULE_IMPL
+#include <jule.h>
+
+#include <sys/mman.h>
+
+/*
+ * Delimited text (CSV, TSV, ...) in the style of RFC 4180: fields may be
+ * quoted with '"', quoted fields may contain the delimiter, newlines and
+ * doubled quotes, and records end in "\n" or "\r\n". Empty lines are skipped.
+ *
+ * Both csv:read (a path) and csv:parse (a string) take an optional object of
+ * options:
+ *
+ *     "delim"    string  Field separator (first character). Default ",".
+ *     "header"   number  Whether the first record names the columns. Default 1.
+ *     "columns"  list    Columns to keep, by name (with a header) or by index.
+ *                        Fields of other columns are skipped without being
+ *                        materialized. Default: all of them.
+ *     "numbers"  number  Whether fields that are entirely a number become
+ *                        numbers. Default 1.
+ *     "columnar" number  Return one list per column instead of one value per
+ *                        record. Default 0.
+ *
+ * With a header, records are objects keyed by column name and columnar
+ * output is an object of lists. Without one, records are lists and columnar
+ * output is a list of lists. Missing fields are nil.
+ */
+
+typedef struct {
+    char          delim;
+    int           header;
+    int           numbers;
+    int           columnar;
+    Jule_Value   *columns;
+
+    /* Output slot of each input column, or -1 if it isn't kept. With no
+     * "columns" option and no header, every column is kept as it is seen. */
+    int          *slots;
+    unsigned      n_slots;
+    unsigned      n_out;
+    int           dynamic;
+
+    /* Column names by output slot (with a header). */
+    Jule_Value  **keys;
+
+    /* Output lists by slot (columnar). */
+    Jule_Value  **lists;
+
+    char         *buff;
+    unsigned long long buff_cap;
+} Csv;
+
+/* Stops at the delimiter, '\n' and '\r'. */
+static inline const char *csv_scan(const char *p, const char *end, char delim) {
+#ifdef JULE_VEC_BYTES
+    Jule_Vec v;
+    unsigned mask;
+
+    while (end - p >= JULE_VEC_BYTES) {
+        v    = JULE_VEC_LOAD(p);
+        mask = JULE_VEC_MASK(JULE_VEC_OR(JULE_VEC_EQ(v, JULE_VEC_SET1(delim)),
+                                         JULE_VEC_OR(JULE_VEC_EQ(v, JULE_VEC_SET1('\n')),
+                                                     JULE_VEC_EQ(v, JULE_VEC_SET1('\r')))));
+        if (mask) { return p + __builtin_ctz(mask); }
+        p += JULE_VEC_BYTES;
+    }
+#endif
+
+    while (p < end && *p != delim && *p != '\n' && *p != '\r') { p += 1; }
+
+    return p;
+}
+
+static void csv_buff_append(Csv *csv, unsigned long long *len, const char *s, unsigned long long n) {
+    if (n == 0) { return; }
+
+    if (*len + n > csv->buff_cap) {
+        csv->buff_cap = 2 * (*len + n);
+        csv->buff     = JULE_REALLOC(csv->buff, csv->buff_cap);
+    }
+    memcpy(csv->buff + *len, s, n);
+    *len += n;
+}
+
+/* Reads the field at p. If keep is set, *s and *len are set to its text,
+ * which is either in the input or (for quoted fields) in csv->buff.
+ * Sets *last if the field ends the record. Returns the start of the next field. */
+static const char *csv_next_field(Csv *csv, const char *p, const char *end, int keep, const char **s, unsigned long long *len, int *last) {
+    const char *q;
+    const char *quote;
+
+    if (p < end && *p == '"') {
+        /* Quoted: copy the field out, undoubling quotes. */
+        p    += 1;
+        *len  = 0;
+        for (;;) {
+            quote = memchr(p, '"', end - p);
+            q     = quote == NULL ? end : quote;
+
+            if (keep) { csv_buff_append(csv, len, p, q - p); }
+
+            p = q + (quote != NULL);
+
+            if (quote == NULL || p == end || *p != '"') { break; }
+
+            if (keep) { csv_buff_append(csv, len, "\"", 1); }
+            p += 1;
+        }
+
+        /* Anything between the closing quote and the delimiter is kept as is. */
+        q = csv_scan(p, end, csv->delim);
+        if (keep) {
+            csv_buff_append(csv, len, p, q - p);
+            *s = csv->buff;
+        }
+        p = q;
+    } else {
+        q = csv_scan(p, end, csv->delim);
+        if (keep) {
+            *s   = p;
+            *len = q - p;
+        }
+        p = q;
+    }
+
+    if (p < end && *p == csv->delim) {
+        *last = 0;
+        return p + 1;
+    }
+
+    if (p < end && *p == '\r') { p += 1; }
+    if (p < end && *p == '\n') { p += 1; }
+
+    *last = 1;
+
+    return p;
+}
+
+static const char *csv_skip_blank(const char *p, const char *end) {
+    while (p < end && (*p == '\n' || *p == '\r')) { p += 1; }
+    return p;
+}
+
+static Jule_Value *csv_option(Jule_Value *options, const char *name) {
+    Jule_Value key;
+
+    if (options == NULL) { return NULL; }
+
+    memset(&key, 0, sizeof(key));
+    key.type = JULE_STRING;
+    jule_set_inline_string(&key, name, strlen(name));
+
+    return jule_field(options, &key);
+}
+
+static Jule_Status csv_options(Jule_Interp *interp, Jule_Value *tree, Jule_Value *options, Csv *csv) {
+    Jule_Value *opt;
+
+    csv->delim   = ',';
+    csv->header  = 1;
+    csv->numbers = 1;
+
+    if ((opt = csv_option(options, "delim")) != NULL) {
+        if (opt->type != JULE_STRING || jule_string_len(opt) == 0) {
+            jule_make_type_error(interp, tree, JULE_STRING, opt->type);
+            return JULE_ERR_TYPE;
+        }
+        csv->delim = jule_string_chars(opt)[0];
+    }
+
+#define CSV_FLAG(_name, _field)                                          \
+    if ((opt = csv_option(options, (_name))) != NULL) {                  \
+        if (opt->type != JULE_NUMBER) {                                  \
+            jule_make_type_error(interp, tree, JULE_NUMBER, opt->type);  \
+            return JULE_ERR_TYPE;                                        \
+        }                                                                \
+        csv->_field = opt->number != 0;                                  \
+    }
+
+    CSV_FLAG("header",   header);
+    CSV_FLAG("numbers",  numbers);
+    CSV_FLAG("columnar", columnar);
+
+#undef CSV_FLAG
+
+    if ((opt = csv_option(options, "columns")) != NULL) {
+        if (opt->type != JULE_LIST) {
+            jule_make_type_error(interp, tree, JULE_LIST, opt->type);
+            return JULE_ERR_TYPE;
+        }
+        csv->columns = opt;
+    }
+
+    return JULE_SUCCESS;
+}
+
+static void csv_set_slot(Csv *csv, unsigned col, int slot) {
+    unsigned i;
+
+    if (col >= csv->n_slots) {
+        csv->slots = JULE_REALLOC(csv->slots, (col + 1) * sizeof(*csv->slots));
+        for (i = csv->n_slots; i <= col; i += 1) {
+            csv->slots[i] = -1;
+        }
+        csv->n_slots = col + 1;
+    }
+
+    csv->slots[col] = slot;
+}
+
+/* Adds an output slot (and its list, if columnar) for input column col.
+ * A negative col makes a slot that no input column fills. */
+static void csv_add_slot(Csv *csv, int col, unsigned long long n_records) {
+    Jule_Value *list;
+
+    if (col >= 0) {
+        csv_set_slot(csv, col, csv->n_out);
+    }
+
+    if (csv->columnar) {
+        list = jule_list_value();
+        while (jule_len(list->list) < n_records) {
+            list->list = jule_push(list->list, jule_nil_value());
+        }
+        csv->lists                = JULE_REALLOC(csv->lists, (csv->n_out + 1) * sizeof(*csv->lists));
+        csv->lists[csv->n_out]    = list;
+    }
+
+    csv->n_out += 1;
+}
+
+/* Reads the header (if any) and works out which columns are kept. */
+static Jule_Status csv_setup(Jule_Interp *interp, Jule_Value *tree, Csv *csv, const char **p, const char *end) {
+    Jule_Value         **names;
+    unsigned             n_names;
+    const char          *s;
+    unsigned long long   len;
+    int                  last;
+    Jule_Value          *it;
+    unsigned             i;
+    int                  found;
+
+    names   = NULL;
+    n_names = 0;
+
+    if (csv->header) {
+        *p = csv_skip_blank(*p, end);
+        if (*p < end) {
+            do {
+                *p                = csv_next_field(csv, *p, end, 1, &s, &len, &last);
+                names             = JULE_REALLOC(names, (n_names + 1) * sizeof(*names));
+                names[n_names]    = jule_string_value_n(interp, s, len);
+                n_names          += 1;
+            } while (!last);
+        }
+    }
+
+    if (csv->columns == NULL) {
+        if (csv->header) {
+            for (i = 0; i < n_names; i += 1) {
+                csv_add_slot(csv, i, 0);
+            }
+            csv->keys = names;
+        } else {
+            csv->dynamic = 1;
+        }
+        return JULE_SUCCESS;
+    }
+
+    FOR_EACH(csv->columns->list, it) {
+        if (csv->header && it->type == JULE_STRING) {
+            found = 0;
+            for (i = 0; i < n_names; i += 1) {
+                if (jule_string_len(names[i]) == jule_string_len(it)
+                &&  memcmp(jule_string_chars(names[i]), jule_string_chars(it), jule_string_len(it)) == 0) {
+                    found = 1;
+                    break;
+                }
+            }
+            /* A column that isn't there is all nil. */
+            csv_add_slot(csv, found ? (int)i : -1, 0);
+            csv->keys                 = JULE_REALLOC(csv->keys, csv->n_out * sizeof(*csv->keys));
+            csv->keys[csv->n_out - 1] = jule_copy_force(it);
+        } else if (!csv->header && it->type == JULE_NUMBER && it->number >= 0 && it->number < 1e6) {
+            csv_add_slot(csv, (int)it->number, 0);
+        } else {
+            jule_make_type_error(interp, tree, csv->header ? JULE_STRING : JULE_NUMBER, it->type);
+            for (i = 0; i < n_names; i += 1) { jule_free_value(names[i]); }
+            if (names != NULL) { JULE_FREE(names); }
+            return JULE_ERR_TYPE;
+        }
+    }
+
+    for (i = 0; i < n_names; i += 1) { jule_free_value(names[i]); }
+    if (names != NULL) { JULE_FREE(names); }
+
+    return JULE_SUCCESS;
+}
+
+static Jule_Value *csv_field_value(Jule_Interp *interp, Csv *csv, const char *s, unsigned long long len) {
+    double d;
+
+    if (csv->numbers && len > 0 && jule_parse_number(s, len, &d) == len) {
+        return jule_number_value(d);
+    }
+
+    return jule_string_value_n(interp, s, len);
+}
+
+static Jule_Value *csv_records(Jule_Interp *interp, Csv *csv, const char *p, const char *end) {
+    Jule_Value          *result;
+    Jule_Value          *record;
+    Jule_Value          *value;
+    unsigned long long   n_records;
+    unsigned             col;
+    int                  slot;
+    const char          *s;
+    unsigned long long   len;
+    int                  last;
+    unsigned             i;
+
+    result    = csv->columnar ? NULL : jule_list_value();
+    record    = NULL;
+    n_records = 0;
+
+    for (;;) {
+        p = csv_skip_blank(p, end);
+        if (p == end) { break; }
+
+        if (!csv->columnar) {
+            record = csv->header ? jule_object_value() : jule_list_value();
+        }
+
+        col = 0;
+        do {
+            if (csv->dynamic && col >= csv->n_slots) {
+                csv_add_slot(csv, col, n_records);
+            }
+
+            slot = col < csv->n_slots ? csv->slots[col] : -1;
+            p    = csv_next_field(csv, p, end, slot >= 0, &s, &len, &last);
+            col += 1;
+
+            if (slot < 0) { continue; }
+
+            value = csv_field_value(interp, csv, s, len);
+
+            if (csv->columnar) {
+                csv->lists[slot]->list = jule_push(csv->lists[slot]->list, value);
+            } else if (csv->header) {
+                jule_insert(record, jule_copy_force(csv->keys[slot]), value);
+            } else {
+                while (jule_len(record->list) < (unsigned)slot) {
+                    record->list = jule_push(record->list, jule_nil_value());
+                }
+                if (jule_len(record->list) == (unsigned)slot) {
+                    record->list = jule_push(record->list, value);
+                } else {
+                    jule_free_value(jule_elem(record->list, slot));
+                    record->list->data[slot] = value;
+                }
+            }
+        } while (!last);
+
+        n_records += 1;
+
+        /* Missing fields are nil. */
+        if (csv->columnar) {
+            for (i = 0; i < csv->n_out; i += 1) {
+                if (jule_len(csv->lists[i]->list) < n_records) {
+                    csv->lists[i]->list = jule_push(csv->lists[i]->list, jule_nil_value());
+                }
+            }
+        } else {
+            if (csv->header) {
+                for (i = 0; i < csv->n_out; i += 1) {
+                    if (jule_field(record, csv->keys[i]) == NULL) {
+                        jule_insert(record, jule_copy_force(csv->keys[i]), jule_nil_value());
+                    }
+                }
+            } else {
+                while (jule_len(record->list) < csv->n_out) {
+                    record->list = jule_push(record->list, jule_nil_value());
+                }
+            }
+            result->list = jule_push(result->list, record);
+        }
+    }
+
+    /* Without a header, columns are added as they are seen, so records
+     * read before a wider one are padded to the final width. */
+    if (!csv->columnar && csv->dynamic) {
+        FOR_EACH(result->list, record) {
+            while (jule_len(record->list) < csv->n_out) {
+                record->list = jule_push(record->list, jule_nil_value());
+            }
+        }
+    }
+
+    if (csv->columnar) {
+        result = csv->header ? jule_object_value() : jule_list_value();
+        for (i = 0; i < csv->n_out; i += 1) {
+            if (csv->header) {
+                jule_insert(result, jule_copy_force(csv->keys[i]), csv->lists[i]);
+            } else {
+                result->list = jule_push(result->list, csv->lists[i]);
+            }
+        }
+        if (csv->lists != NULL) {
+            JULE_FREE(csv->lists);
+            csv->lists = NULL;
+        }
+    }
+
+    return result;
+}
+
+static Jule_Status csv_run(Jule_Interp *interp, Jule_Value *tree, Jule_Value *options, const char *s, unsigned long long len, Jule_Value **result) {
+    Jule_Status  status;
+    Csv          csv;
+    const char  *p;
+    unsigned     i;
+
+    memset(&csv, 0, sizeof(csv));
+
+    status = csv_options(interp, tree, options, &csv);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    p = s;
+
+    status = csv_setup(interp, tree, &csv, &p, s + len);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    *result = csv_records(interp, &csv, p, s + len);
+
+out:;
+    if (csv.keys != NULL) {
+        for (i = 0; i < csv.n_out; i += 1) {
+            jule_free_value(csv.keys[i]);
+        }
+        JULE_FREE(csv.keys);
+    }
+    if (csv.lists != NULL) {
+        for (i = 0; i < csv.n_out; i += 1) {
+            jule_free_value(csv.lists[i]);
+        }
+        JULE_FREE(csv.lists);
+    }
+    if (csv.slots != NULL) { JULE_FREE(csv.slots); }
+    if (csv.buff  != NULL) { JULE_FREE(csv.buff);  }
+
+    return status;
+}
+
+/* Evaluates the arguments: a string and an optional options object. */
+static Jule_Status csv_args(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **s, Jule_Value **options) {
+    *options = NULL;
+
+    if (n_values == 2) {
+        return jule_args(interp, tree, "so", n_values, values, s, options);
+    }
+
+    return jule_args(interp, tree, "s", n_values, values, s);
+}
+
+static Jule_Status j_read(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status  status;
+    Jule_Value  *pathv;
+    Jule_Value  *options;
+    const char  *mem;
+    int          size;
+
+    status = csv_args(interp, tree, n_values, values, &pathv, &options);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    if (jule_map_file_into_readonly_memory(jule_string_cstr(pathv), &mem, &size) != JULE_SUCCESS) {
+        *result = jule_nil_value();
+        goto out_free;
+    }
+
+    if (size > 0) {
+        madvise((void*)mem, size, MADV_SEQUENTIAL);
+    }
+
+    status = csv_run(interp, tree, options, mem, size, result);
+
+    if (size > 0) {
+        munmap((void*)mem, size);
+    }
+
+out_free:;
+    jule_free_value(pathv);
+    if (options != NULL) {
+        jule_free_value(options);
+    }
+
+out:;
+    return status;
+}
+
+static Jule_Status j_parse(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status  status;
+    Jule_Value  *s;
+    Jule_Value  *options;
+
+    status = csv_args(interp, tree, n_values, values, &s, &options);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    status = csv_run(interp, tree, options, jule_string_chars(s), jule_string_len(s), result);
+
+    jule_free_value(s);
+    if (options != NULL) {
+        jule_free_value(options);
+    }
+
+out:;
+    return status;
+}
+
+Jule_Value *jule_init_package(Jule_Interp *interp) {
+#define JULE_INSTALL_FN(_name, _fn) jule_install_fn(interp, jule_get_string_id(interp, (_name)), (_fn))
+
+    JULE_INSTALL_FN("csv:read",  j_read);
+    JULE_INSTALL_FN("csv:parse", j_parse);
+
+    return jule_string_value(interp, "csv: Delimited text (CSV/TSV) package.");
+}
@@ -18,7 +18,7 @@ static Jule_Status j_parse_iso(Jule_Interp *interp, Jule_Value *tree, unsigned n
     }
 
     memset(&tm, 0, sizeof(tm));
-    if (strptime(jule_get_string(interp, s->string_id)->chars, "%FT%T%z", &tm) == NULL) {
+    if (strptime(jule_string_cstr(s), "%FT%T%z", &tm) == NULL) {
         *result = jule_nil_value();
         goto out_free;
     }
@@ -2,13 +2,181 @@
 #include <jule.h>
 
 #include <stdio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <limits.h>
+
+/*
+ * Files are plain file descriptors behind "file" handle values, and are
+ * closed by file:close or when the last value referring to them is freed.
+ * file:path gives the path that a file was opened with.
+ *
+ * Lines are read with a Jule_Line_Reader, so they are handed out as views
+ * into large blocks of input rather than copied.
+ *
+ * Output is collected in a per-file buffer and only written when it fills,
+ * on file:flush, when the file is closed, or when the process exits. Every
+ * open file is kept on a list so that the last case can find them.
+ */
+
+#define J_WRITE_SIZE (64 * 1024)
+
+#ifndef IOV_MAX
+#define IOV_MAX (1024)
+#endif
+
+typedef struct J_File {
+    int                 fd;
+    char               *path;
+    Jule_Line_Reader    lines;
+    char               *wbuff;
+    unsigned long long  wlen;
+    unsigned long long  wcap;
+    struct J_File      *prev;
+    struct J_File      *next;
+} J_File;
+
+static J_File *j_open_files;
+static int     j_registered_flush;
+
+/* Writes all of buff to fd and returns the number of bytes written. */
+static unsigned long long j_write_fd(int fd, const char *buff, unsigned long long len) {
+    unsigned long long r;
+    ssize_t            n;
+
+    r = 0;
+    while (r < len) {
+        n = write(fd, buff + r, len - r);
+        if (n < 0) {
+            if (errno == EINTR) { continue; }
+            break;
+        }
+        r += n;
+    }
+
+    return r;
+}
+
+/* Writes all of iov (which it modifies) to fd, adding the number of bytes
+ * written to *r. Returns 0 if a write failed. */
+static int j_writev(int fd, struct iovec *iov, unsigned n_iov, unsigned long long *r) {
+    unsigned first;
+    ssize_t  n;
+
+    first = 0;
+    while (first < n_iov) {
+        n = writev(fd, iov + first, n_iov - first);
+        if (n < 0) {
+            if (errno == EINTR) { continue; }
+            return 0;
+        }
+
+        *r += n;
+
+        /* Skip what was written, then resume within a partial vector. */
+        while (first < n_iov && (size_t)n >= iov[first].iov_len) {
+            n     -= iov[first].iov_len;
+            first += 1;
+        }
+        if (first < n_iov) {
+            iov[first].iov_base  = (char*)iov[first].iov_base + n;
+            iov[first].iov_len  -= n;
+        }
+    }
+
+    return 1;
+}
+
+static void j_flush_buffer(J_File *jf) {
+    if (jf->wlen > 0) {
+        j_write_fd(jf->fd, jf->wbuff, jf->wlen);
+        jf->wlen = 0;
+    }
+}
+
+static void j_flush_all(void) {
+    J_File *jf;
+
+    for (jf = j_open_files; jf != NULL; jf = jf->next) {
+        j_flush_buffer(jf);
+    }
+}
+
+static void j_link(J_File *jf) {
+    jf->prev = NULL;
+    jf->next = j_open_files;
+    if (j_open_files != NULL) {
+        j_open_files->prev = jf;
+    }
+    j_open_files = jf;
+}
+
+static void j_unlink(J_File *jf) {
+    if (jf->prev != NULL) {
+        jf->prev->next = jf->next;
+    } else {
+        j_open_files = jf->next;
+    }
+    if (jf->next != NULL) {
+        jf->next->prev = jf->prev;
+    }
+}
+
+/* Appends to the write buffer, writing it out first if it would overflow.
+ * Writes that would not fit in an empty buffer go straight to the file. */
+static unsigned long long j_buffered_write(J_File *jf, const char *chars, unsigned long long len) {
+    if (jf->wlen + len > jf->wcap) {
+        j_flush_buffer(jf);
+    }
+
+    if (len >= jf->wcap) {
+        return j_write_fd(jf->fd, chars, len);
+    }
 
-static Jule_Status _j_open(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result, const char *mode) {
+    if (jf->wbuff == NULL) {
+        jf->wbuff = JULE_MALLOC(jf->wcap);
+    }
+
+    memcpy(jf->wbuff + jf->wlen, chars, len);
+    jf->wlen += len;
+
+    return len;
+}
+
+static void j_finalize(void *data) {
+    J_File *jf;
+
+    jf = data;
+
+    j_flush_buffer(jf);
+    j_unlink(jf);
+
+    close(jf->fd);
+    JULE_FREE(jf->path);
+    jule_line_reader_free(&jf->lines);
+    if (jf->wbuff != NULL) {
+        JULE_FREE(jf->wbuff);
+    }
+    JULE_FREE(jf);
+}
+
+static const Jule_Handle_Type j_file_type = { "file", j_finalize };
+
+/* The open file behind a handle value, or NULL. */
+static J_File *j_file(Jule_Value *file) {
+    return jule_handle_data(file, &j_file_type);
+}
+
+static Jule_Status _j_open(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result, int flags) {
     Jule_Status        status;
     Jule_Value        *pathv;
-    const Jule_String *path;
-    FILE              *f;
-    Jule_Value        *handle;
+    const char        *path;
+    int                fd;
+    J_File            *jf;
 
     status = jule_args(interp, tree, "s", n_values, values, &pathv);
     if (status != JULE_SUCCESS) {
@@ -16,21 +184,24 @@ static Jule_Status _j_open(Jule_Interp *interp, Jule_Value *tree, unsigned n_val
         goto out;
     }
 
-    path = jule_get_string(interp, pathv->string_id);
+    path = jule_string_cstr(pathv);
 
-    f = fopen(path->chars, mode);
+    fd = open(path, flags, 0666);
 
-    if (f == NULL) {
+    if (fd < 0) {
         *result = jule_nil_value();
         goto out_free;
     }
 
-    handle = jule_number_value(0);
-    handle->_integer = (unsigned long long)(void*)f;
+    jf = JULE_MALLOC(sizeof(*jf));
+    memset(jf, 0, sizeof(*jf));
+    jf->fd   = fd;
+    jf->path = jule_charptr_dup(path);
+    jf->wcap = J_WRITE_SIZE;
+    jule_line_reader_init(&jf->lines, fd);
+    j_link(jf);
 
-    *result = jule_object_value();
-    jule_insert(*result, jule_string_value(interp, "__handle__"), handle);
-    jule_insert(*result, jule_string_value(interp, "path"),       jule_copy_force(pathv));
+    *result = jule_handle_value(&j_file_type, jf);
 
 out_free:;
     jule_free_value(pathv);
@@ -40,148 +211,393 @@ out:;
 }
 
 static Jule_Status j_open_rd(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
-    return _j_open(interp, tree, n_values, values, result, "r");
+    return _j_open(interp, tree, n_values, values, result, O_RDONLY);
 }
 
 static Jule_Status j_open_wr(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
-    return _j_open(interp, tree, n_values, values, result, "w");
+    return _j_open(interp, tree, n_values, values, result, O_WRONLY | O_CREAT | O_TRUNC);
 }
 
 static Jule_Status j_close(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
     Jule_Status  status;
     Jule_Value  *file;
-    Jule_Value  *key;
-    Jule_Value  *handle;
-    FILE        *f;
 
-    status = jule_args(interp, tree, "o", n_values, values, &file);
+    status = jule_args(interp, tree, "h", n_values, values, &file);
     if (status != JULE_SUCCESS) {
         *result = NULL;
         goto out;
     }
 
-    key    = jule_string_value(interp, "__handle__");
-    handle = jule_field(file, key);
-    jule_free_value(key);
-
-    f = handle == NULL ? NULL : (void*)handle->_integer;
+    if (j_file(file) == NULL) {
+        *result = jule_nil_value();
+    } else {
+        *result = jule_number_value(jule_close_handle(file));
+    }
 
     jule_free_value(file);
 
-    if (f == NULL) {
-        *result = jule_nil_value();
+out:;
+    return status;
+}
+
+/* (file:path f) is the path that f was opened with, or nil once it's closed. */
+static Jule_Status j_path(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status  status;
+    Jule_Value  *file;
+    J_File      *jf;
+
+    status = jule_args(interp, tree, "h", n_values, values, &file);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
         goto out;
     }
 
-    fclose(f);
-    *result             = jule_number_value(0);
-    (*result)->_integer = (unsigned long long)(void*)f;
+    jf = j_file(file);
+
+    if (jf == NULL) {
+        *result = jule_nil_value();
+    } else {
+        *result = jule_string_value(interp, jf->path);
+    }
+
+    jule_free_value(file);
 
 out:;
     return status;
 }
 
 static Jule_Status j_read_line(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
-    Jule_Status  status;
-    Jule_Value  *file;
-    Jule_Value  *key;
-    Jule_Value  *handle;
-    FILE        *f;
-    char        *line;
-    size_t       cap;
-    size_t       len;
-
-    status = jule_args(interp, tree, "o", n_values, values, &file);
+    Jule_Status         status;
+    Jule_Value         *file;
+    J_File             *jf;
+    unsigned long long  off;
+    unsigned long long  len;
+
+    status = jule_args(interp, tree, "h", n_values, values, &file);
     if (status != JULE_SUCCESS) {
         *result = NULL;
         goto out;
     }
 
-    key    = jule_string_value(interp, "__handle__");
-    handle = jule_field(file, key);
-    jule_free_value(key);
+    jf = j_file(file);
 
-    f = handle == NULL ? NULL : (void*)handle->_integer;
+    if (jf == NULL || !jule_line_reader_next(&jf->lines, &off, &len)) {
+        *result = jule_nil_value();
+    } else {
+        *result = jule_line_reader_value(interp, &jf->lines, off, len);
+    }
 
     jule_free_value(file);
 
-    if (f == NULL) {
-        *result = jule_nil_value();
+out:;
+    return status;
+}
+
+static Jule_Status j_read_lines(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status         status;
+    Jule_Value         *file;
+    J_File             *jf;
+    unsigned long long  off;
+    unsigned long long  len;
+
+    status = jule_args(interp, tree, "h", n_values, values, &file);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
         goto out;
     }
 
-    line = NULL;
-    cap  = 0;
+    jf = j_file(file);
 
-    if (getline(&line, &cap, f) < 0) {
-        if (line != NULL) {
-            free(line);
-        }
+    if (jf == NULL) {
         *result = jule_nil_value();
+        goto out_free;
+    }
+
+    *result = jule_list_value();
+
+    while (jule_line_reader_next(&jf->lines, &off, &len)) {
+        (*result)->list = jule_push((*result)->list, jule_line_reader_value(interp, &jf->lines, off, len));
+    }
+
+out_free:;
+    jule_free_value(file);
+
+out:;
+    return status;
+}
+
+/* (file:foreach-line line f expr...) works like foreach over the remaining
+ * lines of f, but reads them as it goes instead of building a list. */
+static Jule_Status j_foreach_line(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status         status;
+    Jule_Value         *sym;
+    Jule_Value         *file;
+    J_File             *jf;
+    unsigned long long  off;
+    unsigned long long  len;
+    Jule_Value         *it;
+    Jule_Value         *ev;
+    unsigned            j;
+
+    *result = NULL;
+
+    if (n_values < 3) {
+        status = JULE_ERR_ARITY;
+        jule_make_arity_error(interp, tree, 3, n_values, 1);
         goto out;
     }
 
-    len = strlen(line);
+    sym = values[0];
 
-    if (len > 0 && line[len - 1] == '\n') {
-        line[len - 1] = 0;
+    status = jule_eval(interp, values[1], &file);
+    if (status != JULE_SUCCESS) {
+        goto out;
+    }
+
+    if (file->type != JULE_HANDLE) {
+        status = JULE_ERR_TYPE;
+        jule_make_type_error(interp, values[1], JULE_HANDLE, file->type);
+        jule_free_value(file);
+        goto out;
+    }
+
+    ev = NULL;
+
+    /* The body may close the file, so look it up again every time. */
+    while ((jf = j_file(file)) != NULL && jule_line_reader_next(&jf->lines, &off, &len)) {
+        it = jule_line_reader_value(interp, &jf->lines, off, len);
+
+        JULE_BORROWER(it);
+        status = jule_install_local(interp, sym->symbol_id, it);
+        if (status != JULE_SUCCESS) {
+            jule_make_install_error(interp, sym, status, sym->symbol_id);
+            JULE_UNBORROWER(it);
+            jule_free_value(it);
+            goto out_free;
+        }
+
+        if (ev != NULL) {
+            jule_free_value(ev);
+            ev = NULL;
+        }
+
+        for (j = 2; j < n_values; j += 1) {
+            status = jule_eval(interp, values[j], &ev);
+            if (status != JULE_SUCCESS) {
+                ev = NULL;
+                JULE_UNBORROWER(it);
+                if (jule_lookup_local_only(interp, sym->symbol_id) == it) {
+                    jule_uninstall_local_no_free(interp, sym->symbol_id);
+                }
+                jule_free_value(it);
+                goto out_free;
+            }
+
+            if (j < n_values - 1) {
+                jule_free_value(ev);
+                ev = NULL;
+            }
+        }
+
+        if (ev == it) {
+            ev = jule_copy_force(it);
+        }
+
+        JULE_UNBORROWER(it);
+        if (jule_lookup_local_only(interp, sym->symbol_id) == it) {
+            status = jule_uninstall_local_no_free(interp, sym->symbol_id);
+            if (status != JULE_SUCCESS) {
+                jule_make_install_error(interp, sym, status, sym->symbol_id);
+                jule_free_value(it);
+                goto out_free;
+            }
+        }
+        jule_free_value(it);
     }
 
-    *result = jule_string_value(interp, line);
+    *result = ev != NULL ? ev : jule_nil_value();
+    jule_free_value(file);
+    goto out;
 
-    free(line);
+out_free:;
+    if (ev != NULL) {
+        jule_free_value(ev);
+    }
+    jule_free_value(file);
 
 out:;
     return status;
 }
 
-static Jule_Status j_read_lines(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+/*
+ * file:read-all and file:map return strings that are views straight into a
+ * read-only mapping of the file, which is unmapped once the last string
+ * referring to it is freed. file:map maps only a window of the file, so a
+ * file larger than memory (or address space) can be walked a window at a time.
+ */
+
+/* Maps len bytes of fd starting at off (page aligned) and returns a view of
+ * the bytes from skip onward. The mapping is followed by at least one zero
+ * byte so that a view that reaches the end of the file is already terminated. */
+static Jule_Value *j_map_value(Jule_Interp *interp, int fd, off_t off, unsigned long long len, unsigned long long skip) {
+    char       *map;
+    Jule_Value *value;
+
+    (void)interp;
+
+    /* Reserve one extra byte of anonymous (zeroed) memory and put the file over the rest. */
+    map = mmap(NULL, len + 1, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (map == MAP_FAILED) { return NULL; }
+
+    if (mmap(map, len, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, off) == MAP_FAILED) {
+        munmap(map, len + 1);
+        return NULL;
+    }
+
+    madvise(map, len, MADV_SEQUENTIAL);
+
+    value = _jule_value();
+
+    value->type = JULE_STRING;
+
+    if (len - skip <= JULE_SSTRING_MAX) {
+        jule_set_inline_string(value, map + skip, len - skip);
+        munmap(map, len + 1);
+    } else {
+        jule_set_heap_string(value, jule_string_view(jule_heap_string_mapped(map, len + 1), skip, len - skip));
+        /* The view holds the only reference we need. */
+        jule_string_release(value->string->parent);
+    }
+
+    return value;
+}
+
+/* Reads what's left of a pipe or other unmappable file into the heap. */
+static Jule_Value *j_read_fd(Jule_Interp *interp, int fd) {
+    char               *buff;
+    unsigned long long  len;
+    unsigned long long  cap;
+    ssize_t             n;
+
+    cap  = JULE_LINE_READ_SIZE;
+    len  = 0;
+    buff = JULE_MALLOC(cap + 1);
+
+    for (;;) {
+        if (len == cap) {
+            cap  <<= 1;
+            buff   = JULE_REALLOC(buff, cap + 1);
+        }
+
+        n = read(fd, buff + len, cap - len);
+        if (n < 0 && errno == EINTR) { continue; }
+        if (n <= 0)                  { break;    }
+
+        len += n;
+    }
+
+    buff[len] = 0;
+
+    return jule_string_value_consume(interp, buff, len);
+}
+
+static Jule_Status j_read_all(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
     Jule_Status  status;
-    Jule_Value  *file;
-    Jule_Value  *key;
-    Jule_Value  *handle;
-    FILE        *f;
-    char        *line;
-    size_t       cap;
-    size_t       len;
-
-    status = jule_args(interp, tree, "o", n_values, values, &file);
+    Jule_Value  *pathv;
+    int          fd;
+    struct stat  fs;
+
+    status = jule_args(interp, tree, "s", n_values, values, &pathv);
     if (status != JULE_SUCCESS) {
         *result = NULL;
         goto out;
     }
 
-    key    = jule_string_value(interp, "__handle__");
-    handle = jule_field(file, key);
-    jule_free_value(key);
+    fd = open(jule_string_cstr(pathv), O_RDONLY);
 
-    f = handle == NULL ? NULL : (void*)handle->_integer;
+    if (fd < 0 || fstat(fd, &fs) != 0 || S_ISDIR(fs.st_mode)) {
+        *result = jule_nil_value();
+        goto out_close;
+    }
 
-    jule_free_value(file);
+    if (!S_ISREG(fs.st_mode)) {
+        *result = j_read_fd(interp, fd);
+    } else if (fs.st_size == 0) {
+        *result = jule_string_value_n(interp, "", 0);
+    } else {
+        *result = j_map_value(interp, fd, 0, fs.st_size, 0);
+        if (*result == NULL) {
+            *result = j_read_fd(interp, fd);
+        }
+    }
 
-    if (f == NULL) {
-        *result = jule_nil_value();
+out_close:;
+    if (fd >= 0) {
+        close(fd);
+    }
+    jule_free_value(pathv);
+
+out:;
+    return status;
+}
+
+/* (file:map path offset length) returns bytes [offset, offset + length) of
+ * the file. A negative length (or one running past the end) means up to the
+ * end of the file. Returns nil if the file can't be mapped. */
+static Jule_Status j_map(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status         status;
+    Jule_Value         *pathv;
+    Jule_Value         *offv;
+    Jule_Value         *lenv;
+    int                 fd;
+    struct stat         fs;
+    unsigned long long  off;
+    unsigned long long  len;
+    unsigned long long  skip;
+
+    status = jule_args(interp, tree, "snn", n_values, values, &pathv, &offv, &lenv);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
         goto out;
     }
 
-    *result = jule_list_value();
+    fd = open(jule_string_cstr(pathv), O_RDONLY);
 
-    line = NULL;
-    cap  = 0;
-    while (getline(&line, &cap, f) > 0) {
-        len = strlen(line);
+    if (fd < 0 || fstat(fd, &fs) != 0 || !S_ISREG(fs.st_mode)) {
+        *result = jule_nil_value();
+        goto out_close;
+    }
 
-        if (len > 0 && line[len - 1] == '\n') {
-            line[len - 1] = 0;
-        }
+    off = offv->number <= 0 ? 0 : (unsigned long long)offv->number;
+    if (off > (unsigned long long)fs.st_size) {
+        off = fs.st_size;
+    }
+
+    len = (unsigned long long)fs.st_size - off;
+    if (lenv->number >= 0 && lenv->number < len) {
+        len = (unsigned long long)lenv->number;
+    }
 
-        (*result)->list = jule_push((*result)->list, jule_string_value(interp, line));
+    if (len == 0) {
+        *result = jule_string_value_n(interp, "", 0);
+        goto out_close;
     }
 
-    if (line != NULL) {
-        free(line);
+    skip = off % sysconf(_SC_PAGESIZE);
+
+    *result = j_map_value(interp, fd, off - skip, skip + len, skip);
+    if (*result == NULL) {
+        *result = jule_nil_value();
     }
 
+out_close:;
+    if (fd >= 0) {
+        close(fd);
+    }
+    jule_free_value(pathv);
+    jule_free_value(offv);
+    jule_free_value(lenv);
+
 out:;
     return status;
 }
@@ -190,38 +606,185 @@ static Jule_Status j_write(Jule_Interp *interp, Jule_Value *tree, unsigned n_val
     Jule_Status        status;
     Jule_Value        *file;
     Jule_Value        *string;
-    Jule_Value        *key;
-    Jule_Value        *handle;
-    const Jule_String *s;
-    FILE              *f;
-    size_t             r;
+    J_File            *jf;
+    const char        *chars;
+    unsigned long long len;
 
-    status = jule_args(interp, tree, "os", n_values, values, &file, &string);
+    status = jule_args(interp, tree, "h*", n_values, values, &file, &string);
     if (status != JULE_SUCCESS) {
         *result = NULL;
         goto out;
     }
 
-    key    = jule_string_value(interp, "__handle__");
-    handle = jule_field(file, key);
-    s      = jule_get_string(interp, string->string_id);
-    jule_free_value(key);
+    if (string->type != JULE_STRING && string->type != JULE_BUILDER) {
+        status = JULE_ERR_TYPE;
+        jule_make_type_error(interp, values[1], JULE_STRING, string->type);
+        *result = NULL;
+        goto out_free;
+    }
+
+    jf = j_file(file);
+
+    if (jf == NULL) {
+        *result = jule_nil_value();
+        goto out_free;
+    }
+
+    if (string->type == JULE_BUILDER) {
+        chars = string->builder->chars;
+        len   = string->builder->len;
+    } else {
+        chars = jule_string_chars(string);
+        len   = jule_string_len(string);
+    }
+
+    *result = jule_number_value(j_buffered_write(jf, chars, len));
+
+out_free:;
+    jule_free_value(file);
     jule_free_value(string);
 
-    f = handle == NULL ? NULL : (void*)handle->_integer;
+out:;
+    return status;
+}
+
+static Jule_Status j_flush(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status  status;
+    Jule_Value  *file;
+    J_File      *jf;
+
+    status = jule_args(interp, tree, "h", n_values, values, &file);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    jf = j_file(file);
+
+    if (jf == NULL) {
+        *result = jule_nil_value();
+    } else {
+        *result = jule_number_value(jf->wlen);
+        j_flush_buffer(jf);
+    }
 
     jule_free_value(file);
 
-    if (f == NULL) {
+out:;
+    return status;
+}
+
+/* (file:set-buffer f size) flushes f and gives it a write buffer of size
+ * bytes. A size of 0 makes every file:write go straight to the file. */
+static Jule_Status j_set_buffer(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status  status;
+    Jule_Value  *file;
+    Jule_Value  *size;
+    J_File      *jf;
+
+    status = jule_args(interp, tree, "hn", n_values, values, &file, &size);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    jf = j_file(file);
+
+    if (jf == NULL) {
         *result = jule_nil_value();
+        goto out_free;
+    }
+
+    j_flush_buffer(jf);
+
+    if (jf->wbuff != NULL) {
+        JULE_FREE(jf->wbuff);
+        jf->wbuff = NULL;
+    }
+
+    jf->wcap = size->number > 0 ? (unsigned long long)size->number : 0;
+
+    *result = jule_number_value(jf->wcap);
+
+out_free:;
+    jule_free_value(file);
+    jule_free_value(size);
+
+out:;
+    return status;
+}
+
+/* (file:write-all f list) writes each string or builder in list with as
+ * few writev() calls as possible, after flushing anything buffered. */
+static Jule_Status j_write_all(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status         status;
+    Jule_Value         *file;
+    Jule_Value         *list;
+    J_File             *jf;
+    Jule_Value         *it;
+    struct iovec        iov[IOV_MAX];
+    unsigned            n_iov;
+    int                 ok;
+    unsigned long long  r;
+
+    status = jule_args(interp, tree, "hl", n_values, values, &file, &list);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
         goto out;
     }
 
-    r = fwrite(s->chars, 1, s->len, f);
-    fflush(f);
+    FOR_EACH(list->list, it) {
+        if (it->type != JULE_STRING && it->type != JULE_BUILDER) {
+            status = JULE_ERR_TYPE;
+            jule_make_type_error(interp, values[1], JULE_STRING, it->type);
+            *result = NULL;
+            goto out_free;
+        }
+    }
+
+    jf = j_file(file);
+
+    if (jf == NULL) {
+        *result = jule_nil_value();
+        goto out_free;
+    }
+
+    j_flush_buffer(jf);
+
+    r     = 0;
+    n_iov = 0;
+
+    FOR_EACH(list->list, it) {
+        if (it->type == JULE_BUILDER) {
+            iov[n_iov].iov_base = it->builder->chars;
+            iov[n_iov].iov_len  = it->builder->len;
+        } else {
+            iov[n_iov].iov_base = (void*)jule_string_chars(it);
+            iov[n_iov].iov_len  = jule_string_len(it);
+        }
+
+        if (iov[n_iov].iov_len == 0) { continue; }
+
+        n_iov += 1;
+
+        if (n_iov < IOV_MAX) { continue; }
+
+        ok    = j_writev(jf->fd, iov, n_iov, &r);
+        n_iov = 0;
+
+        if (!ok) { break; }
+    }
+
+    if (n_iov > 0) {
+        j_writev(jf->fd, iov, n_iov, &r);
+    }
 
     *result = jule_number_value(r);
 
+out_free:;
+    jule_free_value(file);
+    jule_free_value(list);
+
 out:;
     return status;
 }
@@ -229,13 +792,25 @@ out:;
 Jule_Value *jule_init_package(Jule_Interp *interp) {
 #define JULE_INSTALL_FN(_name, _fn) jule_install_fn(interp, jule_get_string_id(interp, (_name)), (_fn))
 
-    JULE_INSTALL_FN("file:open",       j_open_rd);
-    JULE_INSTALL_FN("file:open-rd",    j_open_rd);
-    JULE_INSTALL_FN("file:open-wr",    j_open_wr);
-    JULE_INSTALL_FN("file:close",      j_close);
-    JULE_INSTALL_FN("file:read-line",  j_read_line);
-    JULE_INSTALL_FN("file:read-lines", j_read_lines);
-    JULE_INSTALL_FN("file:write",      j_write);
+    JULE_INSTALL_FN("file:open",         j_open_rd);
+    JULE_INSTALL_FN("file:open-rd",      j_open_rd);
+    JULE_INSTALL_FN("file:open-wr",      j_open_wr);
+    JULE_INSTALL_FN("file:close",        j_close);
+    JULE_INSTALL_FN("file:path",         j_path);
+    JULE_INSTALL_FN("file:read-line",    j_read_line);
+    JULE_INSTALL_FN("file:read-lines",   j_read_lines);
+    JULE_INSTALL_FN("file:foreach-line", j_foreach_line);
+    JULE_INSTALL_FN("file:read-all",     j_read_all);
+    JULE_INSTALL_FN("file:map",          j_map);
+    JULE_INSTALL_FN("file:write",        j_write);
+    JULE_INSTALL_FN("file:write-all",    j_write_all);
+    JULE_INSTALL_FN("file:flush",        j_flush);
+    JULE_INSTALL_FN("file:set-buffer",   j_set_buffer);
+
+    if (!j_registered_flush) {
+        atexit(j_flush_all);
+        j_registered_flush = 1;
+    }
 
     return jule_string_value(interp, "file: File IO package.");
 }
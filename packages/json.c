@@ -0,0 +1,976 @@
+#define JULE_IMPL
+#include <jule.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/mman.h>
+
+/*
+ * JSON documents map onto values as you'd expect: objects, lists, numbers
+ * and strings become the same, true and false become 1 and 0, and null
+ * becomes nil. Serializing goes the other way, with nil written as null.
+ *
+ * A malformed document parses as nil. The -lines functions expect one
+ * document per line, and a malformed line becomes a nil element.
+ *
+ * json:parse and json:read take an optional options object:
+ *
+ *     "views"  number  Return string fields without escapes as views into
+ *                      the document instead of copies. Default 0. Views keep
+ *                      the whole document alive, so this pays off when the
+ *                      strings are large or few of them are kept.
+ *
+ * Whitespace and the insides of strings are skipped a vector at a time; the
+ * rest of the structure is walked by a small recursive descent parser.
+ */
+
+#define JSON_MAX_DEPTH (1024)
+
+typedef struct {
+    Jule_Interp        *interp;
+    Jule_Value         *src;
+    const char         *start;
+    const char         *p;
+    const char         *end;
+    int                 views;
+    int                 depth;
+    Jule_Status         status;
+    char               *buff;
+    unsigned long long  buff_cap;
+} Json_Parser;
+
+/* Stops at anything other than ' ', '\t', '\n' and '\r'. */
+static inline const char *json_skip_ws(const char *p, const char *end) {
+#ifdef JULE_VEC_BYTES
+    Jule_Vec v;
+    unsigned mask;
+
+    while (end - p >= JULE_VEC_BYTES) {
+        v    = JULE_VEC_LOAD(p);
+        mask = ~JULE_VEC_MASK(JULE_VEC_OR(JULE_VEC_OR(JULE_VEC_EQ(v, JULE_VEC_SET1(' ')),
+                                                      JULE_VEC_EQ(v, JULE_VEC_SET1('\t'))),
+                                          JULE_VEC_OR(JULE_VEC_EQ(v, JULE_VEC_SET1('\n')),
+                                                      JULE_VEC_EQ(v, JULE_VEC_SET1('\r'))))) & JULE_VEC_ALL;
+        if (mask) { return p + __builtin_ctz(mask); }
+        p += JULE_VEC_BYTES;
+    }
+#endif
+
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) { p += 1; }
+
+    return p;
+}
+
+/* Stops at '"' and '\\'. */
+static inline const char *json_scan_string(const char *p, const char *end) {
+#ifdef JULE_VEC_BYTES
+    Jule_Vec v;
+    unsigned mask;
+
+    while (end - p >= JULE_VEC_BYTES) {
+        v    = JULE_VEC_LOAD(p);
+        mask = JULE_VEC_MASK(JULE_VEC_OR(JULE_VEC_EQ(v, JULE_VEC_SET1('"')),
+                                         JULE_VEC_EQ(v, JULE_VEC_SET1('\\'))));
+        if (mask) { return p + __builtin_ctz(mask); }
+        p += JULE_VEC_BYTES;
+    }
+#endif
+
+    while (p < end && *p != '"' && *p != '\\') { p += 1; }
+
+    return p;
+}
+
+static void json_buff_append(Json_Parser *j, unsigned long long *len, const char *s, unsigned long long n) {
+    if (n == 0) { return; }
+
+    if (*len + n > j->buff_cap) {
+        j->buff_cap = 2 * (*len + n);
+        j->buff     = JULE_REALLOC(j->buff, j->buff_cap);
+    }
+    memcpy(j->buff + *len, s, n);
+    *len += n;
+}
+
+static int json_hex4(const char *p, const char *end, unsigned *out) {
+    int i;
+    int c;
+
+    if (end - p < 4) { return 0; }
+
+    *out = 0;
+    for (i = 0; i < 4; i += 1) {
+        c = p[i];
+        if      (c >= '0' && c <= '9') { c -= '0';      }
+        else if (c >= 'a' && c <= 'f') { c -= 'a' - 10; }
+        else if (c >= 'A' && c <= 'F') { c -= 'A' - 10; }
+        else                           { return 0;      }
+        *out = (*out << 4) | c;
+    }
+
+    return 1;
+}
+
+static void json_utf8(Json_Parser *j, unsigned long long *len, unsigned cp) {
+    char     b[4];
+    unsigned n;
+
+    if (cp < 0x80) {
+        b[0] = cp;
+        n    = 1;
+    } else if (cp < 0x800) {
+        b[0] = 0xc0 | (cp >> 6);
+        b[1] = 0x80 | (cp & 0x3f);
+        n    = 2;
+    } else if (cp < 0x10000) {
+        b[0] = 0xe0 | (cp >> 12);
+        b[1] = 0x80 | ((cp >> 6) & 0x3f);
+        b[2] = 0x80 | (cp & 0x3f);
+        n    = 3;
+    } else {
+        b[0] = 0xf0 | (cp >> 18);
+        b[1] = 0x80 | ((cp >> 12) & 0x3f);
+        b[2] = 0x80 | ((cp >> 6) & 0x3f);
+        b[3] = 0x80 | (cp & 0x3f);
+        n    = 4;
+    }
+
+    json_buff_append(j, len, b, n);
+}
+
+/* Parses the string starting after the opening quote at j->p. */
+static Jule_Value *json_string(Json_Parser *j) {
+    const char         *start;
+    const char         *q;
+    unsigned long long  len;
+    unsigned            cp;
+    unsigned            lo;
+    char                c;
+
+    start = j->p;
+    q     = json_scan_string(start, j->end);
+
+    if (q < j->end && *q == '"') {
+        j->p = q + 1;
+        if (j->views) {
+            return jule_substring_value(j->interp, j->src, start - j->start, q - start);
+        }
+        return jule_string_value_n(j->interp, start, q - start);
+    }
+
+    /* Escapes: build the string in the scratch buffer. */
+    len = 0;
+    for (;;) {
+        json_buff_append(j, &len, start, q - start);
+
+        if (q == j->end) { goto eos; }
+
+        if (*q == '"') {
+            j->p = q + 1;
+            return jule_string_value_n(j->interp, j->buff, len);
+        }
+
+        /* *q == '\\' */
+        if (q + 1 == j->end) { goto eos; }
+
+        c  = q[1];
+        q += 2;
+
+        switch (c) {
+            case '"':  json_buff_append(j, &len, "\"", 1); break;
+            case '\\': json_buff_append(j, &len, "\\", 1); break;
+            case '/':  json_buff_append(j, &len, "/",  1); break;
+            case 'b':  json_buff_append(j, &len, "\b", 1); break;
+            case 'f':  json_buff_append(j, &len, "\f", 1); break;
+            case 'n':  json_buff_append(j, &len, "\n", 1); break;
+            case 'r':  json_buff_append(j, &len, "\r", 1); break;
+            case 't':  json_buff_append(j, &len, "\t", 1); break;
+            case 'u':
+                if (!json_hex4(q, j->end, &cp)) { goto bad; }
+                q += 4;
+                /* Surrogate pair. */
+                if (cp >= 0xd800 && cp < 0xdc00
+                &&  j->end - q >= 6 && q[0] == '\\' && q[1] == 'u'
+                &&  json_hex4(q + 2, j->end, &lo) && lo >= 0xdc00 && lo < 0xe000) {
+                    cp  = 0x10000 + ((cp - 0xd800) << 10) + (lo - 0xdc00);
+                    q  += 6;
+                }
+                json_utf8(j, &len, cp);
+                break;
+            default:
+                goto bad;
+        }
+
+        start = q;
+        q     = json_scan_string(start, j->end);
+    }
+
+eos:;
+    j->status = JULE_ERR_UNEXPECTED_EOS;
+    return NULL;
+
+bad:;
+    j->status = JULE_ERR_UNEXPECTED_TOK;
+    return NULL;
+}
+
+static int json_literal(Json_Parser *j, const char *lit, unsigned n) {
+    if ((unsigned long long)(j->end - j->p) >= n && memcmp(j->p, lit, n) == 0) {
+        j->p += n;
+        return 1;
+    }
+    return 0;
+}
+
+/* Length of the JSON number at p: -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][-+]?[0-9]+)?
+ * Returns 0 if there isn't one. */
+static unsigned long long json_number_len(const char *p, const char *end) {
+    const char *s;
+    const char *d;
+
+    s = p;
+
+    if (s < end && *s == '-') { s += 1; }
+
+    if (s < end && *s == '0') {
+        s += 1;
+    } else if (s < end && *s >= '1' && *s <= '9') {
+        while (s < end && *s >= '0' && *s <= '9') { s += 1; }
+    } else {
+        return 0;
+    }
+
+    if (s < end && *s == '.') {
+        s += 1;
+        d  = s;
+        while (s < end && *s >= '0' && *s <= '9') { s += 1; }
+        if (s == d) { return 0; }
+    }
+
+    if (s < end && (*s == 'e' || *s == 'E')) {
+        s += 1;
+        if (s < end && (*s == '-' || *s == '+')) { s += 1; }
+        d = s;
+        while (s < end && *s >= '0' && *s <= '9') { s += 1; }
+        if (s == d) { return 0; }
+    }
+
+    /* "01" is a leading zero, not two values. */
+    if (s < end && *s >= '0' && *s <= '9') { return 0; }
+
+    return s - p;
+}
+
+static Jule_Value *json_value(Json_Parser *j) {
+    Jule_Value         *value;
+    Jule_Value         *key;
+    Jule_Value         *elem;
+    double              d;
+    unsigned long long  n;
+
+    j->p = json_skip_ws(j->p, j->end);
+
+    if (j->p == j->end) {
+        j->status = JULE_ERR_UNEXPECTED_EOS;
+        return NULL;
+    }
+
+    switch (*j->p) {
+        case '{':
+            if (++j->depth > JSON_MAX_DEPTH) { goto bad; }
+
+            value  = jule_object_value();
+            j->p  += 1;
+            j->p   = json_skip_ws(j->p, j->end);
+
+            if (j->p < j->end && *j->p == '}') {
+                j->p += 1;
+                break;
+            }
+
+            for (;;) {
+                j->p = json_skip_ws(j->p, j->end);
+                if (j->p == j->end || *j->p != '"') { goto bad_free; }
+                j->p += 1;
+
+                if ((key = json_string(j)) == NULL) { goto free; }
+
+                j->p = json_skip_ws(j->p, j->end);
+                if (j->p == j->end || *j->p != ':') {
+                    jule_free_value(key);
+                    goto bad_free;
+                }
+                j->p += 1;
+
+                if ((elem = json_value(j)) == NULL) {
+                    jule_free_value(key);
+                    goto free;
+                }
+
+                jule_insert(value, key, elem);
+
+                j->p = json_skip_ws(j->p, j->end);
+                if (j->p < j->end && *j->p == ',') { j->p += 1; continue; }
+                if (j->p < j->end && *j->p == '}') { j->p += 1; break;    }
+                goto bad_free;
+            }
+            break;
+
+        case '[':
+            if (++j->depth > JSON_MAX_DEPTH) { goto bad; }
+
+            value  = jule_list_value();
+            j->p  += 1;
+            j->p   = json_skip_ws(j->p, j->end);
+
+            if (j->p < j->end && *j->p == ']') {
+                j->p += 1;
+                break;
+            }
+
+            for (;;) {
+                if ((elem = json_value(j)) == NULL) { goto free; }
+
+                value->list = jule_push(value->list, elem);
+
+                j->p = json_skip_ws(j->p, j->end);
+                if (j->p < j->end && *j->p == ',') { j->p += 1; continue; }
+                if (j->p < j->end && *j->p == ']') { j->p += 1; break;    }
+                goto bad_free;
+            }
+            break;
+
+        case '"':
+            j->p += 1;
+            return json_string(j);
+
+        case 't':
+            if (!json_literal(j, "true", 4))  { goto bad; }
+            return jule_number_value(1);
+        case 'f':
+            if (!json_literal(j, "false", 5)) { goto bad; }
+            return jule_number_value(0);
+        case 'n':
+            if (!json_literal(j, "null", 4))  { goto bad; }
+            return jule_nil_value();
+
+        default:
+            n = json_number_len(j->p, j->end);
+            if (n == 0 || jule_parse_number(j->p, n, &d) != n) { goto bad; }
+            j->p += n;
+            return jule_number_value(d);
+    }
+
+    j->depth -= 1;
+
+    return value;
+
+bad_free:;
+    j->status = j->p == j->end ? JULE_ERR_UNEXPECTED_EOS : JULE_ERR_UNEXPECTED_TOK;
+free:;
+    jule_free_value(value);
+    return NULL;
+
+bad:;
+    j->status = JULE_ERR_UNEXPECTED_TOK;
+    return NULL;
+}
+
+/* Parses src as one document, or (with lines set) as one document per line. */
+static Jule_Status json_parse(Jule_Interp *interp, Jule_Value *tree, Jule_Value *src, Jule_Value *options, int lines, Jule_Value **result) {
+    Json_Parser  j;
+    Jule_Value   key;
+    Jule_Value  *opt;
+    Jule_Value  *value;
+    const char  *doc;
+    const char  *nl;
+
+    memset(&j, 0, sizeof(j));
+
+    j.interp = interp;
+    j.src    = src;
+    j.start  = jule_string_chars(src);
+    j.p      = j.start;
+    j.end    = j.start + jule_string_len(src);
+    j.status = JULE_SUCCESS;
+
+    if (options != NULL) {
+        memset(&key, 0, sizeof(key));
+        key.type = JULE_STRING;
+        jule_set_inline_string(&key, "views", 5);
+
+        if ((opt = jule_field(options, &key)) != NULL) {
+            if (opt->type != JULE_NUMBER) {
+                jule_make_type_error(interp, tree, JULE_NUMBER, opt->type);
+                *result = NULL;
+                return JULE_ERR_TYPE;
+            }
+            j.views = opt->number != 0;
+        }
+    }
+
+    if (lines) {
+        *result = jule_list_value();
+        for (;;) {
+            j.p = json_skip_ws(j.p, j.end);
+            if (j.p == j.end) { break; }
+
+            doc     = j.p;
+            j.depth = 0;
+            value   = json_value(&j);
+
+            /* Anything but whitespace after a document on its line is junk. */
+            if (value != NULL) {
+                while (j.p < j.end && (*j.p == ' ' || *j.p == '\t' || *j.p == '\r')) { j.p += 1; }
+                if (j.p < j.end && *j.p != '\n') {
+                    jule_free_value(value);
+                    value = NULL;
+                }
+            }
+
+            /* A malformed document becomes nil, and parsing picks up again on
+             * the line after the one that it started on. */
+            if (value == NULL) {
+                value = jule_nil_value();
+                nl    = memchr(doc, '\n', j.end - doc);
+                j.p   = nl == NULL ? j.end : nl + 1;
+            }
+
+            (*result)->list = jule_push((*result)->list, value);
+        }
+    } else {
+        *result = json_value(&j);
+        if (*result != NULL && json_skip_ws(j.p, j.end) != j.end) {
+            jule_free_value(*result);
+            *result = NULL;
+        }
+        if (*result == NULL) {
+            *result = jule_nil_value();
+        }
+    }
+
+    if (j.buff != NULL) {
+        JULE_FREE(j.buff);
+    }
+
+    return JULE_SUCCESS;
+}
+
+/* Evaluates the arguments: a string and an optional options object. */
+static Jule_Status json_args(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **s, Jule_Value **options) {
+    *options = NULL;
+
+    if (n_values == 2) {
+        return jule_args(interp, tree, "so", n_values, values, s, options);
+    }
+
+    return jule_args(interp, tree, "s", n_values, values, s);
+}
+
+static Jule_Status _j_parse(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result, int lines) {
+    Jule_Status  status;
+    Jule_Value  *s;
+    Jule_Value  *options;
+
+    status = json_args(interp, tree, n_values, values, &s, &options);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    status = json_parse(interp, tree, s, options, lines, result);
+
+    jule_free_value(s);
+    if (options != NULL) {
+        jule_free_value(options);
+    }
+
+out:;
+    return status;
+}
+
+static Jule_Status _j_read(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result, int lines) {
+    Jule_Status  status;
+    Jule_Value  *pathv;
+    Jule_Value  *options;
+    const char  *mem;
+    int          size;
+    Jule_Value  *src;
+
+    status = json_args(interp, tree, n_values, values, &pathv, &options);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    if (jule_map_file_into_readonly_memory(jule_string_cstr(pathv), &mem, &size) != JULE_SUCCESS) {
+        *result = jule_nil_value();
+        goto out_free;
+    }
+
+    /* The mapping becomes a string that views can share. It's never used as a
+     * whole, and views of JSON strings never run to the end of the file (there
+     * is always a closing quote), so it doesn't matter that it isn't terminated. */
+    src       = _jule_value();
+    src->type = JULE_STRING;
+
+    if (size == 0) {
+        jule_set_inline_string(src, "", 0);
+    } else {
+        madvise((void*)mem, size, MADV_SEQUENTIAL);
+        jule_set_heap_string(src, jule_heap_string_mapped((char*)mem, size));
+    }
+
+    status = json_parse(interp, tree, src, options, lines, result);
+
+    jule_free_value(src);
+
+out_free:;
+    jule_free_value(pathv);
+    if (options != NULL) {
+        jule_free_value(options);
+    }
+
+out:;
+    return status;
+}
+
+static Jule_Status j_parse(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    return _j_parse(interp, tree, n_values, values, result, 0);
+}
+
+static Jule_Status j_parse_lines(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    return _j_parse(interp, tree, n_values, values, result, 1);
+}
+
+static Jule_Status j_read(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    return _j_read(interp, tree, n_values, values, result, 0);
+}
+
+static Jule_Status j_read_lines(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    return _j_read(interp, tree, n_values, values, result, 1);
+}
+
+/*
+ * Serializing
+ *
+ * Output is appended with memcpy() into a buffer that either grows (for
+ * json:stringify) or is written out whenever it fills up (for json:write).
+ */
+
+#define JSON_WRITE_SIZE (64 * 1024)
+
+typedef struct {
+    char               *buff;
+    unsigned long long  len;
+    unsigned long long  cap;
+    int                 fd;
+    unsigned long long  written;
+} Json_Writer;
+
+static void json_flush(Json_Writer *w) {
+    unsigned long long off;
+    ssize_t            n;
+
+    off = 0;
+    while (off < w->len) {
+        n = write(w->fd, w->buff + off, w->len - off);
+        if (n < 0) {
+            if (errno == EINTR) { continue; }
+            break;
+        }
+        off += n;
+    }
+
+    w->written += off;
+    w->len      = 0;
+}
+
+static void json_put(Json_Writer *w, const char *s, unsigned long long n) {
+    if (w->len + n > w->cap) {
+        if (w->fd >= 0) {
+            json_flush(w);
+        }
+        while (w->len + n > w->cap) {
+            w->cap  <<= 1;
+            w->buff   = JULE_REALLOC(w->buff, w->cap);
+        }
+    }
+
+    memcpy(w->buff + w->len, s, n);
+    w->len += n;
+}
+
+/* Returns 1 if man * 10^exp10 reads back as exactly d. */
+static int json_decimal_is(unsigned long long man, int exp10, double d) {
+    double back;
+
+    if (man < (1ull << 53) && exp10 >= -22 && exp10 <= 22) {
+        back = exp10 < 0
+                ? (double)man / jule_exact_pow10[-exp10]
+                : (double)man * jule_exact_pow10[exp10];
+        return back == d;
+    }
+
+    return jule_eisel_lemire(man, exp10, 0, &back) && back == d;
+}
+
+/* Writes the shortest decimal that reads back as d, which must be finite,
+ * positive and not an integer that fits in 53 bits. */
+static int json_shortest(double d, char *buff) {
+    unsigned long long man;
+    int                exp10;
+    char               digits[24];
+    int                n;
+    int                x;
+    int                len;
+    int                i;
+
+    /* Short forms are searched for with exact checks; jule_round_decimal()
+     * can't be trusted much past 13 digits, so longer ones come from libc. */
+    for (n = 1; n <= 13; n += 1) {
+        if (jule_round_decimal(d, n, &man, &exp10) && json_decimal_is(man, exp10, d)) {
+            goto found;
+        }
+    }
+
+    /* Subnormals throw off jule_round_decimal()'s exponent guess. The libc
+     * digits are read back into man and exp10 so that the notation is
+     * chosen below either way. */
+    for (n = d < 2.2250738585072014e-308 ? 1 : 14; n <= 17; n += 1) {
+        snprintf(buff, 32, "%.*e", n - 1, d);
+        if (n == 17 || strtod(buff, NULL) == d) { break; }
+    }
+
+    man = buff[0] - '0';
+    for (i = 2; i <= n; i += 1) {
+        man = man * 10 + (buff[i] - '0');
+    }
+    exp10 = atoi(buff + (n > 1 ? n + 2 : 2)) - (n - 1);
+
+found:;
+    for (i = n - 1; i >= 0; i -= 1) {
+        digits[i]  = '0' + (man % 10);
+        man       /= 10;
+    }
+    while (n > 1 && digits[n - 1] == '0') {
+        n     -= 1;
+        exp10 += 1;
+    }
+
+    x   = exp10 + n - 1;
+    len = 0;
+
+    /* Same choice of notation as JavaScript. */
+    if (x >= -6 && x < 21) {
+        if (x < 0) {
+            buff[len++] = '0';
+            buff[len++] = '.';
+            for (i = 0; i < -x - 1; i += 1) { buff[len++] = '0'; }
+            memcpy(buff + len, digits, n);
+            len += n;
+        } else {
+            for (i = 0; i <= x; i += 1) { buff[len++] = i < n ? digits[i] : '0'; }
+            if (n > x + 1) {
+                buff[len++] = '.';
+                memcpy(buff + len, digits + x + 1, n - (x + 1));
+                len += n - (x + 1);
+            }
+        }
+        buff[len] = 0;
+    } else {
+        buff[len++] = digits[0];
+        if (n > 1) {
+            buff[len++] = '.';
+            memcpy(buff + len, digits + 1, n - 1);
+            len += n - 1;
+        }
+        len += snprintf(buff + len, 32 - len, "e%+d", x);
+    }
+
+    return len;
+}
+
+static void json_number(Json_Writer *w, double d) {
+    char      buff[40];
+    char      digits[24];
+    int       len;
+    int       n;
+    long long i;
+
+    if (!isfinite(d)) {
+        json_put(w, "null", 4);
+        return;
+    }
+
+    if (d > -9007199254740992.0 && d < 9007199254740992.0 && d == (double)(i = (long long)d)) {
+        len = 0;
+        if (i < 0) {
+            buff[len++] = '-';
+            i           = -i;
+        }
+        n = 0;
+        do {
+            digits[n++]  = '0' + (i % 10);
+            i           /= 10;
+        } while (i > 0);
+        while (n > 0) { buff[len++] = digits[--n]; }
+        json_put(w, buff, len);
+        return;
+    }
+
+    len = 0;
+    if (d < 0) {
+        buff[len++] = '-';
+        d           = -d;
+    }
+    len += json_shortest(d, buff + len);
+
+    json_put(w, buff, len);
+}
+
+static void json_quoted(Json_Writer *w, const char *s, unsigned long long len) {
+    static const char   hex[] = "0123456789abcdef";
+    const char         *end;
+    const char         *run;
+    char                esc[6];
+    unsigned char       c;
+#ifdef JULE_VEC_BYTES
+    Jule_Vec            v;
+    unsigned            mask;
+#endif
+
+    end = s + len;
+
+    json_put(w, "\"", 1);
+
+    run = s;
+    while (s < end) {
+#ifdef JULE_VEC_BYTES
+        /* Skip runs without '"', '\\' or control characters. */
+        while (end - s >= JULE_VEC_BYTES) {
+            v    = JULE_VEC_LOAD(s);
+            mask = JULE_VEC_MASK(JULE_VEC_OR(JULE_VEC_OR(JULE_VEC_EQ(v, JULE_VEC_SET1('"')),
+                                                         JULE_VEC_EQ(v, JULE_VEC_SET1('\\'))),
+                                             JULE_VEC_EQ(JULE_VEC_MIN(v, JULE_VEC_SET1(0x1f)), v)));
+            if (mask) {
+                s += __builtin_ctz(mask);
+                break;
+            }
+            s += JULE_VEC_BYTES;
+        }
+        if (s == end) { break; }
+#endif
+
+        c = *s;
+
+        if (c != '"' && c != '\\' && c >= 0x20) {
+            s += 1;
+            continue;
+        }
+
+        json_put(w, run, s - run);
+
+        esc[0] = '\\';
+        switch (c) {
+            case '"':  esc[1] = '"';  break;
+            case '\\': esc[1] = '\\'; break;
+            case '\b': esc[1] = 'b';  break;
+            case '\f': esc[1] = 'f';  break;
+            case '\n': esc[1] = 'n';  break;
+            case '\r': esc[1] = 'r';  break;
+            case '\t': esc[1] = 't';  break;
+            default:
+                esc[1] = 'u';
+                esc[2] = '0';
+                esc[3] = '0';
+                esc[4] = hex[c >> 4];
+                esc[5] = hex[c & 0xf];
+                json_put(w, esc, 6);
+                goto next;
+        }
+        json_put(w, esc, 2);
+
+next:;
+        s   += 1;
+        run  = s;
+    }
+
+    json_put(w, run, end - run);
+    json_put(w, "\"", 1);
+}
+
+typedef struct {
+    Jule_Interp *interp;
+    Jule_Value  *tree;
+    Json_Writer *w;
+    int          first;
+} Json_Object_Writer;
+
+static Jule_Status json_serialize(Jule_Interp *interp, Jule_Value *tree, Json_Writer *w, Jule_Value *value);
+
+static Jule_Status json_serialize_field(void *arg, Jule_Value *key, Jule_Value *val) {
+    Json_Object_Writer *ow;
+    char                b[32];
+
+    ow = arg;
+
+    if (!ow->first) { json_put(ow->w, ",", 1); }
+    ow->first = 0;
+
+    /* Keys must be strings in JSON. */
+    if (key->type == JULE_STRING) {
+        json_quoted(ow->w, jule_string_chars(key), jule_string_len(key));
+    } else if (key->type == JULE_NUMBER) {
+        json_quoted(ow->w, b, jule_number_to_chars(key->number, b));
+    } else {
+        json_put(ow->w, "\"null\"", 6);
+    }
+
+    json_put(ow->w, ":", 1);
+
+    return json_serialize(ow->interp, ow->tree, ow->w, val);
+}
+
+static Jule_Status json_serialize(Jule_Interp *interp, Jule_Value *tree, Json_Writer *w, Jule_Value *value) {
+    Jule_Status         status;
+    Jule_Value         *it;
+    int                 first;
+    Json_Object_Writer  ow;
+
+    status = JULE_SUCCESS;
+
+    switch (value->type) {
+        case JULE_NIL:
+            json_put(w, "null", 4);
+            break;
+        case JULE_NUMBER:
+            json_number(w, value->number);
+            break;
+        case JULE_STRING:
+            json_quoted(w, jule_string_chars(value), jule_string_len(value));
+            break;
+        case JULE_BUILDER:
+            json_quoted(w, value->builder->chars, value->builder->len);
+            break;
+        case JULE_LIST:
+            json_put(w, "[", 1);
+            first = 1;
+            FOR_EACH(value->list, it) {
+                if (!first) { json_put(w, ",", 1); }
+                first  = 0;
+                status = json_serialize(interp, tree, w, it);
+                if (status != JULE_SUCCESS) { goto out; }
+            }
+            json_put(w, "]", 1);
+            break;
+        case JULE_OBJECT:
+            json_put(w, "{", 1);
+            ow.interp = interp;
+            ow.tree   = tree;
+            ow.w      = w;
+            ow.first  = 1;
+            status = jule_traverse_object(value, json_serialize_field, &ow);
+            if (status != JULE_SUCCESS) { goto out; }
+            json_put(w, "}", 1);
+            break;
+        case _JULE_REF:
+            status = json_serialize(interp, tree, w, value->ref_of);
+            break;
+        default:
+            status = JULE_ERR_TYPE;
+            jule_make_type_error(interp, tree, _JULE_LIST_OR_OBJECT, value->type);
+            break;
+    }
+
+out:;
+    return status;
+}
+
+static Jule_Status j_stringify(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status  status;
+    Jule_Value  *value;
+    Json_Writer  w;
+
+    status = jule_args(interp, tree, "*", n_values, values, &value);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    memset(&w, 0, sizeof(w));
+    w.cap  = 64;
+    w.buff = JULE_MALLOC(w.cap);
+    w.fd   = -1;
+
+    status = json_serialize(interp, tree, &w, value);
+
+    if (status == JULE_SUCCESS) {
+        json_put(&w, "", 1);
+        *result = jule_string_value_consume(interp, w.buff, w.len - 1);
+    } else {
+        JULE_FREE(w.buff);
+        *result = NULL;
+    }
+
+    jule_free_value(value);
+
+out:;
+    return status;
+}
+
+/* (json:write path value) writes value and a newline to the file. Returns
+ * the number of bytes written, or nil if the file can't be opened. */
+static Jule_Status j_write(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status  status;
+    Jule_Value  *pathv;
+    Jule_Value  *value;
+    Json_Writer  w;
+
+    status = jule_args(interp, tree, "s*", n_values, values, &pathv, &value);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    memset(&w, 0, sizeof(w));
+
+    w.fd = open(jule_string_cstr(pathv), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if (w.fd < 0) {
+        *result = jule_nil_value();
+        goto out_free;
+    }
+
+    w.cap  = JSON_WRITE_SIZE;
+    w.buff = JULE_MALLOC(w.cap);
+
+    status = json_serialize(interp, tree, &w, value);
+    json_put(&w, "\n", 1);
+    json_flush(&w);
+
+    close(w.fd);
+    JULE_FREE(w.buff);
+
+    *result = status == JULE_SUCCESS ? jule_number_value(w.written) : NULL;
+
+out_free:;
+    jule_free_value(pathv);
+    jule_free_value(value);
+
+out:;
+    return status;
+}
+
+Jule_Value *jule_init_package(Jule_Interp *interp) {
+#define JULE_INSTALL_FN(_name, _fn) jule_install_fn(interp, jule_get_string_id(interp, (_name)), (_fn))
+
+    JULE_INSTALL_FN("json:parse",       j_parse);
+    JULE_INSTALL_FN("json:parse-lines", j_parse_lines);
+    JULE_INSTALL_FN("json:read",        j_read);
+    JULE_INSTALL_FN("json:read-lines",  j_read_lines);
+    JULE_INSTALL_FN("json:stringify",   j_stringify);
+    JULE_INSTALL_FN("json:write",       j_write);
+
+    return jule_string_value(interp, "json: JSON parse and serialize package.");
+}
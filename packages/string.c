@@ -1,4 +1,4 @@
-#define _XOPEN_SOURCE
+#define _GNU_SOURCE
 
 #define JULE_IMPL
 #include <jule.h>
@@ -6,12 +6,15 @@
 #include <time.h>
 
 static Jule_Status j_split(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
-    int         status;
-    Jule_Value *s;
-    Jule_Value *t;
-    char       *cpy;
-    const char *delim;
-    const char *tok;
+    int                 status;
+    Jule_Value         *s;
+    Jule_Value         *t;
+    const char         *str;
+    unsigned long long  str_len;
+    const char         *delim;
+    unsigned long long  delim_len;
+    unsigned long long  i;
+    unsigned long long  tok;
 
     status = jule_args(interp, tree, "ss", n_values, values, &s, &t);
     if (status != JULE_SUCCESS) {
@@ -19,17 +22,25 @@ static Jule_Status j_split(Jule_Interp *interp, Jule_Value *tree, unsigned n_val
         goto out;
     }
 
-    cpy   = jule_charptr_dup(jule_get_string(interp, s->string_id)->chars);
-    delim = jule_get_string(interp, t->string_id)->chars;
+    str       = jule_string_chars(s);
+    str_len   = jule_string_len(s);
+    delim     = jule_string_chars(t);
+    delim_len = jule_string_len(t);
 
     *result = jule_list_value();
 
-    for (tok = strtok(cpy, delim); tok != NULL; tok = strtok(NULL, delim)) {
-        (*result)->list = jule_push((*result)->list, jule_string_value(interp, tok));
+    /* Same semantics as strtok(): any character in delim separates tokens
+     * and empty tokens are dropped. Tokens are views into the original string. */
+    tok = 0;
+    for (i = 0; i <= str_len; i += 1) {
+        if (i == str_len || memchr(delim, str[i], delim_len) != NULL) {
+            if (i > tok) {
+                (*result)->list = jule_push((*result)->list, jule_substring_value(interp, s, tok, i - tok));
+            }
+            tok = i + 1;
+        }
     }
 
-    JULE_FREE(cpy);
-
     jule_free_value(s);
     jule_free_value(t);
 
@@ -41,12 +52,12 @@ static Jule_Status j_splits(Jule_Interp *interp, Jule_Value *tree, unsigned n_va
     int                 status;
     Jule_Value         *s;
     Jule_Value         *t;
-    char               *cpy;
+    const char         *str;
     const char         *delim;
     unsigned long long  delim_len;
     const char         *tok;
-    char               *next;
-    char                c;
+    const char         *end;
+    const char         *next;
 
     status = jule_args(interp, tree, "ss", n_values, values, &s, &t);
     if (status != JULE_SUCCESS) {
@@ -54,24 +65,22 @@ static Jule_Status j_splits(Jule_Interp *interp, Jule_Value *tree, unsigned n_va
         goto out;
     }
 
-    cpy       = jule_charptr_dup(jule_get_string(interp, s->string_id)->chars);
-    delim     = jule_get_string(interp, t->string_id)->chars;
-    delim_len = jule_get_string(interp, t->string_id)->len;
+    str       = jule_string_chars(s);
+    delim     = jule_string_chars(t);
+    delim_len = jule_string_len(t);
 
     *result = jule_list_value();
 
-    tok = cpy;
+    tok = str;
+    end = str + jule_string_len(s);
 
-    while ((next = strstr(tok, delim)) != NULL) {
-        c = *next;
-        *next = 0;
-        (*result)->list = jule_push((*result)->list, jule_string_value(interp, tok));
-        *next = c;
-        tok = next + delim_len;
+    if (delim_len > 0) {
+        while ((next = memmem(tok, end - tok, delim, delim_len)) != NULL) {
+            (*result)->list = jule_push((*result)->list, jule_substring_value(interp, s, tok - str, next - tok));
+            tok = next + delim_len;
+        }
     }
-    (*result)->list = jule_push((*result)->list, jule_string_value(interp, tok));
-
-    JULE_FREE(cpy);
+    (*result)->list = jule_push((*result)->list, jule_substring_value(interp, s, tok - str, end - tok));
 
     jule_free_value(s);
     jule_free_value(t);
@@ -81,15 +90,20 @@ out:;
 }
 
 static Jule_Status j_replace(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
-    int         status;
-    Jule_Value *s;
-    Jule_Value *a;
-    Jule_Value *b;
-    const char *base;
-    const char *old;
-    const char *new;
-    char       *str;
-    const char *found;
+    int                 status;
+    Jule_Value         *s;
+    Jule_Value         *a;
+    Jule_Value         *b;
+    const char         *old;
+    unsigned long long  old_len;
+    const char         *new;
+    unsigned long long  new_len;
+    const char         *base;
+    const char         *end;
+    const char         *found;
+    char               *str;
+    unsigned long long  len;
+    unsigned long long  cap;
 
     status = jule_args(interp, tree, "sss", n_values, values, &s, &a, &b);
     if (status != JULE_SUCCESS) {
@@ -97,30 +111,42 @@ static Jule_Status j_replace(Jule_Interp *interp, Jule_Value *tree, unsigned n_v
         goto out;
     }
 
-    base = jule_get_string(interp, s->string_id)->chars;
-    old  = jule_get_string(interp, a->string_id)->chars;
-    new  = jule_get_string(interp, b->string_id)->chars;
-
-    str = JULE_MALLOC(strlen(base) + 1);
-
-    str[0] = 0;
-
-    if (strlen(old) > 0) {
-        while ((found = strstr(base, old)) != NULL) {
-            str = JULE_REALLOC(str, strlen(str) + (found - base) + 1);
-            strncat(str, base, (found - base));
-            str = JULE_REALLOC(str, strlen(str) + strlen(new) + 1);
-            strcat(str, new);
-            base = found + strlen(old);
+    base    = jule_string_chars(s);
+    end     = base + jule_string_len(s);
+    old     = jule_string_chars(a);
+    old_len = jule_string_len(a);
+    new     = jule_string_chars(b);
+    new_len = jule_string_len(b);
+
+    cap = jule_string_len(s) + 1;
+    len = 0;
+    str = JULE_MALLOC(cap);
+
+#define APPEND(_p, _n)                               \
+do {                                                 \
+    while (len + (_n) + 1 > cap) {                   \
+        cap <<= 1;                                   \
+        str   = JULE_REALLOC(str, cap);              \
+    }                                                \
+    memcpy(str + len, (_p), (_n));                   \
+    len += (_n);                                     \
+} while (0)
+
+    if (old_len > 0) {
+        while ((found = memmem(base, end - base, old, old_len)) != NULL) {
+            APPEND(base, (unsigned long long)(found - base));
+            APPEND(new, new_len);
+            base = found + old_len;
         }
     }
 
-    str = JULE_REALLOC(str, strlen(str) + strlen(base) + 1);
-    strcat(str, base);
+    APPEND(base, (unsigned long long)(end - base));
+
+#undef APPEND
 
-    *result = jule_string_value(interp, str);
+    str[len] = 0;
 
-    JULE_FREE(str);
+    *result = jule_string_value_consume(interp, str, len);
 
     jule_free_value(s);
     jule_free_value(a);
@@ -133,9 +159,9 @@ out:;
 static Jule_Status j_trim(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
     int                 status;
     Jule_Value         *s;
-    char               *cpy;
-    char               *p;
-    unsigned long long  len;
+    const char         *chars;
+    unsigned long long  beg;
+    unsigned long long  end;
 
     status = jule_args(interp, tree, "s", n_values, values, &s);
     if (status != JULE_SUCCESS) {
@@ -143,19 +169,14 @@ static Jule_Status j_trim(Jule_Interp *interp, Jule_Value *tree, unsigned n_valu
         goto out;
     }
 
-    cpy = jule_charptr_dup(jule_get_string(interp, s->string_id)->chars);
-    p   = cpy;
-
-    while (*p && jule_is_space(*p)) { p += 1; }
-    len = strlen(p);
-    while (len && jule_is_space(p[len - 1])) {
-        p[len - 1] = 0;
-        len -= 1;
-    }
+    chars = jule_string_chars(s);
+    beg   = 0;
+    end   = jule_string_len(s);
 
-    *result = jule_string_value(interp, p);
+    while (beg < end && jule_is_space(chars[beg]))     { beg += 1; }
+    while (end > beg && jule_is_space(chars[end - 1])) { end -= 1; }
 
-    JULE_FREE(cpy);
+    *result = jule_substring_value(interp, s, beg, end - beg);
 
     jule_free_value(s);
 
@@ -168,7 +189,6 @@ static Jule_Status j_index(Jule_Interp *interp, Jule_Value *tree, unsigned n_val
     Jule_Value         *haystack;
     Jule_Value         *needle;
     const char         *h;
-    const char         *n;
     const char         *s;
 
     status = jule_args(interp, tree, "ss", n_values, values, &haystack, &needle);
@@ -177,10 +197,8 @@ static Jule_Status j_index(Jule_Interp *interp, Jule_Value *tree, unsigned n_val
         goto out;
     }
 
-    h = jule_get_string(interp, haystack->string_id)->chars;
-    n = jule_get_string(interp, needle->string_id)->chars;
-
-    s = strstr(h, n);
+    h = jule_string_chars(haystack);
+    s = memmem(h, jule_string_len(haystack), jule_string_chars(needle), jule_string_len(needle));
 
     if (s == NULL) {
         *result = jule_nil_value();
@@ -200,7 +218,6 @@ static Jule_Status j_contains(Jule_Interp *interp, Jule_Value *tree, unsigned n_
     Jule_Value         *haystack;
     Jule_Value         *needle;
     const char         *h;
-    const char         *n;
     const char         *s;
 
     status = jule_args(interp, tree, "ss", n_values, values, &haystack, &needle);
@@ -209,10 +226,8 @@ static Jule_Status j_contains(Jule_Interp *interp, Jule_Value *tree, unsigned n_
         goto out;
     }
 
-    h = jule_get_string(interp, haystack->string_id)->chars;
-    n = jule_get_string(interp, needle->string_id)->chars;
-
-    s = strstr(h, n);
+    h = jule_string_chars(haystack);
+    s = memmem(h, jule_string_len(haystack), jule_string_chars(needle), jule_string_len(needle));
 
     *result = jule_number_value(s != NULL);
 
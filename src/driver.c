@@ -9,33 +9,68 @@
 #include <limits.h>
 #include <stdlib.h>
 #include <libgen.h>
+#include <errno.h>
 
 Jule_Interp interp;
 
+/* Lines passed to each call of on-lines with -n. */
+#define LINE_BATCH (1024)
+
 static void on_jule_error(Jule_Error_Info *info);
+static int  run_stream(const char *path);
+static int  run_lines(int n_inputs, char **inputs);
 
 int main(int argc, char **argv) {
-    const char *code;
-    int         code_size;
     int         exe_path_length;
     char       *exe_path;
     char       *exe_dir;
+    const char *cache;
+    const char *threads;
+    struct stat st;
+    int         streaming;
+    int         lines;
+
+    /* jule -n script [input...] runs script's handlers over input lines. */
+    lines = argc > 1 && strcmp(argv[1], "-n") == 0;
+    if (lines) {
+        argc -= 1;
+        argv += 1;
+    }
 
     if (argc < 2) {
         fprintf(stderr, "expected at least one argument: a jule file path\n");
         return 1;
     }
 
-    if (jule_map_file_into_readonly_memory(argv[1], &code, &code_size)) {
-        fprintf(stderr, "error opening '%s'\n", argv[1]);
+    jule_init_interp(&interp);
+    jule_set_error_callback(&interp, on_jule_error);
+    jule_set_argv(&interp, argc - 1, argv + 1);
+
+    /* Scripts given as "-" or as a pipe are run as they arrive. */
+    streaming = strcmp(argv[1], "-") == 0
+             || (stat(argv[1], &st) == 0 && !S_ISREG(st.st_mode) && !S_ISDIR(st.st_mode));
+
+    if (lines && streaming) {
+        fprintf(stderr, "-n needs a script file; standard input is for the lines\n");
+        jule_free(&interp);
         return 1;
     }
 
+    interp.cur_file = jule_get_string_id(&interp, strcmp(argv[1], "-") == 0 ? "<stdin>" : argv[1]);
 
-    jule_init_interp(&interp);
-    jule_set_error_callback(&interp, on_jule_error);
-    jule_set_argv(&interp, argc - 1, argv + 1);
-    interp.cur_file = jule_get_string_id(&interp, argv[1]);
+    /* JULE_CACHE=1 caches parsed files next to their sources,
+     * JULE_CACHE=<dir> keeps the caches in <dir>. */
+    cache = getenv("JULE_CACHE");
+    if (cache != NULL && strcmp(cache, "0") != 0) {
+        jule_set_ast_cache(&interp, 1, (*cache == 0 || strcmp(cache, "1") == 0) ? NULL : cache);
+    }
+
+    /* JULE_PARSE_THREADS=<n> caps the threads used to parse large files,
+     * 1 parses on the main thread only. */
+    threads = getenv("JULE_PARSE_THREADS");
+    if (threads != NULL) {
+        jule_set_parse_threads(&interp, atoi(threads));
+    }
 
 
     exe_path_length = wai_getExecutablePath(NULL, 0, NULL);
@@ -51,13 +86,221 @@ int main(int argc, char **argv) {
         free(exe_path);
     }
 
-    jule_parse(&interp, code, strlen(code));
+    if (streaming) {
+        streaming = run_stream(argv[1]);
+        jule_free(&interp);
+        return streaming;
+    }
+
+    if (jule_parse_file(&interp, argv[1]) != JULE_SUCCESS) {
+        fprintf(stderr, "error opening '%s'\n", argv[1]);
+        jule_free(&interp);
+        return 1;
+    }
+
     jule_interp(&interp);
+
+    if (lines) {
+        lines = run_lines(argc - 2, argv + 2);
+        jule_free(&interp);
+        return lines;
+    }
+
     jule_free(&interp);
 
     return 0;
 }
 
+/* Returns nonzero if the input can't be read or doesn't parse. */
+static int run_stream(const char *path) {
+    int         fd;
+    char        buff[64 * 1024];
+    ssize_t     n;
+    Jule_Status status;
+    int         ret;
+
+    fd = strcmp(path, "-") == 0 ? 0 : open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "error opening '%s'\n", path);
+        return 1;
+    }
+
+    ret = 1;
+
+    while ((n = read(fd, buff, sizeof(buff))) != 0) {
+        if (n < 0) {
+            if (errno == EINTR) { continue; }
+            fprintf(stderr, "error reading '%s'\n", path);
+            goto out;
+        }
+
+        status = jule_parse_stream(&interp, buff, n);
+        if (status != JULE_SUCCESS) { goto out; }
+
+        status = jule_interp(&interp);
+        if (status != JULE_SUCCESS && status != JULE_ERR_NO_INPUT) { goto out; }
+    }
+
+    if (jule_parse_stream_end(&interp) != JULE_SUCCESS) { goto out; }
+
+    jule_interp(&interp);
+
+    ret = 0;
+
+out:;
+    if (fd != 0) { close(fd); }
+
+    return ret;
+}
+
+/* The number of parameters a handler takes, or -1 if it can't be told. */
+static int handler_arity(Jule_Value *fn) {
+    Jule_Value *def_tree;
+
+    if (fn->type == _JULE_FN) {
+        def_tree = jule_elem(fn->eval_values, 1);
+        if (def_tree->type == _JULE_TREE || def_tree->type == _JULE_TREE_LINE_LEADER) {
+            return jule_len(def_tree->eval_values) - 1;
+        }
+        return 0;
+    }
+
+    if (fn->type == _JULE_LAMBDA) {
+        if (jule_len(fn->eval_values) <= 2) { return 0; }
+        def_tree = jule_elem(fn->eval_values, 1);
+        if (def_tree->type == _JULE_TREE || def_tree->type == _JULE_TREE_LINE_LEADER) {
+            return jule_len(def_tree->eval_values);
+        }
+    }
+
+    return -1;
+}
+
+static Jule_Status call_handler(Jule_Value *fn, unsigned n_args, Jule_Value **args) {
+    Jule_Value  *tree;
+    Jule_Value  *result;
+    Jule_Status  status;
+
+    /* Errors inside the handler are reported where it was defined. */
+    tree = (fn->type == _JULE_FN || fn->type == _JULE_LAMBDA) ? jule_elem(fn->eval_values, 0) : fn;
+
+    status = jule_invoke(&interp, tree, fn, n_args, args, &result);
+    if (status == JULE_SUCCESS) {
+        jule_free_value(result);
+    }
+
+    return status;
+}
+
+/*
+ * With -n, the script runs first and then the function on-line is called
+ * with each line of the inputs (the files named after the script, or
+ * standard input), without its newline. If on-line takes a second
+ * parameter, it is given the line number, counted across all inputs.
+ * Alternatively, on-lines is called with lists of up to LINE_BATCH lines.
+ * While an input is being read, input-file is its path ("-" for standard
+ * input). on-end, if defined, is called with no arguments at the end.
+ * Inputs that can't be opened are reported and skipped, and then, like
+ * awk, the exit status is 2.
+ */
+static int run_lines(int n_inputs, char **inputs) {
+    static char        *std_input[] = { "-" };
+    Jule_Value         *on_line;
+    Jule_Value         *on_lines;
+    Jule_Value         *on_end;
+    Jule_Value         *args[2];
+    Jule_Value         *batch;
+    int                 arity;
+    int                 i;
+    int                 fd;
+    int                 bad_input;
+    Jule_Line_Reader    reader;
+    unsigned long long  off;
+    unsigned long long  len;
+    unsigned long long  nr;
+    Jule_Status         status;
+
+    on_line  = jule_lookup(&interp, jule_get_string_id(&interp, "on-line"));
+    on_lines = jule_lookup(&interp, jule_get_string_id(&interp, "on-lines"));
+    on_end   = jule_lookup(&interp, jule_get_string_id(&interp, "on-end"));
+
+    if (on_line == NULL && on_lines == NULL) {
+        fprintf(stderr, "-n: the script must define on-line or on-lines\n");
+        return 1;
+    }
+
+    if (n_inputs == 0) {
+        n_inputs = 1;
+        inputs   = std_input;
+    }
+
+    arity     = on_line == NULL ? 1 : handler_arity(on_line);
+    batch     = NULL;
+    nr        = 0;
+    status    = JULE_SUCCESS;
+    bad_input = 0;
+
+    for (i = 0; i < n_inputs; i += 1) {
+        fd = strcmp(inputs[i], "-") == 0 ? 0 : open(inputs[i], O_RDONLY);
+        if (fd < 0) {
+            fprintf(stderr, "error opening '%s'\n", inputs[i]);
+            bad_input = 1;
+            continue;
+        }
+
+        jule_install_var(&interp, jule_get_string_id(&interp, "input-file"), jule_string_value(&interp, inputs[i]));
+
+        jule_line_reader_init(&reader, fd);
+
+        while (status == JULE_SUCCESS && jule_line_reader_next(&reader, &off, &len)) {
+            nr += 1;
+
+            if (on_line == NULL) {
+                if (batch == NULL) { batch = jule_list_value(); }
+                batch->list = jule_push(batch->list, jule_line_reader_value(&interp, &reader, off, len));
+
+                if (jule_len(batch->list) == LINE_BATCH) {
+                    status = call_handler(on_lines, 1, &batch);
+                    jule_free_value(batch);
+                    batch = NULL;
+                }
+                continue;
+            }
+
+            args[0] = jule_line_reader_value(&interp, &reader, off, len);
+
+            if (arity == 2) {
+                args[1] = jule_number_value(nr);
+                status  = call_handler(on_line, 2, args);
+                jule_free_value(args[1]);
+            } else {
+                status = call_handler(on_line, 1, args);
+            }
+
+            jule_free_value(args[0]);
+        }
+
+        /* Batches don't span inputs so that input-file stays accurate. */
+        if (batch != NULL) {
+            if (status == JULE_SUCCESS) {
+                status = call_handler(on_lines, 1, &batch);
+            }
+            jule_free_value(batch);
+            batch = NULL;
+        }
+
+        jule_line_reader_free(&reader);
+        if (fd != 0) { close(fd); }
+
+        if (status != JULE_SUCCESS) { return 1; }
+    }
+
+    if (on_end != NULL && call_handler(on_end, 0, NULL) != JULE_SUCCESS) {
+        return 1;
+    }
+
+    return bad_input ? 2 : 0;
+}
 
 static void on_jule_error(Jule_Error_Info *info) {
     Jule_Status           status;
@@ -68,6 +311,7 @@ static void on_jule_error(Jule_Error_Info *info) {
     char                 *s;
     unsigned              i;
     Jule_Backtrace_Entry *it;
+    Jule_Parse_Location   loc;
 
     status = info->status;
 
@@ -119,6 +363,11 @@ static void on_jule_error(Jule_Error_Info *info) {
             fprintf(stderr, " (index: %s)", s);
             JULE_FREE(s);
             break;
+        case JULE_ERR_BAD_VALUE:
+            s = jule_to_string(info->interp, info->bad_value, 0);
+            fprintf(stderr, " (value: %s)", s);
+            JULE_FREE(s);
+            break;
         case JULE_ERR_FILE_NOT_FOUND:
         case JULE_ERR_FILE_IS_DIR:
         case JULE_ERR_MMAP_FAILED:
@@ -137,13 +386,14 @@ static void on_jule_error(Jule_Error_Info *info) {
         fprintf(stderr, "%sbacktrace:%s\n", blue, reset);
         for (i = jule_len(info->interp->backtrace); i > 0; i -= 1) {
             it = jule_elem(info->interp->backtrace, i - 1);
+            loc = jule_value_location(info->interp, it->file, it->tree);
 
             s = jule_to_string(info->interp, it->fn, 0);
             fprintf(stderr, "    %s%s:%u:%u%s %s%s%s\n",
                     blue,
                     it->file == NULL ? "<?>" : it->file->chars,
-                    it->fn->line,
-                    it->fn->col,
+                    loc.line,
+                    loc.col,
                     reset,
                     cyan,
                     s,
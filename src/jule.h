@@ -5,8 +5,6 @@
     _JULE_STATUS_X(JULE_SUCCESS,                             "No error.")                                                       \
     _JULE_STATUS_X(JULE_ERR_UNEXPECTED_EOS,                  "Unexpected end of input.")                                        \
     _JULE_STATUS_X(JULE_ERR_UNEXPECTED_TOK,                  "Unexpected token.")                                               \
-    _JULE_STATUS_X(JULE_ERR_LINE_TOO_LONG,                   "Token starts too far into a line (column too big).")              \
-    _JULE_STATUS_X(JULE_ERR_TOO_MANY_LINES,                  "You have exceeded the maximum number of lines in a single file.") \
     _JULE_STATUS_X(JULE_ERR_EXTRA_RPAREN,                    "Extraneous closing parenthesis.")                                 \
     _JULE_STATUS_X(JULE_ERR_MISSING_RPAREN,                  "End of line while parentheses left open.")                        \
     _JULE_STATUS_X(JULE_ERR_EMPTY_PARENS,                    "Empty parentheses are not allowed.")                              \
@@ -28,7 +26,8 @@
     _JULE_STATUS_X(JULE_ERR_LOAD_PACKAGE_FAILURE,            "Failed to load package.")                                         \
     _JULE_STATUS_X(JULE_ERR_USE_PACKAGE_FORBIDDEN,           "use-package has been disabled.")                                  \
     _JULE_STATUS_X(JULE_ERR_ADD_PACKAGE_DIRECTORY_FORBIDDEN, "add-package-directory has been disabled.")                        \
-    _JULE_STATUS_X(JULE_ERR_MUST_FOLLOW_IF,                  "This special-form function must follow `if` or `elif`.")
+    _JULE_STATUS_X(JULE_ERR_MUST_FOLLOW_IF,                  "This special-form function must follow `if` or `elif`.")          \
+    _JULE_STATUS_X(JULE_ERR_BAD_VALUE,                       "Invalid argument value.")
 
 #define _JULE_STATUS_X(e, s) e,
 typedef enum { _JULE_STATUS } Jule_Status;
@@ -42,12 +41,15 @@ typedef enum { _JULE_STATUS } Jule_Status;
     _JULE_TYPE_X(JULE_SYMBOL,            "symbol")                           \
     _JULE_TYPE_X(JULE_LIST,              "list")                             \
     _JULE_TYPE_X(JULE_OBJECT,            "object")                           \
+    _JULE_TYPE_X(JULE_BUILDER,           "builder")                          \
+    _JULE_TYPE_X(JULE_HANDLE,            "handle")                           \
     _JULE_TYPE_X(_JULE_REF,               "reference")                       \
     _JULE_TYPE_X(_JULE_TREE,             "unevaluated expression")           \
     _JULE_TYPE_X(_JULE_TREE_LINE_LEADER, "unevaluated expression")           \
     _JULE_TYPE_X(_JULE_FN,               "function")                         \
     _JULE_TYPE_X(_JULE_BUILTIN_FN,       "function (builtin)")               \
     _JULE_TYPE_X(_JULE_LAMBDA,           "lambda")                           \
+    _JULE_TYPE_X(_JULE_LAZY,             "unevaluated expression")           \
     _JULE_TYPE_X(_JULE_LIST_OR_OBJECT,   "list or object")                   \
     _JULE_TYPE_X(_JULE_KEYLIKE,          "keylike (string, number, or nil)")
 
@@ -70,11 +72,31 @@ typedef struct Jule_Value_Struct Jule_Value;
 struct Jule_String_Struct;
 typedef struct Jule_String_Struct Jule_String;
 
+struct Jule_Builder_Struct;
+typedef struct Jule_Builder_Struct Jule_Builder;
+
+struct Jule_Handle_Struct;
+typedef struct Jule_Handle_Struct Jule_Handle;
+
+/* Describes a kind of opaque handle. Packages define one of these statically
+ * and it is compared by address. finalize is called with the handle's data
+ * when the handle is closed or its last value is freed. */
+typedef struct {
+    const char  *name;
+    void       (*finalize)(void *data);
+} Jule_Handle_Type;
+
 typedef const Jule_String *Jule_String_ID;
 
 struct Jule_Array_Struct;
 typedef struct Jule_Array_Struct Jule_Array;
 
+struct Jule_Arena_Struct;
+typedef struct Jule_Arena_Struct Jule_Arena;
+
+struct Jule_Lazy_Body_Struct;
+typedef struct Jule_Lazy_Body_Struct Jule_Lazy_Body;
+
 struct Jule_Interp_Struct;
 typedef struct Jule_Interp_Struct Jule_Interp;
 
@@ -97,6 +119,7 @@ typedef struct {
     int                  wanted_arity;
     int                  got_arity;
     Jule_Value          *bad_index;
+    Jule_Value          *bad_value;
     char                *file;
     char                *path;
     char                *package_error_message;
@@ -104,10 +127,19 @@ typedef struct {
 
 typedef void (*Jule_Error_Callback)(Jule_Error_Info *info);
 typedef void (*Jule_Output_Callback)(const char*, int);
+typedef void (*Jule_Output_Data_Callback)(void*, const char*, int);
 typedef Jule_Status (*Jule_Eval_Callback)(Jule_Value *value);
+typedef Jule_Status (*Jule_Object_Visitor)(void *arg, Jule_Value *key, Jule_Value *val);
 
 typedef Jule_Status (*Jule_Fn)(Jule_Interp*, Jule_Value*, unsigned, Jule_Value**, Jule_Value**);
 
+typedef enum {
+    JULE_OUTPUT_AUTO,            /* Line buffered for terminals and callbacks, block buffered otherwise. */
+    JULE_OUTPUT_UNBUFFERED,
+    JULE_OUTPUT_LINE_BUFFERED,
+    JULE_OUTPUT_BLOCK_BUFFERED,
+} Jule_Output_Buffering;
+
 Jule_Status  jule_map_file_into_readonly_memory(const char *path, const char **addr, int *size);
 const char  *jule_error_string(Jule_Status error);
 const char  *jule_type_string(Jule_Type type);
@@ -115,22 +147,41 @@ char        *jule_to_string(Jule_Interp *interp, const Jule_Value *value, int fl
 Jule_Status  jule_init_interp(Jule_Interp *interp);
 Jule_Status  jule_set_error_callback(Jule_Interp *interp, Jule_Error_Callback cb);
 Jule_Status  jule_set_output_callback(Jule_Interp *interp, Jule_Output_Callback cb);
+Jule_Status  jule_set_output_data_callback(Jule_Interp *interp, Jule_Output_Data_Callback cb, void *data);
+Jule_Status  jule_set_output_buffering(Jule_Interp *interp, Jule_Output_Buffering buffering);
+Jule_Status  jule_flush_output(Jule_Interp *interp);
 Jule_Status  jule_set_eval_callback(Jule_Interp *interp, Jule_Eval_Callback cb);
 Jule_Status  jule_set_argv(Jule_Interp *interp, int argc, char **argv);
 Jule_Status  jule_load_package(Jule_Interp *interp, const char *name, Jule_Value **result);
 void         jule_free_error_info(Jule_Error_Info *info);
 Jule_Status  jule_parse(Jule_Interp *interp, const char *str, int size);
+Jule_Status  jule_parse_file(Jule_Interp *interp, const char *path);
+Jule_Status  jule_parse_stream(Jule_Interp *interp, const char *str, int size);
+Jule_Status  jule_parse_stream_end(Jule_Interp *interp);
+Jule_Parse_Location jule_value_location(Jule_Interp *interp, Jule_String_ID file, const Jule_Value *value);
+Jule_Status  jule_set_ast_cache(Jule_Interp *interp, int enabled, const char *dir);
+Jule_Status  jule_set_lazy_parse(Jule_Interp *interp, int enabled);
+Jule_Status  jule_set_parse_threads(Jule_Interp *interp, int n_threads);
 Jule_Status  jule_interp(Jule_Interp *interp);
 Jule_Value  *jule_nil_value(void);
 Jule_Value  *jule_number_value(double num);
 Jule_Value  *jule_string_value(Jule_Interp *interp, const char *str);
+Jule_Value  *jule_string_value_n(Jule_Interp *interp, const char *str, unsigned long long len);
+Jule_Value  *jule_string_value_consume(Jule_Interp *interp, char *str, unsigned long long len);
+Jule_Value  *jule_substring_value(Jule_Interp *interp, Jule_Value *string, unsigned long long offset, unsigned long long len);
 Jule_Value  *jule_symbol_value(Jule_Interp *interp, const char *symbol);
+Jule_Value  *jule_symbol_value_n(Jule_Interp *interp, const char *symbol, unsigned long long len);
 Jule_Value  *jule_list_value(void);
 Jule_Value  *jule_builtin_value(Jule_Fn fn);
 Jule_Value  *jule_object_value(void);
+Jule_Value  *jule_builder_value(void);
+Jule_Value  *jule_handle_value(const Jule_Handle_Type *type, void *data);
+void        *jule_handle_data(const Jule_Value *value, const Jule_Handle_Type *type);
+int          jule_close_handle(Jule_Value *value);
 Jule_Value  *jule_ref_value(Jule_Value *ref_of);
 Jule_Status  jule_insert(Jule_Value *object, Jule_Value *key, Jule_Value *val);
 Jule_Status  jule_delete(Jule_Value *object, Jule_Value *key);
+Jule_Status  jule_traverse_object(Jule_Value *object, Jule_Object_Visitor visitor, void *arg);
 Jule_Value  *jule_lookup(Jule_Interp *interp, Jule_String_ID id);
 Jule_Status  jule_install_var(Jule_Interp *interp, Jule_String_ID id, Jule_Value *val);
 Jule_Status  jule_install_fn(Jule_Interp *interp, Jule_String_ID id, Jule_Fn fn);
@@ -143,6 +194,13 @@ void         jule_free(Jule_Interp *interp);
 
 #ifdef JULE_IMPL
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#ifndef _XOPEN_SOURCE
+#define _XOPEN_SOURCE 700
+#endif
+
 #include <assert.h>
 
 #ifndef JULE_ASSERTIONS
@@ -155,12 +213,6 @@ void         jule_free(Jule_Interp *interp);
 #define JULE_ASSERT(...)
 #endif
 
-#ifndef _GNU_SOURCE
-#define _GNU_SOURCE
-#endif
-#ifndef _XOPEN_SOURCE
-#define _XOPEN_SOURCE 700
-#endif
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdint.h>
@@ -172,7 +224,15 @@ void         jule_free(Jule_Interp *interp);
 #include <sys/mman.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <errno.h>
 #include <dlfcn.h>
+#include <pthread.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #ifndef JULE_MALLOC
 #define JULE_MALLOC (malloc)
@@ -874,9 +934,33 @@ out:
     return status;
 }
 
+/*
+ * Strings come in two flavors (plus short strings, which are stored inline
+ * in the Jule_Value and have no Jule_String at all -- see jule_string_chars()):
+ *
+ *   - Interned strings live in interp->strings until jule_free() and are what
+ *     Jule_String_IDs point to. They are used for symbols and object keys.
+ *     Their chars are always NUL-terminated.
+ *
+ *   - Heap strings are reference counted and back every other string value
+ *     (literals, fmt results, lines read from files, etc.). They are freed as
+ *     soon as the last value that refers to them is freed.
+ *     A heap string may be a view into the characters of another (parent)
+ *     string, in which case it holds a reference to the parent and its chars
+ *     are not necessarily NUL-terminated. Use jule_heap_string_cstr() when a
+ *     terminated string is required.
+ *     A heap string may also own a read-only file mapping instead of malloc()ed
+ *     chars (see jule_heap_string_mapped()). Such strings are only ever used as
+ *     parents of views, and their mapping is unmapped when they are released.
+ */
 struct Jule_String_Struct {
     char               *chars;
     unsigned long long  len;
+    unsigned long long  hash;
+    unsigned            refs;
+    unsigned            interned : 1;
+    unsigned            mapped   : 1;
+    Jule_String        *parent;
 };
 
 static inline char *jule_charptr_ndup(const char *str, int len) {
@@ -893,17 +977,39 @@ static inline char *jule_charptr_dup(const char *str) {
     return jule_charptr_ndup(str, strlen(str));
 }
 
-static unsigned long long jule_charptr_hash(char *s) {
-    unsigned long hash = 5381;
-    int c;
+/* Hashes a word at a time and then runs the result through the murmur3
+ * finalizer so that the low bits are usable for the prime-sized tables. */
+static inline unsigned long long jule_hash_bytes(const char *s, unsigned long long len) {
+    const unsigned long long k = 0x9e3779b97f4a7c15ULL;
+    unsigned long long       h;
+    unsigned long long       w;
 
-    while ((c = *s++))
-    hash = ((hash << 5) + hash) + c; /* hash * 33 + c */
+    h = len * k;
 
-    return hash;
-}
+    while (len >= sizeof(w)) {
+        memcpy(&w, s, sizeof(w));
+        h    = ((h << 5) | (h >> 59)) ^ w;
+        h   *= k;
+        s   += sizeof(w);
+        len -= sizeof(w);
+    }
+
+    if (len > 0) {
+        w = 0;
+        memcpy(&w, s, len);
+        h  = ((h << 5) | (h >> 59)) ^ w;
+        h *= k;
+    }
 
-static int jule_charptr_equ(char *a, char *b) { return strcmp(a, b) == 0; }
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+
+    /* 0 means "not computed yet" in Jule_String. */
+    return h == 0 ? 1 : h;
+}
 
 static inline void jule_free_string(Jule_String *string) {
     JULE_FREE(string->chars);
@@ -914,6 +1020,8 @@ static inline void jule_free_string(Jule_String *string) {
 static inline Jule_String jule_string(const char *s, unsigned long long len) {
     Jule_String string;
 
+    memset(&string, 0, sizeof(string));
+
     string.len   = len;
     string.chars = JULE_MALLOC(string.len + 1);
     memcpy(string.chars, s, string.len);
@@ -925,6 +1033,8 @@ static inline Jule_String jule_string(const char *s, unsigned long long len) {
 static inline Jule_String jule_string_consume(char *s) {
     Jule_String string;
 
+    memset(&string, 0, sizeof(string));
+
     string.len   = strlen(s);
     string.chars = s;
 
@@ -935,6 +1045,192 @@ static inline Jule_String jule_strdup(Jule_String *s) {
     return jule_string(s->chars, s->len);
 }
 
+static inline Jule_String *jule_heap_string_consume(char *s, unsigned long long len) {
+    Jule_String *string;
+
+    string = JULE_MALLOC(sizeof(*string));
+    memset(string, 0, sizeof(*string));
+
+    string->chars = s;
+    string->len   = len;
+    string->refs  = 1;
+
+    return string;
+}
+
+static inline Jule_String *jule_heap_string(const char *s, unsigned long long len) {
+    return jule_heap_string_consume(jule_charptr_ndup(s, len), len);
+}
+
+/* Takes ownership of len bytes mapped at map. */
+static inline Jule_String *jule_heap_string_mapped(char *map, unsigned long long len) {
+    Jule_String *string;
+
+    string         = jule_heap_string_consume(map, len);
+    string->mapped = 1;
+
+    return string;
+}
+
+static inline void jule_string_retain(Jule_String *string) {
+    if (!string->interned) {
+        JULE_ASSERT(string->refs > 0);
+        string->refs += 1;
+    }
+}
+
+static inline void jule_string_release(Jule_String *string) {
+    if (string->interned) { return; }
+
+    JULE_ASSERT(string->refs > 0);
+
+    string->refs -= 1;
+
+    if (string->refs == 0) {
+        if (string->parent != NULL) {
+            jule_string_release(string->parent);
+        } else if (string->mapped) {
+            munmap(string->chars, string->len);
+        } else {
+            JULE_FREE(string->chars);
+        }
+        JULE_FREE(string);
+    }
+}
+
+static inline Jule_String *jule_string_view(Jule_String *of, unsigned long long offset, unsigned long long len) {
+    Jule_String *string;
+
+    JULE_ASSERT(offset + len <= of->len);
+
+    /* Always point at the string that owns the characters so that views of
+     * views don't form chains. */
+    if (of->parent != NULL) {
+        offset += of->chars - of->parent->chars;
+        of      = of->parent;
+    }
+
+    jule_string_retain(of);
+
+    string = JULE_MALLOC(sizeof(*string));
+    memset(string, 0, sizeof(*string));
+
+    string->chars  = of->chars + offset;
+    string->len    = len;
+    string->refs   = 1;
+    string->parent = of;
+
+    return string;
+}
+
+/* Returns a NUL-terminated version of the string's characters. Views that
+ * are not already terminated are given their own copy of the characters,
+ * which is visible to every value sharing the string. */
+static inline const char *jule_heap_string_cstr(Jule_String *string) {
+    Jule_String *parent;
+
+    if (string->parent == NULL || string->chars[string->len] == 0) {
+        return string->chars;
+    }
+
+    parent         = string->parent;
+    string->chars  = jule_charptr_ndup(string->chars, string->len);
+    string->parent = NULL;
+    jule_string_release(parent);
+
+    return string->chars;
+}
+
+/* Growable buffer behind JULE_BUILDER values. Appends are amortized O(1)
+ * so that output can be assembled piecewise without quadratic copying. */
+struct Jule_Builder_Struct {
+    char               *chars;
+    unsigned long long  len;
+    unsigned long long  cap;
+};
+
+static inline Jule_Builder *jule_builder(void) {
+    Jule_Builder *builder;
+
+    builder = JULE_MALLOC(sizeof(*builder));
+
+    builder->len   = 0;
+    builder->cap   = 64;
+    builder->chars = JULE_MALLOC(builder->cap);
+
+    return builder;
+}
+
+static inline void jule_free_builder(Jule_Builder *builder) {
+    JULE_FREE(builder->chars);
+    JULE_FREE(builder);
+}
+
+static inline void jule_builder_append(Jule_Builder *builder, const char *s, unsigned long long len) {
+    if (builder->len + len + 1 > builder->cap) {
+        while (builder->len + len + 1 > builder->cap) { builder->cap <<= 1; }
+        builder->chars = JULE_REALLOC(builder->chars, builder->cap);
+    }
+
+    memcpy(builder->chars + builder->len, s, len);
+    builder->len += len;
+}
+
+static inline Jule_Builder *jule_builder_dup(const Jule_Builder *builder) {
+    Jule_Builder *dup;
+
+    dup        = JULE_MALLOC(sizeof(*dup));
+    dup->len   = builder->len;
+    dup->cap   = builder->cap;
+    dup->chars = JULE_MALLOC(dup->cap);
+    memcpy(dup->chars, builder->chars, dup->len);
+
+    return dup;
+}
+
+/* Native resource behind JULE_HANDLE values. Copies of a handle value share
+ * it, so the data is finalized once: by jule_close_handle() or when the last
+ * value referring to it is freed. */
+struct Jule_Handle_Struct {
+    const Jule_Handle_Type *type;
+    void                   *data;
+    unsigned                refs;
+};
+
+static inline void jule_handle_finalize(Jule_Handle *handle) {
+    if (handle->data != NULL) {
+        handle->type->finalize(handle->data);
+        handle->data = NULL;
+    }
+}
+
+static inline void jule_handle_release(Jule_Handle *handle) {
+    JULE_ASSERT(handle->refs > 0);
+
+    handle->refs -= 1;
+
+    if (handle->refs == 0) {
+        jule_handle_finalize(handle);
+        JULE_FREE(handle);
+    }
+}
+
+/* The hash is computed on first use and cached in the string. */
+static inline unsigned long long jule_string_hash(const Jule_String *string) {
+    if (string->hash == 0) {
+        ((Jule_String*)string)->hash = jule_hash_bytes(string->chars, string->len);
+    }
+    return string->hash;
+}
+
+static inline int jule_string_equ(const Jule_String *a, const Jule_String *b) {
+    if (a == b)           { return 1; }
+    if (a->len != b->len) { return 0; }
+    if (a->hash != 0 && b->hash != 0 && a->hash != b->hash) { return 0; }
+
+    return memcmp(a->chars, b->chars, a->len) == 0;
+}
+
 
 struct Jule_Array_Struct {
     unsigned  len;
@@ -1032,8 +1328,8 @@ static inline void jule_erase(Jule_Array *array, unsigned idx) {
 
 
 #define JULE_MAX_BORROW_COUNT_POT (10)
-#define JULE_MAX_LINE_POT         (17)
-#define JULE_MAX_COL_POT          (10)
+#define JULE_SSTRING_MAX          (14)
+#define JULE_SSTRING_HEAP         (0xff)
 
 
 
@@ -1068,35 +1364,151 @@ struct Jule_Value_Struct {
     union {
         unsigned long long  _integer;
         double              number;
-        Jule_String_ID      string_id;
+        Jule_String        *string;
+        struct {
+            char            chars[JULE_SSTRING_MAX + 1];
+            unsigned char   len; /* JULE_SSTRING_HEAP when string is used. */
+        }                   sstring;
         Jule_String_ID      symbol_id;
         Jule_Object         object;
         Jule_Array         *list;
+        Jule_Builder       *builder;
+        Jule_Handle        *handle;
         Jule_Array         *eval_values;
         Jule_Fn             builtin_fn;
         Jule_Value         *ref_of;
+        Jule_Lazy_Body     *lazy;
     };
-    unsigned long long      type           :                         4; //  4
-    unsigned long long      in_symtab      :                         1; //  5
-    unsigned long long      local          :                         1; //  6
-    unsigned long long      borrow_count   : JULE_MAX_BORROW_COUNT_POT; // 16
-    unsigned long long      borrower_count : JULE_MAX_BORROW_COUNT_POT; // 26
-    unsigned long long      is_line_parent :                         1; // 27
-    unsigned long long      line           :         JULE_MAX_LINE_POT; // 44
-    unsigned long long      col            :          JULE_MAX_COL_POT; // 54
-    unsigned long long      ind_level      :          JULE_MAX_COL_POT; // 64
+    unsigned long long      type           :                         5; //  5
+    unsigned long long      in_symtab      :                         1; //  6
+    unsigned long long      local          :                         1; //  7
+    unsigned long long      borrow_count   : JULE_MAX_BORROW_COUNT_POT; // 17
+    unsigned long long      borrower_count : JULE_MAX_BORROW_COUNT_POT; // 27
+    unsigned long long      is_line_parent :                         1; // 28
+    unsigned long long      in_arena       :                         1; // 29
+    unsigned long long      loc            :                        32; // 61
+};
+
+static inline int jule_string_is_inline(const Jule_Value *value) {
+    return value->sstring.len != JULE_SSTRING_HEAP;
+}
+
+static inline void jule_set_heap_string(Jule_Value *value, Jule_String *string) {
+    value->string       = string;
+    value->sstring.len  = JULE_SSTRING_HEAP;
+}
+
+static inline void jule_set_inline_string(Jule_Value *value, const char *s, unsigned long long len) {
+    JULE_ASSERT(len <= JULE_SSTRING_MAX);
+
+    memcpy(value->sstring.chars, s, len);
+    value->sstring.chars[len] = 0;
+    value->sstring.len        = len;
+}
+
+/* Characters of a string value, whichever form it is stored in.
+ * Not necessarily NUL-terminated; see jule_string_cstr(). */
+static inline const char *jule_string_chars(const Jule_Value *value) {
+    return jule_string_is_inline(value) ? value->sstring.chars : value->string->chars;
+}
+
+static inline unsigned long long jule_string_len(const Jule_Value *value) {
+    return jule_string_is_inline(value) ? value->sstring.len : value->string->len;
+}
+
+static inline const char *jule_string_cstr(Jule_Value *value) {
+    return jule_string_is_inline(value) ? value->sstring.chars : jule_heap_string_cstr(value->string);
+}
+
+static inline unsigned long long jule_string_value_hash(const Jule_Value *value) {
+    return jule_string_is_inline(value)
+            ? jule_hash_bytes(value->sstring.chars, value->sstring.len)
+            : jule_string_hash(value->string);
+}
+
+static inline int jule_string_value_equ(const Jule_Value *a, const Jule_Value *b) {
+    if (!jule_string_is_inline(a) && !jule_string_is_inline(b)) {
+        return jule_string_equ(a->string, b->string);
+    }
+
+    return jule_string_len(a) == jule_string_len(b)
+        && memcmp(jule_string_chars(a), jule_string_chars(b), jule_string_len(a)) == 0;
+}
+
+static inline int jule_string_value_cmp(const Jule_Value *a, const Jule_Value *b) {
+    unsigned long long alen;
+    unsigned long long blen;
+    int                c;
+
+    alen = jule_string_len(a);
+    blen = jule_string_len(b);
+    c    = memcmp(jule_string_chars(a), jule_string_chars(b), alen < blen ? alen : blen);
+
+    if (c != 0) { return c; }
+
+    return (alen > blen) - (alen < blen);
+}
+
+/*
+ * Source locations
+ *
+ * A value created by the parser records where it came from in its loc field
+ * as (byte offset into the source + 1). Every other value has a loc of 0.
+ * Each parsed file keeps a table of the offsets at which its lines start, so
+ * line and column are only worked out when they are needed (i.e. for errors
+ * and backtraces). See jule_value_location().
+ */
+typedef struct {
+    unsigned *starts;
+    unsigned  n_lines;
+    unsigned  cap;
+} Jule_Line_Table;
+
+typedef Jule_Line_Table *Jule_Line_Table_Ptr;
+
+/* The source of a function body that hasn't been parsed yet. */
+struct Jule_Lazy_Body_Struct {
+    Jule_String_ID  file;
+    Jule_Array     *nodes; /* The parsed body, once expanded. */
+    unsigned        base;  /* Offset of src in file. */
+    unsigned        line;  /* Line number of the first line of src. */
+    unsigned        len;
+    char            src[];
 };
 
+/* Input given to jule_parse_stream() that doesn't yet form complete roots. */
+typedef struct {
+    char               *buff;
+    unsigned long long  len;
+    unsigned long long  cap;
+    unsigned long long  scanned; /* Lines starting before this have been looked at. */
+    unsigned long long  split;   /* Start of the last line beginning with a root, or 0. */
+    unsigned            offset;  /* Offset of buff in the whole input. */
+    int                 line;
+    Jule_Line_Table    *lines;
+    Jule_Arena         *arena;
+} Jule_Parse_Stream;
+
 typedef struct Jule_Parse_Context_Struct {
-    Jule_Interp *interp;
-    const char  *cursor;
-    const char  *end;
-    Jule_Array  *stack;
-    Jule_Array  *roots;
-    int          line;
-    int          col;
-    int          ind;
-    int          plevel;
+    Jule_Interp     *interp;
+    Jule_Arena      *arena;
+    const char      *start;
+    const char      *cursor;
+    const char      *end;
+    Jule_Array      *stack;
+    Jule_Array      *inds; /* Indentation of each entry in stack. */
+    Jule_Array      *roots;
+    Jule_Line_Table *lines;
+    unsigned         base; /* Offset of start in the file. */
+    int              line;
+    int              col;
+    int              ind;
+    int              plevel;
+    int              lazy;
+    int              quiet;   /* Don't report parse errors. */
+    void            *strings; /* A private _Jule_String_Table to intern symbols into, or NULL. */
+    Jule_String_ID   fn_id;
+    Jule_String_ID   localfn_id;
 } Jule_Parse_Context;
 
 
@@ -1116,12 +1528,10 @@ static unsigned long long jule_valhash(Jule_Value *val) {
         return 0;
     }
 
-    return jule_string_id_hash(val->string_id);
+    return jule_string_value_hash(val);
 }
 
 
-typedef char *Char_Ptr;
-
 typedef Jule_Value *Jule_Value_Ptr;
 
 use_hash_table(Jule_String_ID, Jule_Value_Ptr)
@@ -1132,14 +1542,64 @@ use_hash_table(Jule_Value_Ptr, Jule_Value_Ptr)
 
 typedef hash_table(Jule_Value_Ptr, Jule_Value_Ptr) _Jule_Object;
 
-use_hash_table(Char_Ptr, Jule_String_ID)
-typedef hash_table(Char_Ptr, Jule_String_ID) _Jule_String_Table;
+use_hash_table(Jule_String_ID, Jule_String_ID)
+typedef hash_table(Jule_String_ID, Jule_String_ID) _Jule_String_Table;
 
+use_hash_table(Jule_String_ID, Jule_Line_Table_Ptr)
+typedef hash_table(Jule_String_ID, Jule_Line_Table_Ptr) _Jule_Line_Table_Table;
+
+/* A file loaded by eval-file or require. Its parsed nodes are kept until the
+ * file changes on disk or the interpreter is freed.
+ *
+ * Functions defined by an older version of the file can outlive it and keep
+ * using its nodes, and nothing tracks which arenas they point into, so the
+ * arena of every version (and the line table that goes with it) is kept
+ * until the interpreter is freed. Memory grows by one parse of the file
+ * per reload. */
+typedef struct {
+    Jule_Arena         *arena;
+    Jule_Array         *nodes;
+    Jule_Array         *retired;    /* Stale node lists that were still being evaluated when replaced. */
+    Jule_Array         *old_arenas; /* Arenas of the versions that were replaced. */
+    Jule_Array         *old_lines;  /* The line table of each of old_arenas, or NULL. */
+    unsigned long long  size;
+    long long           mtime_sec;
+    long long           mtime_nsec;
+    unsigned            active;
+    int                 evaluated;
+} Jule_Module;
+
+typedef Jule_Module *Jule_Module_Ptr;
+
+use_hash_table(Jule_String_ID, Jule_Module_Ptr)
+typedef hash_table(Jule_String_ID, Jule_Module_Ptr) _Jule_Module_Table;
+
+
+#define JULE_FMT_CACHE_SIZE (256)
+#define JULE_FMT_CACHE_WAYS (4)
+
+/* A format string split into literal text and argument positions.
+ * Argument i is inserted at text offset splits[i]. */
+typedef struct {
+    const Jule_Value   *site;
+    char               *src;
+    unsigned long long  src_len;
+    char               *text;
+    unsigned long long  text_len;
+    unsigned            n_args;
+    unsigned long long *splits;
+} Jule_Fmt_Template;
 
 struct Jule_Interp_Struct {
     Jule_Array            *roots;
     Jule_Error_Callback    error_callback;
     Jule_Output_Callback   output_callback;
+    Jule_Output_Data_Callback output_data_callback;
+    void                  *output_data;
+    Jule_Output_Buffering  output_buffering;
+    Jule_Output_Buffering  output_mode; /* output_buffering with JULE_OUTPUT_AUTO resolved. */
+    char                  *output_buff;
+    unsigned               output_len;
     Jule_Eval_Callback     eval_callback;
     _Jule_String_Table     strings;
     _Jule_Symbol_Table     symtab;
@@ -1156,11 +1616,23 @@ struct Jule_Interp_Struct {
     Jule_Array            *backtrace;
     Jule_Fn                last_popped_builtin_fn;
     int                    last_if_was_true;
+    Jule_Fmt_Template     *fmt_cache[JULE_FMT_CACHE_SIZE];
+    int                    ast_cache_enabled;
+    char                  *ast_cache_dir;
+    _Jule_Module_Table     modules;
+    _Jule_Line_Table_Table line_tables;
+    Jule_Array            *arenas;
+    int                    lazy_parse;
+    Jule_Arena            *lazy_arena; /* Holds function bodies parsed by jule_expand_lazy(). */
+    int                    parse_threads;
+    Jule_Parse_Stream     *stream;
+    unsigned               next_root; /* Index of the first root that jule_interp() hasn't run. */
 };
 
 struct Jule_Backtrace_Entry_Struct {
     Jule_String_ID  file;
     Jule_Value     *fn;
+    Jule_Value     *tree; /* The call site. Its location is relative to file. */
 };
 
 
@@ -1171,21 +1643,47 @@ typedef struct Jule_Closure_Info_Struct {
 } Jule_Closure_Info;
 
 
-static Jule_String_ID jule_get_string_id(Jule_Interp *interp, const char *s) {
+/* Look up the interned version of key, creating it if it doesn't exist yet.
+ * key's cached hash (if any) is reused for the lookup. */
+static Jule_String_ID jule_intern_string_in(_Jule_String_Table strings, const Jule_String *key) {
     Jule_String_ID *lookup;
     Jule_String    *newstring;
 
-    lookup = hash_table_get_val(interp->strings, (char*)s);
+    lookup = hash_table_get_key(strings, key);
 
-    if (lookup == NULL) {
-        newstring  = JULE_MALLOC(sizeof(*newstring));
-        *newstring = jule_string(s, strlen(s));
-        hash_table_insert(interp->strings, (*newstring).chars, newstring);
-        lookup = hash_table_get_val(interp->strings, (char*)s);
-        JULE_ASSERT(lookup != NULL);
-    }
+    if (lookup != NULL) { return *lookup; }
+
+    newstring           = JULE_MALLOC(sizeof(*newstring));
+    *newstring          = jule_string(key->chars, key->len);
+    newstring->hash     = jule_string_hash(key);
+    newstring->interned = 1;
+
+    hash_table_insert(strings, newstring, newstring);
+
+    return newstring;
+}
+
+static Jule_String_ID jule_intern_string(Jule_Interp *interp, const Jule_String *key) {
+    return jule_intern_string_in(interp->strings, key);
+}
+
+static Jule_String_ID jule_get_string_id_n_in(_Jule_String_Table strings, const char *s, unsigned long long len) {
+    Jule_String key;
+
+    memset(&key, 0, sizeof(key));
+
+    key.chars = (char*)s;
+    key.len   = len;
+
+    return jule_intern_string_in(strings, &key);
+}
+
+static Jule_String_ID jule_get_string_id_n(Jule_Interp *interp, const char *s, unsigned long long len) {
+    return jule_get_string_id_n_in(interp->strings, s, len);
+}
 
-    return *lookup;
+static Jule_String_ID jule_get_string_id(Jule_Interp *interp, const char *s) {
+    return jule_get_string_id_n(interp, s, strlen(s));
 }
 
 static inline const Jule_String *jule_get_string(Jule_Interp *interp, Jule_String_ID id) {
@@ -1217,7 +1715,24 @@ Jule_Status jule_set_error_callback(Jule_Interp *interp, Jule_Error_Callback cb)
 }
 
 Jule_Status jule_set_output_callback(Jule_Interp *interp, Jule_Output_Callback cb) {
+    jule_flush_output(interp);
     interp->output_callback = cb;
+    interp->output_mode     = JULE_OUTPUT_AUTO;
+    return JULE_SUCCESS;
+}
+
+Jule_Status jule_set_output_data_callback(Jule_Interp *interp, Jule_Output_Data_Callback cb, void *data) {
+    jule_flush_output(interp);
+    interp->output_data_callback = cb;
+    interp->output_data          = data;
+    interp->output_mode          = JULE_OUTPUT_AUTO;
+    return JULE_SUCCESS;
+}
+
+Jule_Status jule_set_output_buffering(Jule_Interp *interp, Jule_Output_Buffering buffering) {
+    jule_flush_output(interp);
+    interp->output_buffering = buffering;
+    interp->output_mode      = JULE_OUTPUT_AUTO;
     return JULE_SUCCESS;
 }
 
@@ -1345,6 +1860,9 @@ void jule_free_error_info(Jule_Error_Info *info) {
     if (info->bad_index != NULL) {
         jule_free_value(info->bad_index);
     }
+    if (info->bad_value != NULL) {
+        jule_free_value(info->bad_value);
+    }
     if (info->file != NULL) {
         JULE_FREE(info->file);
     }
@@ -1365,119 +1883,580 @@ static inline Jule_Value *_jule_value(void) {
     return value;
 }
 
-Jule_Value *jule_nil_value(void) {
-    Jule_Value *value;
+/*
+ * Arenas
+ *
+ * Parsed code is allocated from a per-file arena. Nodes are laid out in the
+ * order the parser creates them (pre-order, so a tree's children directly
+ * follow it unless they are trees themselves) and each tree's child array
+ * is moved into the arena once the file is parsed.
+ *
+ * Arena nodes are marked in_arena. They are never modified or freed on their
+ * own, so copies of parsed trees (e.g. function definitions) share the
+ * parsed children instead of duplicating them. An arena is released in one
+ * go by jule_free_arena() once nothing can refer to its nodes, which in
+ * practice means in jule_free().
+ */
+
+#define JULE_ARENA_BLOCK_SIZE (64 * 1024)
+
+typedef struct Jule_Arena_Block_Struct {
+    struct Jule_Arena_Block_Struct *next;
+    unsigned long long              used;
+    unsigned long long              size;
+    char                            mem[];
+} Jule_Arena_Block;
+
+struct Jule_Arena_Struct {
+    Jule_Arena_Block *blocks;
+    Jule_Array       *strings; /* Heap strings held by string literals in the arena. */
+};
 
-    value = _jule_value();
+static Jule_Arena *jule_arena(void) {
+    Jule_Arena *arena;
 
-    value->type = JULE_NIL;
+    arena          = JULE_MALLOC(sizeof(*arena));
+    arena->blocks  = NULL;
+    arena->strings = JULE_ARRAY_INIT;
 
-    return value;
+    return arena;
 }
 
-Jule_Value *jule_number_value(double num) {
-    Jule_Value *value;
+static void *jule_arena_alloc(Jule_Arena *arena, unsigned long long size) {
+    Jule_Arena_Block *block;
+    void             *mem;
 
-    value = _jule_value();
+    size  = (size + 7) & ~7ull;
+    block = arena->blocks;
 
-    value->type   = JULE_NUMBER;
-    value->number = num;
+    if (block == NULL || block->size - block->used < size) {
+        if (size > JULE_ARENA_BLOCK_SIZE / 4) {
+            /* Big allocations get a block of their own, placed behind the
+             * current block so that it keeps being filled. */
+            block       = JULE_MALLOC(sizeof(*block) + size);
+            block->used = 0;
+            block->size = size;
 
-    return value;
+            if (arena->blocks != NULL) {
+                block->next         = arena->blocks->next;
+                arena->blocks->next = block;
+            } else {
+                block->next   = NULL;
+                arena->blocks = block;
+            }
+        } else {
+            block         = JULE_MALLOC(sizeof(*block) + JULE_ARENA_BLOCK_SIZE);
+            block->used   = 0;
+            block->size   = JULE_ARENA_BLOCK_SIZE;
+            block->next   = arena->blocks;
+            arena->blocks = block;
+        }
+    }
+
+    mem          = block->mem + block->used;
+    block->used += size;
+
+    return mem;
 }
 
-Jule_Value *jule_string_value(Jule_Interp *interp, const char *str) {
+static Jule_Value *jule_arena_value(Jule_Arena *arena, Jule_Type type) {
     Jule_Value *value;
 
-    value = _jule_value();
+    value = jule_arena_alloc(arena, sizeof(*value));
+    memset(value, 0, sizeof(*value));
 
-    value->type      = JULE_STRING;
-    value->string_id = jule_get_string_id(interp, str);
+    value->type     = type;
+    value->in_arena = 1;
 
     return value;
 }
 
-Jule_Value *jule_symbol_value(Jule_Interp *interp, const char *symbol) {
+/* Like jule_string_value_consume(), but the value lives in the arena. */
+static Jule_Value *jule_arena_string_value_consume(Jule_Arena *arena, char *str, unsigned long long len) {
     Jule_Value *value;
 
-    value = _jule_value();
+    value = jule_arena_value(arena, JULE_STRING);
 
-    value->type      = JULE_SYMBOL;
-    value->symbol_id = jule_get_string_id(interp, symbol);
+    if (len <= JULE_SSTRING_MAX) {
+        jule_set_inline_string(value, str, len);
+        JULE_FREE(str);
+    } else {
+        jule_set_heap_string(value, jule_heap_string_consume(str, len));
+        arena->strings = jule_push(arena->strings, value->string);
+    }
 
     return value;
 }
 
-Jule_Value *jule_list_value(void) {
+static Jule_Value *jule_arena_string_value_n(Jule_Arena *arena, const char *str, unsigned long long len) {
     Jule_Value *value;
 
-    value = _jule_value();
+    if (len > JULE_SSTRING_MAX) {
+        return jule_arena_string_value_consume(arena, jule_charptr_ndup(str, len), len);
+    }
 
-    value->type = JULE_LIST;
+    value = jule_arena_value(arena, JULE_STRING);
+    jule_set_inline_string(value, str, len);
 
     return value;
 }
 
-Jule_Value *jule_builtin_value(Jule_Fn fn) {
-    Jule_Value *value;
+/* Copy a heap array into the arena with no spare capacity and free it. */
+static Jule_Array *jule_arena_array(Jule_Arena *arena, Jule_Array *heap_array) {
+    Jule_Array *array;
+    unsigned    len;
+    unsigned    i;
 
-    value = _jule_value();
+    len        = jule_len(heap_array);
+    array      = jule_arena_alloc(arena, sizeof(*array) + (len * sizeof(void*)));
+    array->len = len;
+    array->cap = len;
+    array->aux = heap_array == NULL ? NULL : heap_array->aux;
+    /* A loop rather than memcpy(): at -O3, GCC's -Warray-bounds misjudges
+     * the flexible array once this is inlined into jule_expand_lazy(). */
+    for (i = 0; i < len; i += 1) {
+        array->data[i] = heap_array->data[i];
+    }
 
-    value->type       = _JULE_BUILTIN_FN;
-    value->builtin_fn = fn;
+    jule_free_array(heap_array);
 
-    return value;
+    return array;
 }
 
-Jule_Value *jule_object_value(void) {
-    Jule_Value *value;
+/* Move the child arrays of a parsed tree into the arena. */
+static void jule_arena_seal(Jule_Arena *arena, Jule_Value *value) {
+    Jule_Array *array;
+    Jule_Value *child;
 
-    value = _jule_value();
+    if (value->type != _JULE_TREE && value->type != _JULE_TREE_LINE_LEADER) { return; }
 
-    value->type   = JULE_OBJECT;
-    value->object = hash_table_make_e(Jule_Value_Ptr, Jule_Value_Ptr, jule_valhash, jule_equal);
+    array              = jule_arena_array(arena, value->eval_values);
+    value->eval_values = array;
 
-    return value;
+    FOR_EACH(array, child) {
+        jule_arena_seal(arena, child);
+    }
 }
 
-Jule_Value *jule_ref_value(Jule_Value *ref_of) {
-    Jule_Value *value;
+/* Move everything in src into dst and free src. */
+static void jule_arena_merge(Jule_Arena *dst, Jule_Arena *src) {
+    Jule_Arena_Block *tail;
+    Jule_String      *string;
 
-    value = _jule_value();
+    if (src->blocks != NULL) {
+        for (tail = src->blocks; tail->next != NULL; tail = tail->next);
 
-    value->type   = _JULE_REF;
-    value->ref_of = ref_of;
+        tail->next  = dst->blocks;
+        dst->blocks = src->blocks;
+    }
 
-    JULE_BORROW(ref_of);
-    JULE_BORROWER(value);
+    FOR_EACH(src->strings, string) {
+        dst->strings = jule_push(dst->strings, string);
+    }
 
-    return value;
+    jule_free_array(src->strings);
+    JULE_FREE(src);
 }
 
-static inline int jule_value_is_freeable(Jule_Value *value) {
-    return !(value->borrower_count || value->borrow_count || value->in_symtab);
-}
+static void jule_free_arena(Jule_Arena *arena) {
+    Jule_Arena_Block *block;
+    Jule_Arena_Block *next;
+    Jule_String      *string;
 
-static void _jule_free_value(Jule_Value *value, int force) {
-    Jule_Value         *child;
-    Jule_Value         *key;
-    Jule_Value        **val;
-    Jule_Closure_Info  *closure;
-    Jule_String_ID      sym;
+    FOR_EACH(arena->strings, string) {
+        jule_string_release(string);
+    }
+    jule_free_array(arena->strings);
 
-    JULE_ASSERT((!force || !value->borrow_count)
-    && "why are we forcing a free of a borrowed value?");
+    for (block = arena->blocks; block != NULL; block = next) {
+        next = block->next;
+        JULE_FREE(block);
+    }
 
-    if (!force && !jule_value_is_freeable(value)) { return; }
+    JULE_FREE(arena);
+}
 
+static int jule_arena_holds(const Jule_Arena *arena, const void *ptr) {
+    const Jule_Arena_Block *block;
 
-    switch (value->type) {
-        case JULE_NIL:
-            break;
-        case JULE_NUMBER:
-            break;
-        case JULE_STRING:
-            break;
+    for (block = arena->blocks; block != NULL; block = block->next) {
+        if ((const char*)ptr >= block->mem && (const char*)ptr < block->mem + block->used) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+Jule_Value *jule_nil_value(void) {
+    Jule_Value *value;
+
+    value = _jule_value();
+
+    value->type = JULE_NIL;
+
+    return value;
+}
+
+Jule_Value *jule_number_value(double num) {
+    Jule_Value *value;
+
+    value = _jule_value();
+
+    value->type   = JULE_NUMBER;
+    value->number = num;
+
+    return value;
+}
+
+Jule_Value *jule_string_value(Jule_Interp *interp, const char *str) {
+    return jule_string_value_n(interp, str, strlen(str));
+}
+
+Jule_Value *jule_string_value_n(Jule_Interp *interp, const char *str, unsigned long long len) {
+    Jule_Value *value;
+
+    (void)interp;
+
+    value = _jule_value();
+
+    value->type = JULE_STRING;
+
+    if (len <= JULE_SSTRING_MAX) {
+        jule_set_inline_string(value, str, len);
+    } else {
+        jule_set_heap_string(value, jule_heap_string(str, len));
+    }
+
+    return value;
+}
+
+Jule_Value *jule_string_value_consume(Jule_Interp *interp, char *str, unsigned long long len) {
+    Jule_Value *value;
+
+    (void)interp;
+
+    value = _jule_value();
+
+    value->type = JULE_STRING;
+
+    if (len <= JULE_SSTRING_MAX) {
+        jule_set_inline_string(value, str, len);
+        JULE_FREE(str);
+    } else {
+        jule_set_heap_string(value, jule_heap_string_consume(str, len));
+    }
+
+    return value;
+}
+
+Jule_Value *jule_substring_value(Jule_Interp *interp, Jule_Value *string, unsigned long long offset, unsigned long long len) {
+    Jule_Value *value;
+
+    (void)interp;
+
+    JULE_ASSERT(string->type == JULE_STRING);
+
+    value = _jule_value();
+
+    value->type = JULE_STRING;
+
+    /* Short substrings are copied so that they don't keep the parent alive. */
+    if (len <= JULE_SSTRING_MAX) {
+        JULE_ASSERT(offset + len <= jule_string_len(string));
+        jule_set_inline_string(value, jule_string_chars(string) + offset, len);
+    } else {
+        jule_set_heap_string(value, jule_string_view(string->string, offset, len));
+    }
+
+    return value;
+}
+
+/*
+ * Splits what is read from a file descriptor into lines. Input is read in
+ * large blocks into a heap string (the chunk) and split at newlines with
+ * memchr(). Lines are handed out as views into the chunk (or inline, when
+ * short), so a line is never copied or rescanned. A chunk that still has live
+ * views is left alone and a new one is started; otherwise it is reused.
+ */
+
+#define JULE_LINE_READ_SIZE (64 * 1024)
+
+typedef struct {
+    int                 fd;
+    Jule_String        *chunk;
+    unsigned long long  cap;
+    unsigned long long  start;
+    unsigned long long  scanned;
+    int                 eof;
+} Jule_Line_Reader;
+
+static inline void jule_line_reader_init(Jule_Line_Reader *reader, int fd) {
+    memset(reader, 0, sizeof(*reader));
+    reader->fd = fd;
+}
+
+/* Releases the reader's chunk. The file descriptor is left open. */
+static inline void jule_line_reader_free(Jule_Line_Reader *reader) {
+    if (reader->chunk != NULL) {
+        jule_string_release(reader->chunk);
+        reader->chunk = NULL;
+    }
+}
+
+static inline Jule_String *jule_line_reader_new_chunk(unsigned long long cap) {
+    return jule_heap_string_consume(JULE_MALLOC(cap + 1), 0);
+}
+
+static inline void jule_line_reader_fill(Jule_Line_Reader *reader) {
+    Jule_String        *chunk;
+    unsigned long long  keep;
+    ssize_t             n;
+
+    if (reader->chunk == NULL) {
+        reader->cap   = JULE_LINE_READ_SIZE;
+        reader->chunk = jule_line_reader_new_chunk(reader->cap);
+    }
+
+    chunk = reader->chunk;
+
+    if (chunk->len == reader->cap) {
+        keep = chunk->len - reader->start;
+
+        if (keep == reader->cap) {
+            /* A line longer than the buffer. */
+            reader->cap <<= 1;
+        }
+
+        if (chunk->refs == 1 && keep < reader->cap && reader->start > 0) {
+            memmove(chunk->chars, chunk->chars + reader->start, keep);
+        } else if (chunk->refs == 1) {
+            chunk->chars = JULE_REALLOC(chunk->chars, reader->cap + 1);
+        } else {
+            reader->chunk = jule_line_reader_new_chunk(reader->cap);
+            memcpy(reader->chunk->chars, chunk->chars + reader->start, keep);
+            jule_string_release(chunk);
+            chunk = reader->chunk;
+        }
+
+        chunk->len       = keep;
+        reader->scanned -= reader->start;
+        reader->start    = 0;
+    }
+
+    do {
+        n = read(reader->fd, chunk->chars + chunk->len, reader->cap - chunk->len);
+    } while (n < 0 && errno == EINTR);
+
+    if (n <= 0) {
+        reader->eof = 1;
+    } else {
+        chunk->len += n;
+    }
+
+    chunk->chars[chunk->len] = 0;
+}
+
+/* Sets *off and *len to the next line (without its newline) within
+ * reader->chunk and returns 1, or returns 0 at the end of the input. */
+static inline int jule_line_reader_next(Jule_Line_Reader *reader, unsigned long long *off, unsigned long long *len) {
+    const char *nl;
+
+    for (;;) {
+        if (reader->chunk != NULL) {
+            nl = memchr(reader->chunk->chars + reader->scanned, '\n', reader->chunk->len - reader->scanned);
+            if (nl != NULL) {
+                *off            = reader->start;
+                *len            = (nl - reader->chunk->chars) - reader->start;
+                reader->start   = (nl - reader->chunk->chars) + 1;
+                reader->scanned = reader->start;
+                return 1;
+            }
+
+            reader->scanned = reader->chunk->len;
+
+            if (reader->eof) {
+                if (reader->start == reader->chunk->len) { return 0; }
+
+                *off            = reader->start;
+                *len            = reader->chunk->len - reader->start;
+                reader->start   = reader->chunk->len;
+                reader->scanned = reader->start;
+                return 1;
+            }
+        }
+
+        jule_line_reader_fill(reader);
+    }
+}
+
+/* A string value for a line found by jule_line_reader_next(). */
+static inline Jule_Value *jule_line_reader_value(Jule_Interp *interp, Jule_Line_Reader *reader, unsigned long long off, unsigned long long len) {
+    Jule_Value *value;
+
+    if (len <= JULE_SSTRING_MAX) {
+        return jule_string_value_n(interp, reader->chunk->chars + off, len);
+    }
+
+    value       = _jule_value();
+    value->type = JULE_STRING;
+    jule_set_heap_string(value, jule_string_view(reader->chunk, off, len));
+
+    return value;
+}
+
+/* Replace a string value's heap string with the equivalent interned string.
+ * Inline strings are already as cheap as they get and are left alone. */
+static void jule_intern_value(Jule_Interp *interp, Jule_Value *value) {
+    Jule_String *interned;
+
+    if (value->type != JULE_STRING
+    ||  jule_string_is_inline(value)
+    ||  value->string->interned) {
+        return;
+    }
+
+    interned = (Jule_String*)jule_intern_string(interp, value->string);
+    jule_string_release(value->string);
+    value->string = interned;
+}
+
+Jule_Value *jule_symbol_value(Jule_Interp *interp, const char *symbol) {
+    return jule_symbol_value_n(interp, symbol, strlen(symbol));
+}
+
+Jule_Value *jule_symbol_value_n(Jule_Interp *interp, const char *symbol, unsigned long long len) {
+    Jule_Value *value;
+
+    value = _jule_value();
+
+    value->type      = JULE_SYMBOL;
+    value->symbol_id = jule_get_string_id_n(interp, symbol, len);
+
+    return value;
+}
+
+Jule_Value *jule_list_value(void) {
+    Jule_Value *value;
+
+    value = _jule_value();
+
+    value->type = JULE_LIST;
+
+    return value;
+}
+
+Jule_Value *jule_builtin_value(Jule_Fn fn) {
+    Jule_Value *value;
+
+    value = _jule_value();
+
+    value->type       = _JULE_BUILTIN_FN;
+    value->builtin_fn = fn;
+
+    return value;
+}
+
+Jule_Value *jule_object_value(void) {
+    Jule_Value *value;
+
+    value = _jule_value();
+
+    value->type   = JULE_OBJECT;
+    value->object = hash_table_make_e(Jule_Value_Ptr, Jule_Value_Ptr, jule_valhash, jule_equal);
+
+    return value;
+}
+
+Jule_Value *jule_builder_value(void) {
+    Jule_Value *value;
+
+    value = _jule_value();
+
+    value->type    = JULE_BUILDER;
+    value->builder = jule_builder();
+
+    return value;
+}
+
+Jule_Value *jule_handle_value(const Jule_Handle_Type *type, void *data) {
+    Jule_Value *value;
+
+    value = _jule_value();
+
+    value->type           = JULE_HANDLE;
+    value->handle         = JULE_MALLOC(sizeof(*value->handle));
+    value->handle->type   = type;
+    value->handle->data   = data;
+    value->handle->refs   = 1;
+
+    return value;
+}
+
+/* Returns the data of an open handle of the given type, or NULL. */
+void *jule_handle_data(const Jule_Value *value, const Jule_Handle_Type *type) {
+    if (value->type != JULE_HANDLE || value->handle->type != type) {
+        return NULL;
+    }
+
+    return value->handle->data;
+}
+
+/* Finalizes the handle's data now rather than when the last value referring
+ * to it is freed. Returns 0 if it was already closed. */
+int jule_close_handle(Jule_Value *value) {
+    if (value->type != JULE_HANDLE || value->handle->data == NULL) {
+        return 0;
+    }
+
+    jule_handle_finalize(value->handle);
+
+    return 1;
+}
+
+Jule_Value *jule_ref_value(Jule_Value *ref_of) {
+    Jule_Value *value;
+
+    value = _jule_value();
+
+    value->type   = _JULE_REF;
+    value->ref_of = ref_of;
+
+    JULE_BORROW(ref_of);
+    JULE_BORROWER(value);
+
+    return value;
+}
+
+static inline int jule_value_is_freeable(Jule_Value *value) {
+    return !(value->borrower_count || value->borrow_count || value->in_symtab);
+}
+
+static void _jule_free_value(Jule_Value *value, int force) {
+    Jule_Value         *child;
+    Jule_Value         *key;
+    Jule_Value        **val;
+    Jule_Closure_Info  *closure;
+    Jule_String_ID      sym;
+
+    if (value->in_arena) { return; }
+
+    JULE_ASSERT((!force || !value->borrow_count)
+    && "why are we forcing a free of a borrowed value?");
+
+    if (!force && !jule_value_is_freeable(value)) { return; }
+
+
+    switch (value->type) {
+        case JULE_NIL:
+            break;
+        case JULE_NUMBER:
+            break;
+        case JULE_STRING:
+            if (!jule_string_is_inline(value)) {
+                jule_string_release(value->string);
+            }
+            break;
         case JULE_SYMBOL:
             break;
         case JULE_LIST:
@@ -1498,6 +2477,12 @@ static void _jule_free_value(Jule_Value *value, int force) {
             hash_table_free((_Jule_Object)value->object);
             value->object = NULL;
             break;
+        case JULE_BUILDER:
+            jule_free_builder(value->builder);
+            break;
+        case JULE_HANDLE:
+            jule_handle_release(value->handle);
+            break;
         case _JULE_REF:
             JULE_ASSERT(value->borrower_count == 0 && "still marked as a borrower");
             break;
@@ -1618,8 +2603,27 @@ Jule_Status jule_delete(Jule_Value *object, Jule_Value *key) {
     return JULE_SUCCESS;
 }
 
+/* Calls visitor on every field of object until it returns something other
+ * than JULE_SUCCESS, which is then returned. The object must not be modified
+ * along the way. */
+Jule_Status jule_traverse_object(Jule_Value *object, Jule_Object_Visitor visitor, void *arg) {
+    Jule_Status   status;
+    Jule_Value   *key;
+    Jule_Value  **val;
+
+    status = JULE_SUCCESS;
+
+    hash_table_traverse((_Jule_Object)object->object, key, val) {
+        status = visitor(arg, key, *val);
+        if (status != JULE_SUCCESS) { break; }
+    }
+
+    return status;
+}
+
 static Jule_Value *_jule_copy(Jule_Value *value, int force) {
     Jule_Value         *copy;
+    Jule_Value         *cpy;
     Jule_Array         *array = JULE_ARRAY_INIT;
     Jule_Value         *child;
     _Jule_Object        obj;
@@ -1634,12 +2638,22 @@ static Jule_Value *_jule_copy(Jule_Value *value, int force) {
     copy = _jule_value();
     memcpy(copy, value, sizeof(*copy));
 
+    copy->in_arena = 0;
+
+    /* Only parsed trees and their children keep source locations. */
+    if (value->type != _JULE_TREE && value->type != _JULE_TREE_LINE_LEADER) {
+        copy->loc = 0;
+    }
+
     switch (value->type) {
         case JULE_NIL:
             break;
         case JULE_NUMBER:
             break;
         case JULE_STRING:
+            if (!jule_string_is_inline(copy)) {
+                jule_string_retain(copy->string);
+            }
             break;
         case JULE_SYMBOL:
             break;
@@ -1656,6 +2670,12 @@ static Jule_Value *_jule_copy(Jule_Value *value, int force) {
                 hash_table_insert((_Jule_Object)copy->object, _jule_copy(key, force), _jule_copy(*val, force));
             }
             break;
+        case JULE_BUILDER:
+            copy->builder = jule_builder_dup(value->builder);
+            break;
+        case JULE_HANDLE:
+            copy->handle->refs += 1;
+            break;
         case _JULE_REF:
             copy = _jule_copy(value->ref_of, force);
             break;
@@ -1664,7 +2684,13 @@ static Jule_Value *_jule_copy(Jule_Value *value, int force) {
         case _JULE_FN:
         case _JULE_LAMBDA:
             FOR_EACH(copy->eval_values, child) {
-                array = jule_push(array, _jule_copy(child, force));
+                if (child->in_arena) {
+                    cpy = child;
+                } else {
+                    cpy      = _jule_copy(child, force);
+                    cpy->loc = child->loc;
+                }
+                array = jule_push(array, cpy);
             }
             copy->eval_values = array;
             if (value->type == _JULE_LAMBDA) {
@@ -1720,7 +2746,7 @@ static int jule_equal(Jule_Value *a, Jule_Value *b) {
         case JULE_NUMBER:
             return a->number == b->number;
         case JULE_STRING:
-            return a->string_id == b->string_id;
+            return jule_string_value_equ(a, b);
         case JULE_SYMBOL:
             return a->symbol_id == b->symbol_id;
         case JULE_LIST:
@@ -1731,6 +2757,11 @@ static int jule_equal(Jule_Value *a, Jule_Value *b) {
                 if (!jule_equal(ia, ib)) { return 0; }
             }
             return 1;
+        case JULE_BUILDER:
+            return a->builder->len == b->builder->len
+                && memcmp(a->builder->chars, b->builder->chars, a->builder->len) == 0;
+        case JULE_HANDLE:
+            return a->handle == b->handle;
         default:
             /* @todo: all types should be covered here */
             JULE_ASSERT(0);
@@ -1740,7 +2771,180 @@ static int jule_equal(Jule_Value *a, Jule_Value *b) {
     return 0;
 }
 
+static Jule_Line_Table *jule_line_table(void) {
+    Jule_Line_Table *table;
+
+    table          = JULE_MALLOC(sizeof(*table));
+    table->n_lines = 0;
+    table->cap     = 64;
+    table->starts  = JULE_MALLOC(sizeof(*table->starts) * table->cap);
+
+    return table;
+}
+
+static void jule_free_line_table(Jule_Line_Table *table) {
+    JULE_FREE(table->starts);
+    JULE_FREE(table);
+}
+
+static inline void jule_line_table_push(Jule_Line_Table *table, unsigned offset) {
+    if (table->n_lines == table->cap) {
+        table->cap    <<= 1;
+        table->starts   = JULE_REALLOC(table->starts, sizeof(*table->starts) * table->cap);
+    }
+
+    table->starts[table->n_lines]  = offset;
+    table->n_lines                += 1;
+}
+
+/* Removes the table of file, if there is one, and gives it to the caller. */
+static Jule_Line_Table *jule_take_line_table(Jule_Interp *interp, Jule_String_ID file) {
+    Jule_Line_Table_Ptr *lookup;
+    Jule_Line_Table     *table;
+
+    lookup = hash_table_get_val(interp->line_tables, file);
+    if (lookup == NULL) { return NULL; }
+
+    table = *lookup;
+    hash_table_delete(interp->line_tables, file);
+
+    return table;
+}
+
+/* Nodes of a replaced version of a module are located with the line table
+ * that was current when they were parsed. Returns the arena of that version
+ * if ptr is in it, with *table set to its line table (which may be NULL). */
+static Jule_Arena *jule_old_arena(Jule_Interp *interp, const void *ptr, Jule_Line_Table **table) {
+    Jule_String_ID   key;
+    Jule_Module_Ptr *mod;
+    unsigned         i;
+
+    hash_table_traverse(interp->modules, key, mod) {
+        (void)key;
+        for (i = 0; i < jule_len((*mod)->old_arenas); i += 1) {
+            if (jule_arena_holds(jule_elem((*mod)->old_arenas, i), ptr)) {
+                *table = jule_elem((*mod)->old_lines, i);
+                return jule_elem((*mod)->old_arenas, i);
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/* Takes ownership of table. A file that is parsed again replaces its table. */
+static void jule_set_line_table(Jule_Interp *interp, Jule_String_ID file, Jule_Line_Table *table) {
+    Jule_Line_Table_Ptr *lookup;
+
+    lookup = hash_table_get_val(interp->line_tables, file);
+
+    if (lookup != NULL) {
+        jule_free_line_table(*lookup);
+        *lookup = table;
+    } else {
+        hash_table_insert(interp->line_tables, file, table);
+    }
+}
+
+Jule_Parse_Location jule_value_location(Jule_Interp *interp, Jule_String_ID file, const Jule_Value *value) {
+    Jule_Parse_Location  location;
+    Jule_Line_Table_Ptr *lookup;
+    Jule_Line_Table     *table;
+    unsigned             offset;
+    unsigned             lo;
+    unsigned             hi;
+    unsigned             mid;
+
+    location.line = 0;
+    location.col  = 0;
+
+    if (value == NULL || value->loc == 0) { goto out; }
+
+    if (jule_old_arena(interp, value, &table) == NULL) {
+        lookup = hash_table_get_val(interp->line_tables, file);
+        table  = lookup == NULL ? NULL : *lookup;
+    }
+    if (table == NULL || table->n_lines == 0) { goto out; }
+
+    offset = value->loc - 1;
+
+    /* Find the last line that starts at or before offset. */
+    lo = 0;
+    hi = table->n_lines;
+    while (hi - lo > 1) {
+        mid = lo + ((hi - lo) >> 1);
+        if (table->starts[mid] <= offset) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+
+    location.line = lo + 1;
+    location.col  = offset - table->starts[lo] + 1;
+
+out:;
+    return location;
+}
+
+/* The file that a parsed tree came from. Anything else is taken to be from
+ * the current file. */
+static Jule_String_ID jule_tree_file(Jule_Interp *interp, const Jule_Value *tree) {
+    if ((tree->type == _JULE_TREE || tree->type == _JULE_TREE_LINE_LEADER)
+    &&  tree->eval_values != NULL
+    &&  tree->eval_values->aux != NULL) {
+        return tree->eval_values->aux;
+    }
+
+    return interp->cur_file;
+}
+
+/* Is value an element of tree (or of the expression that leads its line)? */
+static int jule_tree_holds(const Jule_Value *tree, const Jule_Value *value) {
+    Jule_Value *it;
+
+    FOR_EACH(tree->eval_values, it) {
+        if (it == value) { return 1; }
+        if (tree->type == _JULE_TREE_LINE_LEADER && it->type == _JULE_TREE && jule_tree_holds(it, value)) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/* Trees know their file, but other values only have an offset. An offset is
+ * only resolved in the file of the innermost call when the value belongs to
+ * that call's tree. Otherwise (values from another file that have been
+ * passed around, or that were never parsed) the error is reported at the
+ * innermost call site. */
+static Jule_Parse_Location jule_error_location(Jule_Interp *interp, const Jule_Value *value, Jule_String_ID *file) {
+    Jule_Backtrace_Entry *bt;
+
+    if (value->type == _JULE_TREE || value->type == _JULE_TREE_LINE_LEADER) {
+        *file = jule_tree_file(interp, value);
+        return jule_value_location(interp, *file, value);
+    }
+
+    bt = jule_top(interp->backtrace);
+
+    if (bt == NULL) {
+        *file = interp->cur_file;
+        return jule_value_location(interp, *file, value);
+    }
+
+    *file = jule_tree_file(interp, bt->tree);
+
+    if (value->loc != 0 && jule_tree_holds(bt->tree, value)) {
+        return jule_value_location(interp, *file, value);
+    }
+
+    return jule_value_location(interp, *file, bt->tree);
+}
+
 static void jule_error(Jule_Interp *interp, Jule_Error_Info *info) {
+    jule_flush_output(interp);
+
     if (interp->error_callback != NULL) {
         interp->error_callback(info);
     } else {
@@ -1761,35 +2965,35 @@ static void jule_make_parse_error(Jule_Interp *interp, int line, int col, Jule_S
 
 static void jule_make_interp_error(Jule_Interp *interp, Jule_Value *value, Jule_Status status) {
     Jule_Error_Info info;
+    Jule_String_ID  file;
     memset(&info, 0, sizeof(info));
     info.interp        = interp;
     info.status        = status;
-    info.location.line = value->line;
-    info.location.col  = value->col;
-    if (interp->cur_file != NULL) { info.file = jule_charptr_dup(jule_get_string(interp, interp->cur_file)->chars); }
+    info.location      = jule_error_location(interp, value, &file);
+    if (file != NULL) { info.file = jule_charptr_dup(jule_get_string(interp, file)->chars); }
     jule_error(interp, &info);
 }
 
 static void jule_make_lookup_error(Jule_Interp *interp, Jule_Value *value, Jule_String_ID id) {
     Jule_Error_Info info;
+    Jule_String_ID  file;
     memset(&info, 0, sizeof(info));
     info.interp        = interp;
     info.status        = JULE_ERR_LOOKUP;
-    info.location.line = value->line;
-    info.location.col  = value->col;
-    if (interp->cur_file != NULL) { info.file = jule_charptr_dup(jule_get_string(interp, interp->cur_file)->chars); }
+    info.location      = jule_error_location(interp, value, &file);
+    if (file != NULL) { info.file = jule_charptr_dup(jule_get_string(interp, file)->chars); }
     info.sym           = jule_charptr_dup(jule_get_string(interp, id)->chars);
     jule_error(interp, &info);
 }
 
 static void jule_make_arity_error(Jule_Interp *interp, Jule_Value *value, int wanted, int got, int at_least) {
     Jule_Error_Info info;
+    Jule_String_ID  file;
     memset(&info, 0, sizeof(info));
     info.interp         = interp;
     info.status         = JULE_ERR_ARITY;
-    info.location.line  = value->line;
-    info.location.col   = value->col;
-    if (interp->cur_file != NULL) { info.file = jule_charptr_dup(jule_get_string(interp, interp->cur_file)->chars); }
+    info.location       = jule_error_location(interp, value, &file);
+    if (file != NULL) { info.file = jule_charptr_dup(jule_get_string(interp, file)->chars); }
     info.wanted_arity   = wanted;
     info.got_arity      = got;
     info.arity_at_least = at_least;
@@ -1798,12 +3002,12 @@ static void jule_make_arity_error(Jule_Interp *interp, Jule_Value *value, int wa
 
 static void jule_make_type_error(Jule_Interp *interp, Jule_Value *value, Jule_Type wanted, Jule_Type got) {
     Jule_Error_Info info;
+    Jule_String_ID  file;
     memset(&info, 0, sizeof(info));
     info.interp        = interp;
     info.status        = JULE_ERR_TYPE;
-    info.location.line = value->line;
-    info.location.col  = value->col;
-    if (interp->cur_file != NULL) { info.file = jule_charptr_dup(jule_get_string(interp, interp->cur_file)->chars); }
+    info.location      = jule_error_location(interp, value, &file);
+    if (file != NULL) { info.file = jule_charptr_dup(jule_get_string(interp, file)->chars); }
     info.wanted_type   = wanted;
     info.got_type      = got;
     jule_error(interp, &info);
@@ -1811,72 +3015,85 @@ static void jule_make_type_error(Jule_Interp *interp, Jule_Value *value, Jule_Ty
 
 static void jule_make_object_key_type_error(Jule_Interp *interp, Jule_Value *value, Jule_Type got) {
     Jule_Error_Info info;
+    Jule_String_ID  file;
     memset(&info, 0, sizeof(info));
     info.interp        = interp;
     info.status        = JULE_ERR_OBJECT_KEY_TYPE;
-    info.location.line = value->line;
-    info.location.col  = value->col;
-    if (interp->cur_file != NULL) { info.file = jule_charptr_dup(jule_get_string(interp, interp->cur_file)->chars); }
+    info.location      = jule_error_location(interp, value, &file);
+    if (file != NULL) { info.file = jule_charptr_dup(jule_get_string(interp, file)->chars); }
     info.got_type      = got;
     jule_error(interp, &info);
 }
 
 static void jule_make_bad_invoke_error(Jule_Interp *interp, Jule_Value *value, Jule_Type got) {
     Jule_Error_Info info;
+    Jule_String_ID  file;
     memset(&info, 0, sizeof(info));
     info.interp        = interp;
     info.status        = JULE_ERR_BAD_INVOKE;
-    info.location.line = value->line;
-    info.location.col  = value->col;
-    if (interp->cur_file != NULL) { info.file = jule_charptr_dup(jule_get_string(interp, interp->cur_file)->chars); }
+    info.location      = jule_error_location(interp, value, &file);
+    if (file != NULL) { info.file = jule_charptr_dup(jule_get_string(interp, file)->chars); }
     info.got_type      = got;
     jule_error(interp, &info);
 }
 
 static void jule_make_bad_index_error(Jule_Interp *interp, Jule_Value *value, Jule_Value *bad_index) {
     Jule_Error_Info info;
+    Jule_String_ID  file;
     memset(&info, 0, sizeof(info));
     info.interp        = interp;
     info.status        = JULE_ERR_BAD_INDEX;
-    info.location.line = value->line;
-    info.location.col  = value->col;
-    if (interp->cur_file != NULL) { info.file = jule_charptr_dup(jule_get_string(interp, interp->cur_file)->chars); }
+    info.location      = jule_error_location(interp, value, &file);
+    if (file != NULL) { info.file = jule_charptr_dup(jule_get_string(interp, file)->chars); }
     info.bad_index     = bad_index;
     jule_error(interp, &info);
 }
 
+/* For packages: an argument has the right type, but not a usable value. */
+static inline void jule_make_bad_value_error(Jule_Interp *interp, Jule_Value *value, Jule_Value *bad_value) {
+    Jule_Error_Info info;
+    Jule_String_ID  file;
+    memset(&info, 0, sizeof(info));
+    info.interp        = interp;
+    info.status        = JULE_ERR_BAD_VALUE;
+    info.location      = jule_error_location(interp, value, &file);
+    if (file != NULL) { info.file = jule_charptr_dup(jule_get_string(interp, file)->chars); }
+    info.bad_value     = bad_value;
+    jule_error(interp, &info);
+}
+
 static void jule_make_file_error(Jule_Interp *interp, Jule_Value *value, Jule_Status status, const char *path) {
     Jule_Error_Info info;
+    Jule_String_ID  file;
     memset(&info, 0, sizeof(info));
     info.interp        = interp;
     info.status        = status;
-    info.location.line = value->line;
-    info.location.col  = value->col;
-    if (interp->cur_file != NULL) { info.file = jule_charptr_dup(jule_get_string(interp, interp->cur_file)->chars); }
+    info.location      = jule_error_location(interp, value, &file);
+    if (file != NULL) { info.file = jule_charptr_dup(jule_get_string(interp, file)->chars); }
     info.path          = jule_charptr_dup(path);
     jule_error(interp, &info);
 }
 
 static void jule_make_install_error(Jule_Interp *interp, Jule_Value *value, Jule_Status status, Jule_String_ID id) {
     Jule_Error_Info info;
+    Jule_String_ID  file;
     memset(&info, 0, sizeof(info));
     info.interp        = interp;
     info.status        = status;
-    info.location.line = value->line;
-    info.location.col  = value->col;
-    if (interp->cur_file != NULL) { info.file = jule_charptr_dup(jule_get_string(interp, interp->cur_file)->chars); }
+    info.location      = jule_error_location(interp, value, &file);
+    if (file != NULL) { info.file = jule_charptr_dup(jule_get_string(interp, file)->chars); }
     info.sym           = id == NULL ? NULL : jule_charptr_dup(jule_get_string(interp, id)->chars);
     jule_error(interp, &info);
 }
 
 static void jule_make_load_package_error(Jule_Interp *interp, Jule_Value *value, Jule_Status status, const char *path, const char *message) {
     Jule_Error_Info info;
+    Jule_String_ID  file;
     memset(&info, 0, sizeof(info));
     info.interp                = interp;
     info.status                = status;
-    info.location.line         = value->line;
-    info.location.col          = value->col;
-    if (interp->cur_file != NULL) { info.file = jule_charptr_dup(jule_get_string(interp, interp->cur_file)->chars); }
+    info.location              = jule_error_location(interp, value, &file);
+    if (file != NULL) { info.file = jule_charptr_dup(jule_get_string(interp, file)->chars); }
     info.path                  = jule_charptr_dup(path);
     info.package_error_message = message == NULL ? "unknown error" : jule_charptr_dup(message);
     jule_error(interp, &info);
@@ -1884,23 +3101,23 @@ static void jule_make_load_package_error(Jule_Interp *interp, Jule_Value *value,
 
 static void jule_make_forbidden_error(Jule_Interp *interp, Jule_Value *value, Jule_Status status) {
     Jule_Error_Info info;
+    Jule_String_ID  file;
     memset(&info, 0, sizeof(info));
     info.interp                = interp;
     info.status                = status;
-    info.location.line         = value->line;
-    info.location.col          = value->col;
-    if (interp->cur_file != NULL) { info.file = jule_charptr_dup(jule_get_string(interp, interp->cur_file)->chars); }
+    info.location              = jule_error_location(interp, value, &file);
+    if (file != NULL) { info.file = jule_charptr_dup(jule_get_string(interp, file)->chars); }
     jule_error(interp, &info);
 }
 
 static void jule_make_must_follow_if_error(Jule_Interp *interp, Jule_Value *value) {
     Jule_Error_Info info;
+    Jule_String_ID  file;
     memset(&info, 0, sizeof(info));
     info.interp                = interp;
     info.status                = JULE_ERR_MUST_FOLLOW_IF;
-    info.location.line         = value->line;
-    info.location.col          = value->col;
-    if (interp->cur_file != NULL) { info.file = jule_charptr_dup(jule_get_string(interp, interp->cur_file)->chars); }
+    info.location              = jule_error_location(interp, value, &file);
+    if (file != NULL) { info.file = jule_charptr_dup(jule_get_string(interp, file)->chars); }
     jule_error(interp, &info);
 }
 
@@ -1912,12 +3129,12 @@ do {                                           \
     return (_status);                          \
 } while (0)
 
-#define PARSE_ERR_RET(_interp, _status, _line, _col)                  \
-do {                                                                  \
-    if ((_status) != JULE_SUCCESS) {                                  \
-        jule_make_parse_error((_interp), (_line), (_col), (_status)); \
-    }                                                                 \
-    return (_status);                                                 \
+#define PARSE_ERR_RET(_cxt, _status, _line, _col)                           \
+do {                                                                        \
+    if ((_status) != JULE_SUCCESS && !(_cxt)->quiet) {                      \
+        jule_make_parse_error((_cxt)->interp, (_line), (_col), (_status));  \
+    }                                                                       \
+    return (_status);                                                       \
 } while (0)
 
 static inline int jule_is_space(int c) {
@@ -1953,9 +3170,1097 @@ typedef enum {
 #define SPC(_c)             (jule_is_space(_c))
 #define DIG(_c)             (jule_is_digit(_c))
 
+/*
+ * Number parsing
+ *
+ * jule_parse_number() reads [-+]digits[.digits][(e|E)[-+]digits] and never
+ * looks past len. Up to 19 significant digits are collected into a 64-bit
+ * mantissa. Values whose mantissa and power of ten are both exactly
+ * representable are converted with a single multiply or divide (Clinger's
+ * fast path). Everything else goes through the Eisel-Lemire algorithm with
+ * the truncated 128-bit powers of ten below, and the rare inputs that it
+ * can't decide (more than 19 digits, halfway cases, out of range) fall back
+ * to strtod().
+ */
+
+static const unsigned long long jule_pow10_128[][2] = {
+    { 0x1732C869CD60E453ULL, 0xFA8FD5A0081C0288ULL }, /* 1e-348 */
+    { 0x0E7FBD42205C8EB4ULL, 0x9C99E58405118195ULL }, /* 1e-347 */
+    { 0x521FAC92A873B261ULL, 0xC3C05EE50655E1FAULL }, /* 1e-346 */
+    { 0xE6A797B752909EF9ULL, 0xF4B0769E47EB5A78ULL }, /* 1e-345 */
+    { 0x9028BED2939A635CULL, 0x98EE4A22ECF3188BULL }, /* 1e-344 */
+    { 0x7432EE873880FC33ULL, 0xBF29DCABA82FDEAEULL }, /* 1e-343 */
+    { 0x113FAA2906A13B3FULL, 0xEEF453D6923BD65AULL }, /* 1e-342 */
+    { 0x4AC7CA59A424C507ULL, 0x9558B4661B6565F8ULL }, /* 1e-341 */
+    { 0x5D79BCF00D2DF649ULL, 0xBAAEE17FA23EBF76ULL }, /* 1e-340 */
+    { 0xF4D82C2C107973DCULL, 0xE95A99DF8ACE6F53ULL }, /* 1e-339 */
+    { 0x79071B9B8A4BE869ULL, 0x91D8A02BB6C10594ULL }, /* 1e-338 */
+    { 0x9748E2826CDEE284ULL, 0xB64EC836A47146F9ULL }, /* 1e-337 */
+    { 0xFD1B1B2308169B25ULL, 0xE3E27A444D8D98B7ULL }, /* 1e-336 */
+    { 0xFE30F0F5E50E20F7ULL, 0x8E6D8C6AB0787F72ULL }, /* 1e-335 */
+    { 0xBDBD2D335E51A935ULL, 0xB208EF855C969F4FULL }, /* 1e-334 */
+    { 0xAD2C788035E61382ULL, 0xDE8B2B66B3BC4723ULL }, /* 1e-333 */
+    { 0x4C3BCB5021AFCC31ULL, 0x8B16FB203055AC76ULL }, /* 1e-332 */
+    { 0xDF4ABE242A1BBF3DULL, 0xADDCB9E83C6B1793ULL }, /* 1e-331 */
+    { 0xD71D6DAD34A2AF0DULL, 0xD953E8624B85DD78ULL }, /* 1e-330 */
+    { 0x8672648C40E5AD68ULL, 0x87D4713D6F33AA6BULL }, /* 1e-329 */
+    { 0x680EFDAF511F18C2ULL, 0xA9C98D8CCB009506ULL }, /* 1e-328 */
+    { 0x0212BD1B2566DEF2ULL, 0xD43BF0EFFDC0BA48ULL }, /* 1e-327 */
+    { 0x014BB630F7604B57ULL, 0x84A57695FE98746DULL }, /* 1e-326 */
+    { 0x419EA3BD35385E2DULL, 0xA5CED43B7E3E9188ULL }, /* 1e-325 */
+    { 0x52064CAC828675B9ULL, 0xCF42894A5DCE35EAULL }, /* 1e-324 */
+    { 0x7343EFEBD1940993ULL, 0x818995CE7AA0E1B2ULL }, /* 1e-323 */
+    { 0x1014EBE6C5F90BF8ULL, 0xA1EBFB4219491A1FULL }, /* 1e-322 */
+    { 0xD41A26E077774EF6ULL, 0xCA66FA129F9B60A6ULL }, /* 1e-321 */
+    { 0x8920B098955522B4ULL, 0xFD00B897478238D0ULL }, /* 1e-320 */
+    { 0x55B46E5F5D5535B0ULL, 0x9E20735E8CB16382ULL }, /* 1e-319 */
+    { 0xEB2189F734AA831DULL, 0xC5A890362FDDBC62ULL }, /* 1e-318 */
+    { 0xA5E9EC7501D523E4ULL, 0xF712B443BBD52B7BULL }, /* 1e-317 */
+    { 0x47B233C92125366EULL, 0x9A6BB0AA55653B2DULL }, /* 1e-316 */
+    { 0x999EC0BB696E840AULL, 0xC1069CD4EABE89F8ULL }, /* 1e-315 */
+    { 0xC00670EA43CA250DULL, 0xF148440A256E2C76ULL }, /* 1e-314 */
+    { 0x380406926A5E5728ULL, 0x96CD2A865764DBCAULL }, /* 1e-313 */
+    { 0xC605083704F5ECF2ULL, 0xBC807527ED3E12BCULL }, /* 1e-312 */
+    { 0xF7864A44C633682EULL, 0xEBA09271E88D976BULL }, /* 1e-311 */
+    { 0x7AB3EE6AFBE0211DULL, 0x93445B8731587EA3ULL }, /* 1e-310 */
+    { 0x5960EA05BAD82964ULL, 0xB8157268FDAE9E4CULL }, /* 1e-309 */
+    { 0x6FB92487298E33BDULL, 0xE61ACF033D1A45DFULL }, /* 1e-308 */
+    { 0xA5D3B6D479F8E056ULL, 0x8FD0C16206306BABULL }, /* 1e-307 */
+    { 0x8F48A4899877186CULL, 0xB3C4F1BA87BC8696ULL }, /* 1e-306 */
+    { 0x331ACDABFE94DE87ULL, 0xE0B62E2929ABA83CULL }, /* 1e-305 */
+    { 0x9FF0C08B7F1D0B14ULL, 0x8C71DCD9BA0B4925ULL }, /* 1e-304 */
+    { 0x07ECF0AE5EE44DD9ULL, 0xAF8E5410288E1B6FULL }, /* 1e-303 */
+    { 0xC9E82CD9F69D6150ULL, 0xDB71E91432B1A24AULL }, /* 1e-302 */
+    { 0xBE311C083A225CD2ULL, 0x892731AC9FAF056EULL }, /* 1e-301 */
+    { 0x6DBD630A48AAF406ULL, 0xAB70FE17C79AC6CAULL }, /* 1e-300 */
+    { 0x092CBBCCDAD5B108ULL, 0xD64D3D9DB981787DULL }, /* 1e-299 */
+    { 0x25BBF56008C58EA5ULL, 0x85F0468293F0EB4EULL }, /* 1e-298 */
+    { 0xAF2AF2B80AF6F24EULL, 0xA76C582338ED2621ULL }, /* 1e-297 */
+    { 0x1AF5AF660DB4AEE1ULL, 0xD1476E2C07286FAAULL }, /* 1e-296 */
+    { 0x50D98D9FC890ED4DULL, 0x82CCA4DB847945CAULL }, /* 1e-295 */
+    { 0xE50FF107BAB528A0ULL, 0xA37FCE126597973CULL }, /* 1e-294 */
+    { 0x1E53ED49A96272C8ULL, 0xCC5FC196FEFD7D0CULL }, /* 1e-293 */
+    { 0x25E8E89C13BB0F7AULL, 0xFF77B1FCBEBCDC4FULL }, /* 1e-292 */
+    { 0x77B191618C54E9ACULL, 0x9FAACF3DF73609B1ULL }, /* 1e-291 */
+    { 0xD59DF5B9EF6A2417ULL, 0xC795830D75038C1DULL }, /* 1e-290 */
+    { 0x4B0573286B44AD1DULL, 0xF97AE3D0D2446F25ULL }, /* 1e-289 */
+    { 0x4EE367F9430AEC32ULL, 0x9BECCE62836AC577ULL }, /* 1e-288 */
+    { 0x229C41F793CDA73FULL, 0xC2E801FB244576D5ULL }, /* 1e-287 */
+    { 0x6B43527578C1110FULL, 0xF3A20279ED56D48AULL }, /* 1e-286 */
+    { 0x830A13896B78AAA9ULL, 0x9845418C345644D6ULL }, /* 1e-285 */
+    { 0x23CC986BC656D553ULL, 0xBE5691EF416BD60CULL }, /* 1e-284 */
+    { 0x2CBFBE86B7EC8AA8ULL, 0xEDEC366B11C6CB8FULL }, /* 1e-283 */
+    { 0x7BF7D71432F3D6A9ULL, 0x94B3A202EB1C3F39ULL }, /* 1e-282 */
+    { 0xDAF5CCD93FB0CC53ULL, 0xB9E08A83A5E34F07ULL }, /* 1e-281 */
+    { 0xD1B3400F8F9CFF68ULL, 0xE858AD248F5C22C9ULL }, /* 1e-280 */
+    { 0x23100809B9C21FA1ULL, 0x91376C36D99995BEULL }, /* 1e-279 */
+    { 0xABD40A0C2832A78AULL, 0xB58547448FFFFB2DULL }, /* 1e-278 */
+    { 0x16C90C8F323F516CULL, 0xE2E69915B3FFF9F9ULL }, /* 1e-277 */
+    { 0xAE3DA7D97F6792E3ULL, 0x8DD01FAD907FFC3BULL }, /* 1e-276 */
+    { 0x99CD11CFDF41779CULL, 0xB1442798F49FFB4AULL }, /* 1e-275 */
+    { 0x40405643D711D583ULL, 0xDD95317F31C7FA1DULL }, /* 1e-274 */
+    { 0x482835EA666B2572ULL, 0x8A7D3EEF7F1CFC52ULL }, /* 1e-273 */
+    { 0xDA3243650005EECFULL, 0xAD1C8EAB5EE43B66ULL }, /* 1e-272 */
+    { 0x90BED43E40076A82ULL, 0xD863B256369D4A40ULL }, /* 1e-271 */
+    { 0x5A7744A6E804A291ULL, 0x873E4F75E2224E68ULL }, /* 1e-270 */
+    { 0x711515D0A205CB36ULL, 0xA90DE3535AAAE202ULL }, /* 1e-269 */
+    { 0x0D5A5B44CA873E03ULL, 0xD3515C2831559A83ULL }, /* 1e-268 */
+    { 0xE858790AFE9486C2ULL, 0x8412D9991ED58091ULL }, /* 1e-267 */
+    { 0x626E974DBE39A872ULL, 0xA5178FFF668AE0B6ULL }, /* 1e-266 */
+    { 0xFB0A3D212DC8128FULL, 0xCE5D73FF402D98E3ULL }, /* 1e-265 */
+    { 0x7CE66634BC9D0B99ULL, 0x80FA687F881C7F8EULL }, /* 1e-264 */
+    { 0x1C1FFFC1EBC44E80ULL, 0xA139029F6A239F72ULL }, /* 1e-263 */
+    { 0xA327FFB266B56220ULL, 0xC987434744AC874EULL }, /* 1e-262 */
+    { 0x4BF1FF9F0062BAA8ULL, 0xFBE9141915D7A922ULL }, /* 1e-261 */
+    { 0x6F773FC3603DB4A9ULL, 0x9D71AC8FADA6C9B5ULL }, /* 1e-260 */
+    { 0xCB550FB4384D21D3ULL, 0xC4CE17B399107C22ULL }, /* 1e-259 */
+    { 0x7E2A53A146606A48ULL, 0xF6019DA07F549B2BULL }, /* 1e-258 */
+    { 0x2EDA7444CBFC426DULL, 0x99C102844F94E0FBULL }, /* 1e-257 */
+    { 0xFA911155FEFB5308ULL, 0xC0314325637A1939ULL }, /* 1e-256 */
+    { 0x793555AB7EBA27CAULL, 0xF03D93EEBC589F88ULL }, /* 1e-255 */
+    { 0x4BC1558B2F3458DEULL, 0x96267C7535B763B5ULL }, /* 1e-254 */
+    { 0x9EB1AAEDFB016F16ULL, 0xBBB01B9283253CA2ULL }, /* 1e-253 */
+    { 0x465E15A979C1CADCULL, 0xEA9C227723EE8BCBULL }, /* 1e-252 */
+    { 0x0BFACD89EC191EC9ULL, 0x92A1958A7675175FULL }, /* 1e-251 */
+    { 0xCEF980EC671F667BULL, 0xB749FAED14125D36ULL }, /* 1e-250 */
+    { 0x82B7E12780E7401AULL, 0xE51C79A85916F484ULL }, /* 1e-249 */
+    { 0xD1B2ECB8B0908810ULL, 0x8F31CC0937AE58D2ULL }, /* 1e-248 */
+    { 0x861FA7E6DCB4AA15ULL, 0xB2FE3F0B8599EF07ULL }, /* 1e-247 */
+    { 0x67A791E093E1D49AULL, 0xDFBDCECE67006AC9ULL }, /* 1e-246 */
+    { 0xE0C8BB2C5C6D24E0ULL, 0x8BD6A141006042BDULL }, /* 1e-245 */
+    { 0x58FAE9F773886E18ULL, 0xAECC49914078536DULL }, /* 1e-244 */
+    { 0xAF39A475506A899EULL, 0xDA7F5BF590966848ULL }, /* 1e-243 */
+    { 0x6D8406C952429603ULL, 0x888F99797A5E012DULL }, /* 1e-242 */
+    { 0xC8E5087BA6D33B83ULL, 0xAAB37FD7D8F58178ULL }, /* 1e-241 */
+    { 0xFB1E4A9A90880A64ULL, 0xD5605FCDCF32E1D6ULL }, /* 1e-240 */
+    { 0x5CF2EEA09A55067FULL, 0x855C3BE0A17FCD26ULL }, /* 1e-239 */
+    { 0xF42FAA48C0EA481EULL, 0xA6B34AD8C9DFC06FULL }, /* 1e-238 */
+    { 0xF13B94DAF124DA26ULL, 0xD0601D8EFC57B08BULL }, /* 1e-237 */
+    { 0x76C53D08D6B70858ULL, 0x823C12795DB6CE57ULL }, /* 1e-236 */
+    { 0x54768C4B0C64CA6EULL, 0xA2CB1717B52481EDULL }, /* 1e-235 */
+    { 0xA9942F5DCF7DFD09ULL, 0xCB7DDCDDA26DA268ULL }, /* 1e-234 */
+    { 0xD3F93B35435D7C4CULL, 0xFE5D54150B090B02ULL }, /* 1e-233 */
+    { 0xC47BC5014A1A6DAFULL, 0x9EFA548D26E5A6E1ULL }, /* 1e-232 */
+    { 0x359AB6419CA1091BULL, 0xC6B8E9B0709F109AULL }, /* 1e-231 */
+    { 0xC30163D203C94B62ULL, 0xF867241C8CC6D4C0ULL }, /* 1e-230 */
+    { 0x79E0DE63425DCF1DULL, 0x9B407691D7FC44F8ULL }, /* 1e-229 */
+    { 0x985915FC12F542E4ULL, 0xC21094364DFB5636ULL }, /* 1e-228 */
+    { 0x3E6F5B7B17B2939DULL, 0xF294B943E17A2BC4ULL }, /* 1e-227 */
+    { 0xA705992CEECF9C42ULL, 0x979CF3CA6CEC5B5AULL }, /* 1e-226 */
+    { 0x50C6FF782A838353ULL, 0xBD8430BD08277231ULL }, /* 1e-225 */
+    { 0xA4F8BF5635246428ULL, 0xECE53CEC4A314EBDULL }, /* 1e-224 */
+    { 0x871B7795E136BE99ULL, 0x940F4613AE5ED136ULL }, /* 1e-223 */
+    { 0x28E2557B59846E3FULL, 0xB913179899F68584ULL }, /* 1e-222 */
+    { 0x331AEADA2FE589CFULL, 0xE757DD7EC07426E5ULL }, /* 1e-221 */
+    { 0x3FF0D2C85DEF7621ULL, 0x9096EA6F3848984FULL }, /* 1e-220 */
+    { 0x0FED077A756B53A9ULL, 0xB4BCA50B065ABE63ULL }, /* 1e-219 */
+    { 0xD3E8495912C62894ULL, 0xE1EBCE4DC7F16DFBULL }, /* 1e-218 */
+    { 0x64712DD7ABBBD95CULL, 0x8D3360F09CF6E4BDULL }, /* 1e-217 */
+    { 0xBD8D794D96AACFB3ULL, 0xB080392CC4349DECULL }, /* 1e-216 */
+    { 0xECF0D7A0FC5583A0ULL, 0xDCA04777F541C567ULL }, /* 1e-215 */
+    { 0xF41686C49DB57244ULL, 0x89E42CAAF9491B60ULL }, /* 1e-214 */
+    { 0x311C2875C522CED5ULL, 0xAC5D37D5B79B6239ULL }, /* 1e-213 */
+    { 0x7D633293366B828BULL, 0xD77485CB25823AC7ULL }, /* 1e-212 */
+    { 0xAE5DFF9C02033197ULL, 0x86A8D39EF77164BCULL }, /* 1e-211 */
+    { 0xD9F57F830283FDFCULL, 0xA8530886B54DBDEBULL }, /* 1e-210 */
+    { 0xD072DF63C324FD7BULL, 0xD267CAA862A12D66ULL }, /* 1e-209 */
+    { 0x4247CB9E59F71E6DULL, 0x8380DEA93DA4BC60ULL }, /* 1e-208 */
+    { 0x52D9BE85F074E608ULL, 0xA46116538D0DEB78ULL }, /* 1e-207 */
+    { 0x67902E276C921F8BULL, 0xCD795BE870516656ULL }, /* 1e-206 */
+    { 0x00BA1CD8A3DB53B6ULL, 0x806BD9714632DFF6ULL }, /* 1e-205 */
+    { 0x80E8A40ECCD228A4ULL, 0xA086CFCD97BF97F3ULL }, /* 1e-204 */
+    { 0x6122CD128006B2CDULL, 0xC8A883C0FDAF7DF0ULL }, /* 1e-203 */
+    { 0x796B805720085F81ULL, 0xFAD2A4B13D1B5D6CULL }, /* 1e-202 */
+    { 0xCBE3303674053BB0ULL, 0x9CC3A6EEC6311A63ULL }, /* 1e-201 */
+    { 0xBEDBFC4411068A9CULL, 0xC3F490AA77BD60FCULL }, /* 1e-200 */
+    { 0xEE92FB5515482D44ULL, 0xF4F1B4D515ACB93BULL }, /* 1e-199 */
+    { 0x751BDD152D4D1C4AULL, 0x991711052D8BF3C5ULL }, /* 1e-198 */
+    { 0xD262D45A78A0635DULL, 0xBF5CD54678EEF0B6ULL }, /* 1e-197 */
+    { 0x86FB897116C87C34ULL, 0xEF340A98172AACE4ULL }, /* 1e-196 */
+    { 0xD45D35E6AE3D4DA0ULL, 0x9580869F0E7AAC0EULL }, /* 1e-195 */
+    { 0x8974836059CCA109ULL, 0xBAE0A846D2195712ULL }, /* 1e-194 */
+    { 0x2BD1A438703FC94BULL, 0xE998D258869FACD7ULL }, /* 1e-193 */
+    { 0x7B6306A34627DDCFULL, 0x91FF83775423CC06ULL }, /* 1e-192 */
+    { 0x1A3BC84C17B1D542ULL, 0xB67F6455292CBF08ULL }, /* 1e-191 */
+    { 0x20CABA5F1D9E4A93ULL, 0xE41F3D6A7377EECAULL }, /* 1e-190 */
+    { 0x547EB47B7282EE9CULL, 0x8E938662882AF53EULL }, /* 1e-189 */
+    { 0xE99E619A4F23AA43ULL, 0xB23867FB2A35B28DULL }, /* 1e-188 */
+    { 0x6405FA00E2EC94D4ULL, 0xDEC681F9F4C31F31ULL }, /* 1e-187 */
+    { 0xDE83BC408DD3DD04ULL, 0x8B3C113C38F9F37EULL }, /* 1e-186 */
+    { 0x9624AB50B148D445ULL, 0xAE0B158B4738705EULL }, /* 1e-185 */
+    { 0x3BADD624DD9B0957ULL, 0xD98DDAEE19068C76ULL }, /* 1e-184 */
+    { 0xE54CA5D70A80E5D6ULL, 0x87F8A8D4CFA417C9ULL }, /* 1e-183 */
+    { 0x5E9FCF4CCD211F4CULL, 0xA9F6D30A038D1DBCULL }, /* 1e-182 */
+    { 0x7647C3200069671FULL, 0xD47487CC8470652BULL }, /* 1e-181 */
+    { 0x29ECD9F40041E073ULL, 0x84C8D4DFD2C63F3BULL }, /* 1e-180 */
+    { 0xF468107100525890ULL, 0xA5FB0A17C777CF09ULL }, /* 1e-179 */
+    { 0x7182148D4066EEB4ULL, 0xCF79CC9DB955C2CCULL }, /* 1e-178 */
+    { 0xC6F14CD848405530ULL, 0x81AC1FE293D599BFULL }, /* 1e-177 */
+    { 0xB8ADA00E5A506A7CULL, 0xA21727DB38CB002FULL }, /* 1e-176 */
+    { 0xA6D90811F0E4851CULL, 0xCA9CF1D206FDC03BULL }, /* 1e-175 */
+    { 0x908F4A166D1DA663ULL, 0xFD442E4688BD304AULL }, /* 1e-174 */
+    { 0x9A598E4E043287FEULL, 0x9E4A9CEC15763E2EULL }, /* 1e-173 */
+    { 0x40EFF1E1853F29FDULL, 0xC5DD44271AD3CDBAULL }, /* 1e-172 */
+    { 0xD12BEE59E68EF47CULL, 0xF7549530E188C128ULL }, /* 1e-171 */
+    { 0x82BB74F8301958CEULL, 0x9A94DD3E8CF578B9ULL }, /* 1e-170 */
+    { 0xE36A52363C1FAF01ULL, 0xC13A148E3032D6E7ULL }, /* 1e-169 */
+    { 0xDC44E6C3CB279AC1ULL, 0xF18899B1BC3F8CA1ULL }, /* 1e-168 */
+    { 0x29AB103A5EF8C0B9ULL, 0x96F5600F15A7B7E5ULL }, /* 1e-167 */
+    { 0x7415D448F6B6F0E7ULL, 0xBCB2B812DB11A5DEULL }, /* 1e-166 */
+    { 0x111B495B3464AD21ULL, 0xEBDF661791D60F56ULL }, /* 1e-165 */
+    { 0xCAB10DD900BEEC34ULL, 0x936B9FCEBB25C995ULL }, /* 1e-164 */
+    { 0x3D5D514F40EEA742ULL, 0xB84687C269EF3BFBULL }, /* 1e-163 */
+    { 0x0CB4A5A3112A5112ULL, 0xE65829B3046B0AFAULL }, /* 1e-162 */
+    { 0x47F0E785EABA72ABULL, 0x8FF71A0FE2C2E6DCULL }, /* 1e-161 */
+    { 0x59ED216765690F56ULL, 0xB3F4E093DB73A093ULL }, /* 1e-160 */
+    { 0x306869C13EC3532CULL, 0xE0F218B8D25088B8ULL }, /* 1e-159 */
+    { 0x1E414218C73A13FBULL, 0x8C974F7383725573ULL }, /* 1e-158 */
+    { 0xE5D1929EF90898FAULL, 0xAFBD2350644EEACFULL }, /* 1e-157 */
+    { 0xDF45F746B74ABF39ULL, 0xDBAC6C247D62A583ULL }, /* 1e-156 */
+    { 0x6B8BBA8C328EB783ULL, 0x894BC396CE5DA772ULL }, /* 1e-155 */
+    { 0x066EA92F3F326564ULL, 0xAB9EB47C81F5114FULL }, /* 1e-154 */
+    { 0xC80A537B0EFEFEBDULL, 0xD686619BA27255A2ULL }, /* 1e-153 */
+    { 0xBD06742CE95F5F36ULL, 0x8613FD0145877585ULL }, /* 1e-152 */
+    { 0x2C48113823B73704ULL, 0xA798FC4196E952E7ULL }, /* 1e-151 */
+    { 0xF75A15862CA504C5ULL, 0xD17F3B51FCA3A7A0ULL }, /* 1e-150 */
+    { 0x9A984D73DBE722FBULL, 0x82EF85133DE648C4ULL }, /* 1e-149 */
+    { 0xC13E60D0D2E0EBBAULL, 0xA3AB66580D5FDAF5ULL }, /* 1e-148 */
+    { 0x318DF905079926A8ULL, 0xCC963FEE10B7D1B3ULL }, /* 1e-147 */
+    { 0xFDF17746497F7052ULL, 0xFFBBCFE994E5C61FULL }, /* 1e-146 */
+    { 0xFEB6EA8BEDEFA633ULL, 0x9FD561F1FD0F9BD3ULL }, /* 1e-145 */
+    { 0xFE64A52EE96B8FC0ULL, 0xC7CABA6E7C5382C8ULL }, /* 1e-144 */
+    { 0x3DFDCE7AA3C673B0ULL, 0xF9BD690A1B68637BULL }, /* 1e-143 */
+    { 0x06BEA10CA65C084EULL, 0x9C1661A651213E2DULL }, /* 1e-142 */
+    { 0x486E494FCFF30A62ULL, 0xC31BFA0FE5698DB8ULL }, /* 1e-141 */
+    { 0x5A89DBA3C3EFCCFAULL, 0xF3E2F893DEC3F126ULL }, /* 1e-140 */
+    { 0xF89629465A75E01CULL, 0x986DDB5C6B3A76B7ULL }, /* 1e-139 */
+    { 0xF6BBB397F1135823ULL, 0xBE89523386091465ULL }, /* 1e-138 */
+    { 0x746AA07DED582E2CULL, 0xEE2BA6C0678B597FULL }, /* 1e-137 */
+    { 0xA8C2A44EB4571CDCULL, 0x94DB483840B717EFULL }, /* 1e-136 */
+    { 0x92F34D62616CE413ULL, 0xBA121A4650E4DDEBULL }, /* 1e-135 */
+    { 0x77B020BAF9C81D17ULL, 0xE896A0D7E51E1566ULL }, /* 1e-134 */
+    { 0x0ACE1474DC1D122EULL, 0x915E2486EF32CD60ULL }, /* 1e-133 */
+    { 0x0D819992132456BAULL, 0xB5B5ADA8AAFF80B8ULL }, /* 1e-132 */
+    { 0x10E1FFF697ED6C69ULL, 0xE3231912D5BF60E6ULL }, /* 1e-131 */
+    { 0xCA8D3FFA1EF463C1ULL, 0x8DF5EFABC5979C8FULL }, /* 1e-130 */
+    { 0xBD308FF8A6B17CB2ULL, 0xB1736B96B6FD83B3ULL }, /* 1e-129 */
+    { 0xAC7CB3F6D05DDBDEULL, 0xDDD0467C64BCE4A0ULL }, /* 1e-128 */
+    { 0x6BCDF07A423AA96BULL, 0x8AA22C0DBEF60EE4ULL }, /* 1e-127 */
+    { 0x86C16C98D2C953C6ULL, 0xAD4AB7112EB3929DULL }, /* 1e-126 */
+    { 0xE871C7BF077BA8B7ULL, 0xD89D64D57A607744ULL }, /* 1e-125 */
+    { 0x11471CD764AD4972ULL, 0x87625F056C7C4A8BULL }, /* 1e-124 */
+    { 0xD598E40D3DD89BCFULL, 0xA93AF6C6C79B5D2DULL }, /* 1e-123 */
+    { 0x4AFF1D108D4EC2C3ULL, 0xD389B47879823479ULL }, /* 1e-122 */
+    { 0xCEDF722A585139BAULL, 0x843610CB4BF160CBULL }, /* 1e-121 */
+    { 0xC2974EB4EE658828ULL, 0xA54394FE1EEDB8FEULL }, /* 1e-120 */
+    { 0x733D226229FEEA32ULL, 0xCE947A3DA6A9273EULL }, /* 1e-119 */
+    { 0x0806357D5A3F525FULL, 0x811CCC668829B887ULL }, /* 1e-118 */
+    { 0xCA07C2DCB0CF26F7ULL, 0xA163FF802A3426A8ULL }, /* 1e-117 */
+    { 0xFC89B393DD02F0B5ULL, 0xC9BCFF6034C13052ULL }, /* 1e-116 */
+    { 0xBBAC2078D443ACE2ULL, 0xFC2C3F3841F17C67ULL }, /* 1e-115 */
+    { 0xD54B944B84AA4C0DULL, 0x9D9BA7832936EDC0ULL }, /* 1e-114 */
+    { 0x0A9E795E65D4DF11ULL, 0xC5029163F384A931ULL }, /* 1e-113 */
+    { 0x4D4617B5FF4A16D5ULL, 0xF64335BCF065D37DULL }, /* 1e-112 */
+    { 0x504BCED1BF8E4E45ULL, 0x99EA0196163FA42EULL }, /* 1e-111 */
+    { 0xE45EC2862F71E1D6ULL, 0xC06481FB9BCF8D39ULL }, /* 1e-110 */
+    { 0x5D767327BB4E5A4CULL, 0xF07DA27A82C37088ULL }, /* 1e-109 */
+    { 0x3A6A07F8D510F86FULL, 0x964E858C91BA2655ULL }, /* 1e-108 */
+    { 0x890489F70A55368BULL, 0xBBE226EFB628AFEAULL }, /* 1e-107 */
+    { 0x2B45AC74CCEA842EULL, 0xEADAB0ABA3B2DBE5ULL }, /* 1e-106 */
+    { 0x3B0B8BC90012929DULL, 0x92C8AE6B464FC96FULL }, /* 1e-105 */
+    { 0x09CE6EBB40173744ULL, 0xB77ADA0617E3BBCBULL }, /* 1e-104 */
+    { 0xCC420A6A101D0515ULL, 0xE55990879DDCAABDULL }, /* 1e-103 */
+    { 0x9FA946824A12232DULL, 0x8F57FA54C2A9EAB6ULL }, /* 1e-102 */
+    { 0x47939822DC96ABF9ULL, 0xB32DF8E9F3546564ULL }, /* 1e-101 */
+    { 0x59787E2B93BC56F7ULL, 0xDFF9772470297EBDULL }, /* 1e-100 */
+    { 0x57EB4EDB3C55B65AULL, 0x8BFBEA76C619EF36ULL }, /* 1e-99 */
+    { 0xEDE622920B6B23F1ULL, 0xAEFAE51477A06B03ULL }, /* 1e-98 */
+    { 0xE95FAB368E45ECEDULL, 0xDAB99E59958885C4ULL }, /* 1e-97 */
+    { 0x11DBCB0218EBB414ULL, 0x88B402F7FD75539BULL }, /* 1e-96 */
+    { 0xD652BDC29F26A119ULL, 0xAAE103B5FCD2A881ULL }, /* 1e-95 */
+    { 0x4BE76D3346F0495FULL, 0xD59944A37C0752A2ULL }, /* 1e-94 */
+    { 0x6F70A4400C562DDBULL, 0x857FCAE62D8493A5ULL }, /* 1e-93 */
+    { 0xCB4CCD500F6BB952ULL, 0xA6DFBD9FB8E5B88EULL }, /* 1e-92 */
+    { 0x7E2000A41346A7A7ULL, 0xD097AD07A71F26B2ULL }, /* 1e-91 */
+    { 0x8ED400668C0C28C8ULL, 0x825ECC24C873782FULL }, /* 1e-90 */
+    { 0x728900802F0F32FAULL, 0xA2F67F2DFA90563BULL }, /* 1e-89 */
+    { 0x4F2B40A03AD2FFB9ULL, 0xCBB41EF979346BCAULL }, /* 1e-88 */
+    { 0xE2F610C84987BFA8ULL, 0xFEA126B7D78186BCULL }, /* 1e-87 */
+    { 0x0DD9CA7D2DF4D7C9ULL, 0x9F24B832E6B0F436ULL }, /* 1e-86 */
+    { 0x91503D1C79720DBBULL, 0xC6EDE63FA05D3143ULL }, /* 1e-85 */
+    { 0x75A44C6397CE912AULL, 0xF8A95FCF88747D94ULL }, /* 1e-84 */
+    { 0xC986AFBE3EE11ABAULL, 0x9B69DBE1B548CE7CULL }, /* 1e-83 */
+    { 0xFBE85BADCE996168ULL, 0xC24452DA229B021BULL }, /* 1e-82 */
+    { 0xFAE27299423FB9C3ULL, 0xF2D56790AB41C2A2ULL }, /* 1e-81 */
+    { 0xDCCD879FC967D41AULL, 0x97C560BA6B0919A5ULL }, /* 1e-80 */
+    { 0x5400E987BBC1C920ULL, 0xBDB6B8E905CB600FULL }, /* 1e-79 */
+    { 0x290123E9AAB23B68ULL, 0xED246723473E3813ULL }, /* 1e-78 */
+    { 0xF9A0B6720AAF6521ULL, 0x9436C0760C86E30BULL }, /* 1e-77 */
+    { 0xF808E40E8D5B3E69ULL, 0xB94470938FA89BCEULL }, /* 1e-76 */
+    { 0xB60B1D1230B20E04ULL, 0xE7958CB87392C2C2ULL }, /* 1e-75 */
+    { 0xB1C6F22B5E6F48C2ULL, 0x90BD77F3483BB9B9ULL }, /* 1e-74 */
+    { 0x1E38AEB6360B1AF3ULL, 0xB4ECD5F01A4AA828ULL }, /* 1e-73 */
+    { 0x25C6DA63C38DE1B0ULL, 0xE2280B6C20DD5232ULL }, /* 1e-72 */
+    { 0x579C487E5A38AD0EULL, 0x8D590723948A535FULL }, /* 1e-71 */
+    { 0x2D835A9DF0C6D851ULL, 0xB0AF48EC79ACE837ULL }, /* 1e-70 */
+    { 0xF8E431456CF88E65ULL, 0xDCDB1B2798182244ULL }, /* 1e-69 */
+    { 0x1B8E9ECB641B58FFULL, 0x8A08F0F8BF0F156BULL }, /* 1e-68 */
+    { 0xE272467E3D222F3FULL, 0xAC8B2D36EED2DAC5ULL }, /* 1e-67 */
+    { 0x5B0ED81DCC6ABB0FULL, 0xD7ADF884AA879177ULL }, /* 1e-66 */
+    { 0x98E947129FC2B4E9ULL, 0x86CCBB52EA94BAEAULL }, /* 1e-65 */
+    { 0x3F2398D747B36224ULL, 0xA87FEA27A539E9A5ULL }, /* 1e-64 */
+    { 0x8EEC7F0D19A03AADULL, 0xD29FE4B18E88640EULL }, /* 1e-63 */
+    { 0x1953CF68300424ACULL, 0x83A3EEEEF9153E89ULL }, /* 1e-62 */
+    { 0x5FA8C3423C052DD7ULL, 0xA48CEAAAB75A8E2BULL }, /* 1e-61 */
+    { 0x3792F412CB06794DULL, 0xCDB02555653131B6ULL }, /* 1e-60 */
+    { 0xE2BBD88BBEE40BD0ULL, 0x808E17555F3EBF11ULL }, /* 1e-59 */
+    { 0x5B6ACEAEAE9D0EC4ULL, 0xA0B19D2AB70E6ED6ULL }, /* 1e-58 */
+    { 0xF245825A5A445275ULL, 0xC8DE047564D20A8BULL }, /* 1e-57 */
+    { 0xEED6E2F0F0D56712ULL, 0xFB158592BE068D2EULL }, /* 1e-56 */
+    { 0x55464DD69685606BULL, 0x9CED737BB6C4183DULL }, /* 1e-55 */
+    { 0xAA97E14C3C26B886ULL, 0xC428D05AA4751E4CULL }, /* 1e-54 */
+    { 0xD53DD99F4B3066A8ULL, 0xF53304714D9265DFULL }, /* 1e-53 */
+    { 0xE546A8038EFE4029ULL, 0x993FE2C6D07B7FABULL }, /* 1e-52 */
+    { 0xDE98520472BDD033ULL, 0xBF8FDB78849A5F96ULL }, /* 1e-51 */
+    { 0x963E66858F6D4440ULL, 0xEF73D256A5C0F77CULL }, /* 1e-50 */
+    { 0xDDE7001379A44AA8ULL, 0x95A8637627989AADULL }, /* 1e-49 */
+    { 0x5560C018580D5D52ULL, 0xBB127C53B17EC159ULL }, /* 1e-48 */
+    { 0xAAB8F01E6E10B4A6ULL, 0xE9D71B689DDE71AFULL }, /* 1e-47 */
+    { 0xCAB3961304CA70E8ULL, 0x9226712162AB070DULL }, /* 1e-46 */
+    { 0x3D607B97C5FD0D22ULL, 0xB6B00D69BB55C8D1ULL }, /* 1e-45 */
+    { 0x8CB89A7DB77C506AULL, 0xE45C10C42A2B3B05ULL }, /* 1e-44 */
+    { 0x77F3608E92ADB242ULL, 0x8EB98A7A9A5B04E3ULL }, /* 1e-43 */
+    { 0x55F038B237591ED3ULL, 0xB267ED1940F1C61CULL }, /* 1e-42 */
+    { 0x6B6C46DEC52F6688ULL, 0xDF01E85F912E37A3ULL }, /* 1e-41 */
+    { 0x2323AC4B3B3DA015ULL, 0x8B61313BBABCE2C6ULL }, /* 1e-40 */
+    { 0xABEC975E0A0D081AULL, 0xAE397D8AA96C1B77ULL }, /* 1e-39 */
+    { 0x96E7BD358C904A21ULL, 0xD9C7DCED53C72255ULL }, /* 1e-38 */
+    { 0x7E50D64177DA2E54ULL, 0x881CEA14545C7575ULL }, /* 1e-37 */
+    { 0xDDE50BD1D5D0B9E9ULL, 0xAA242499697392D2ULL }, /* 1e-36 */
+    { 0x955E4EC64B44E864ULL, 0xD4AD2DBFC3D07787ULL }, /* 1e-35 */
+    { 0xBD5AF13BEF0B113EULL, 0x84EC3C97DA624AB4ULL }, /* 1e-34 */
+    { 0xECB1AD8AEACDD58EULL, 0xA6274BBDD0FADD61ULL }, /* 1e-33 */
+    { 0x67DE18EDA5814AF2ULL, 0xCFB11EAD453994BAULL }, /* 1e-32 */
+    { 0x80EACF948770CED7ULL, 0x81CEB32C4B43FCF4ULL }, /* 1e-31 */
+    { 0xA1258379A94D028DULL, 0xA2425FF75E14FC31ULL }, /* 1e-30 */
+    { 0x096EE45813A04330ULL, 0xCAD2F7F5359A3B3EULL }, /* 1e-29 */
+    { 0x8BCA9D6E188853FCULL, 0xFD87B5F28300CA0DULL }, /* 1e-28 */
+    { 0x775EA264CF55347DULL, 0x9E74D1B791E07E48ULL }, /* 1e-27 */
+    { 0x95364AFE032A819DULL, 0xC612062576589DDAULL }, /* 1e-26 */
+    { 0x3A83DDBD83F52204ULL, 0xF79687AED3EEC551ULL }, /* 1e-25 */
+    { 0xC4926A9672793542ULL, 0x9ABE14CD44753B52ULL }, /* 1e-24 */
+    { 0x75B7053C0F178293ULL, 0xC16D9A0095928A27ULL }, /* 1e-23 */
+    { 0x5324C68B12DD6338ULL, 0xF1C90080BAF72CB1ULL }, /* 1e-22 */
+    { 0xD3F6FC16EBCA5E03ULL, 0x971DA05074DA7BEEULL }, /* 1e-21 */
+    { 0x88F4BB1CA6BCF584ULL, 0xBCE5086492111AEAULL }, /* 1e-20 */
+    { 0x2B31E9E3D06C32E5ULL, 0xEC1E4A7DB69561A5ULL }, /* 1e-19 */
+    { 0x3AFF322E62439FCFULL, 0x9392EE8E921D5D07ULL }, /* 1e-18 */
+    { 0x09BEFEB9FAD487C2ULL, 0xB877AA3236A4B449ULL }, /* 1e-17 */
+    { 0x4C2EBE687989A9B3ULL, 0xE69594BEC44DE15BULL }, /* 1e-16 */
+    { 0x0F9D37014BF60A10ULL, 0x901D7CF73AB0ACD9ULL }, /* 1e-15 */
+    { 0x538484C19EF38C94ULL, 0xB424DC35095CD80FULL }, /* 1e-14 */
+    { 0x2865A5F206B06FB9ULL, 0xE12E13424BB40E13ULL }, /* 1e-13 */
+    { 0xF93F87B7442E45D3ULL, 0x8CBCCC096F5088CBULL }, /* 1e-12 */
+    { 0xF78F69A51539D748ULL, 0xAFEBFF0BCB24AAFEULL }, /* 1e-11 */
+    { 0xB573440E5A884D1BULL, 0xDBE6FECEBDEDD5BEULL }, /* 1e-10 */
+    { 0x31680A88F8953030ULL, 0x89705F4136B4A597ULL }, /* 1e-9 */
+    { 0xFDC20D2B36BA7C3DULL, 0xABCC77118461CEFCULL }, /* 1e-8 */
+    { 0x3D32907604691B4CULL, 0xD6BF94D5E57A42BCULL }, /* 1e-7 */
+    { 0xA63F9A49C2C1B10FULL, 0x8637BD05AF6C69B5ULL }, /* 1e-6 */
+    { 0x0FCF80DC33721D53ULL, 0xA7C5AC471B478423ULL }, /* 1e-5 */
+    { 0xD3C36113404EA4A8ULL, 0xD1B71758E219652BULL }, /* 1e-4 */
+    { 0x645A1CAC083126E9ULL, 0x83126E978D4FDF3BULL }, /* 1e-3 */
+    { 0x3D70A3D70A3D70A3ULL, 0xA3D70A3D70A3D70AULL }, /* 1e-2 */
+    { 0xCCCCCCCCCCCCCCCCULL, 0xCCCCCCCCCCCCCCCCULL }, /* 1e-1 */
+    { 0x0000000000000000ULL, 0x8000000000000000ULL }, /* 1e0 */
+    { 0x0000000000000000ULL, 0xA000000000000000ULL }, /* 1e1 */
+    { 0x0000000000000000ULL, 0xC800000000000000ULL }, /* 1e2 */
+    { 0x0000000000000000ULL, 0xFA00000000000000ULL }, /* 1e3 */
+    { 0x0000000000000000ULL, 0x9C40000000000000ULL }, /* 1e4 */
+    { 0x0000000000000000ULL, 0xC350000000000000ULL }, /* 1e5 */
+    { 0x0000000000000000ULL, 0xF424000000000000ULL }, /* 1e6 */
+    { 0x0000000000000000ULL, 0x9896800000000000ULL }, /* 1e7 */
+    { 0x0000000000000000ULL, 0xBEBC200000000000ULL }, /* 1e8 */
+    { 0x0000000000000000ULL, 0xEE6B280000000000ULL }, /* 1e9 */
+    { 0x0000000000000000ULL, 0x9502F90000000000ULL }, /* 1e10 */
+    { 0x0000000000000000ULL, 0xBA43B74000000000ULL }, /* 1e11 */
+    { 0x0000000000000000ULL, 0xE8D4A51000000000ULL }, /* 1e12 */
+    { 0x0000000000000000ULL, 0x9184E72A00000000ULL }, /* 1e13 */
+    { 0x0000000000000000ULL, 0xB5E620F480000000ULL }, /* 1e14 */
+    { 0x0000000000000000ULL, 0xE35FA931A0000000ULL }, /* 1e15 */
+    { 0x0000000000000000ULL, 0x8E1BC9BF04000000ULL }, /* 1e16 */
+    { 0x0000000000000000ULL, 0xB1A2BC2EC5000000ULL }, /* 1e17 */
+    { 0x0000000000000000ULL, 0xDE0B6B3A76400000ULL }, /* 1e18 */
+    { 0x0000000000000000ULL, 0x8AC7230489E80000ULL }, /* 1e19 */
+    { 0x0000000000000000ULL, 0xAD78EBC5AC620000ULL }, /* 1e20 */
+    { 0x0000000000000000ULL, 0xD8D726B7177A8000ULL }, /* 1e21 */
+    { 0x0000000000000000ULL, 0x878678326EAC9000ULL }, /* 1e22 */
+    { 0x0000000000000000ULL, 0xA968163F0A57B400ULL }, /* 1e23 */
+    { 0x0000000000000000ULL, 0xD3C21BCECCEDA100ULL }, /* 1e24 */
+    { 0x0000000000000000ULL, 0x84595161401484A0ULL }, /* 1e25 */
+    { 0x0000000000000000ULL, 0xA56FA5B99019A5C8ULL }, /* 1e26 */
+    { 0x0000000000000000ULL, 0xCECB8F27F4200F3AULL }, /* 1e27 */
+    { 0x4000000000000000ULL, 0x813F3978F8940984ULL }, /* 1e28 */
+    { 0x5000000000000000ULL, 0xA18F07D736B90BE5ULL }, /* 1e29 */
+    { 0xA400000000000000ULL, 0xC9F2C9CD04674EDEULL }, /* 1e30 */
+    { 0x4D00000000000000ULL, 0xFC6F7C4045812296ULL }, /* 1e31 */
+    { 0xF020000000000000ULL, 0x9DC5ADA82B70B59DULL }, /* 1e32 */
+    { 0x6C28000000000000ULL, 0xC5371912364CE305ULL }, /* 1e33 */
+    { 0xC732000000000000ULL, 0xF684DF56C3E01BC6ULL }, /* 1e34 */
+    { 0x3C7F400000000000ULL, 0x9A130B963A6C115CULL }, /* 1e35 */
+    { 0x4B9F100000000000ULL, 0xC097CE7BC90715B3ULL }, /* 1e36 */
+    { 0x1E86D40000000000ULL, 0xF0BDC21ABB48DB20ULL }, /* 1e37 */
+    { 0x1314448000000000ULL, 0x96769950B50D88F4ULL }, /* 1e38 */
+    { 0x17D955A000000000ULL, 0xBC143FA4E250EB31ULL }, /* 1e39 */
+    { 0x5DCFAB0800000000ULL, 0xEB194F8E1AE525FDULL }, /* 1e40 */
+    { 0x5AA1CAE500000000ULL, 0x92EFD1B8D0CF37BEULL }, /* 1e41 */
+    { 0xF14A3D9E40000000ULL, 0xB7ABC627050305ADULL }, /* 1e42 */
+    { 0x6D9CCD05D0000000ULL, 0xE596B7B0C643C719ULL }, /* 1e43 */
+    { 0xE4820023A2000000ULL, 0x8F7E32CE7BEA5C6FULL }, /* 1e44 */
+    { 0xDDA2802C8A800000ULL, 0xB35DBF821AE4F38BULL }, /* 1e45 */
+    { 0xD50B2037AD200000ULL, 0xE0352F62A19E306EULL }, /* 1e46 */
+    { 0x4526F422CC340000ULL, 0x8C213D9DA502DE45ULL }, /* 1e47 */
+    { 0x9670B12B7F410000ULL, 0xAF298D050E4395D6ULL }, /* 1e48 */
+    { 0x3C0CDD765F114000ULL, 0xDAF3F04651D47B4CULL }, /* 1e49 */
+    { 0xA5880A69FB6AC800ULL, 0x88D8762BF324CD0FULL }, /* 1e50 */
+    { 0x8EEA0D047A457A00ULL, 0xAB0E93B6EFEE0053ULL }, /* 1e51 */
+    { 0x72A4904598D6D880ULL, 0xD5D238A4ABE98068ULL }, /* 1e52 */
+    { 0x47A6DA2B7F864750ULL, 0x85A36366EB71F041ULL }, /* 1e53 */
+    { 0x999090B65F67D924ULL, 0xA70C3C40A64E6C51ULL }, /* 1e54 */
+    { 0xFFF4B4E3F741CF6DULL, 0xD0CF4B50CFE20765ULL }, /* 1e55 */
+    { 0xBFF8F10E7A8921A4ULL, 0x82818F1281ED449FULL }, /* 1e56 */
+    { 0xAFF72D52192B6A0DULL, 0xA321F2D7226895C7ULL }, /* 1e57 */
+    { 0x9BF4F8A69F764490ULL, 0xCBEA6F8CEB02BB39ULL }, /* 1e58 */
+    { 0x02F236D04753D5B4ULL, 0xFEE50B7025C36A08ULL }, /* 1e59 */
+    { 0x01D762422C946590ULL, 0x9F4F2726179A2245ULL }, /* 1e60 */
+    { 0x424D3AD2B7B97EF5ULL, 0xC722F0EF9D80AAD6ULL }, /* 1e61 */
+    { 0xD2E0898765A7DEB2ULL, 0xF8EBAD2B84E0D58BULL }, /* 1e62 */
+    { 0x63CC55F49F88EB2FULL, 0x9B934C3B330C8577ULL }, /* 1e63 */
+    { 0x3CBF6B71C76B25FBULL, 0xC2781F49FFCFA6D5ULL }, /* 1e64 */
+    { 0x8BEF464E3945EF7AULL, 0xF316271C7FC3908AULL }, /* 1e65 */
+    { 0x97758BF0E3CBB5ACULL, 0x97EDD871CFDA3A56ULL }, /* 1e66 */
+    { 0x3D52EEED1CBEA317ULL, 0xBDE94E8E43D0C8ECULL }, /* 1e67 */
+    { 0x4CA7AAA863EE4BDDULL, 0xED63A231D4C4FB27ULL }, /* 1e68 */
+    { 0x8FE8CAA93E74EF6AULL, 0x945E455F24FB1CF8ULL }, /* 1e69 */
+    { 0xB3E2FD538E122B44ULL, 0xB975D6B6EE39E436ULL }, /* 1e70 */
+    { 0x60DBBCA87196B616ULL, 0xE7D34C64A9C85D44ULL }, /* 1e71 */
+    { 0xBC8955E946FE31CDULL, 0x90E40FBEEA1D3A4AULL }, /* 1e72 */
+    { 0x6BABAB6398BDBE41ULL, 0xB51D13AEA4A488DDULL }, /* 1e73 */
+    { 0xC696963C7EED2DD1ULL, 0xE264589A4DCDAB14ULL }, /* 1e74 */
+    { 0xFC1E1DE5CF543CA2ULL, 0x8D7EB76070A08AECULL }, /* 1e75 */
+    { 0x3B25A55F43294BCBULL, 0xB0DE65388CC8ADA8ULL }, /* 1e76 */
+    { 0x49EF0EB713F39EBEULL, 0xDD15FE86AFFAD912ULL }, /* 1e77 */
+    { 0x6E3569326C784337ULL, 0x8A2DBF142DFCC7ABULL }, /* 1e78 */
+    { 0x49C2C37F07965404ULL, 0xACB92ED9397BF996ULL }, /* 1e79 */
+    { 0xDC33745EC97BE906ULL, 0xD7E77A8F87DAF7FBULL }, /* 1e80 */
+    { 0x69A028BB3DED71A3ULL, 0x86F0AC99B4E8DAFDULL }, /* 1e81 */
+    { 0xC40832EA0D68CE0CULL, 0xA8ACD7C0222311BCULL }, /* 1e82 */
+    { 0xF50A3FA490C30190ULL, 0xD2D80DB02AABD62BULL }, /* 1e83 */
+    { 0x792667C6DA79E0FAULL, 0x83C7088E1AAB65DBULL }, /* 1e84 */
+    { 0x577001B891185938ULL, 0xA4B8CAB1A1563F52ULL }, /* 1e85 */
+    { 0xED4C0226B55E6F86ULL, 0xCDE6FD5E09ABCF26ULL }, /* 1e86 */
+    { 0x544F8158315B05B4ULL, 0x80B05E5AC60B6178ULL }, /* 1e87 */
+    { 0x696361AE3DB1C721ULL, 0xA0DC75F1778E39D6ULL }, /* 1e88 */
+    { 0x03BC3A19CD1E38E9ULL, 0xC913936DD571C84CULL }, /* 1e89 */
+    { 0x04AB48A04065C723ULL, 0xFB5878494ACE3A5FULL }, /* 1e90 */
+    { 0x62EB0D64283F9C76ULL, 0x9D174B2DCEC0E47BULL }, /* 1e91 */
+    { 0x3BA5D0BD324F8394ULL, 0xC45D1DF942711D9AULL }, /* 1e92 */
+    { 0xCA8F44EC7EE36479ULL, 0xF5746577930D6500ULL }, /* 1e93 */
+    { 0x7E998B13CF4E1ECBULL, 0x9968BF6ABBE85F20ULL }, /* 1e94 */
+    { 0x9E3FEDD8C321A67EULL, 0xBFC2EF456AE276E8ULL }, /* 1e95 */
+    { 0xC5CFE94EF3EA101EULL, 0xEFB3AB16C59B14A2ULL }, /* 1e96 */
+    { 0xBBA1F1D158724A12ULL, 0x95D04AEE3B80ECE5ULL }, /* 1e97 */
+    { 0x2A8A6E45AE8EDC97ULL, 0xBB445DA9CA61281FULL }, /* 1e98 */
+    { 0xF52D09D71A3293BDULL, 0xEA1575143CF97226ULL }, /* 1e99 */
+    { 0x593C2626705F9C56ULL, 0x924D692CA61BE758ULL }, /* 1e100 */
+    { 0x6F8B2FB00C77836CULL, 0xB6E0C377CFA2E12EULL }, /* 1e101 */
+    { 0x0B6DFB9C0F956447ULL, 0xE498F455C38B997AULL }, /* 1e102 */
+    { 0x4724BD4189BD5EACULL, 0x8EDF98B59A373FECULL }, /* 1e103 */
+    { 0x58EDEC91EC2CB657ULL, 0xB2977EE300C50FE7ULL }, /* 1e104 */
+    { 0x2F2967B66737E3EDULL, 0xDF3D5E9BC0F653E1ULL }, /* 1e105 */
+    { 0xBD79E0D20082EE74ULL, 0x8B865B215899F46CULL }, /* 1e106 */
+    { 0xECD8590680A3AA11ULL, 0xAE67F1E9AEC07187ULL }, /* 1e107 */
+    { 0xE80E6F4820CC9495ULL, 0xDA01EE641A708DE9ULL }, /* 1e108 */
+    { 0x3109058D147FDCDDULL, 0x884134FE908658B2ULL }, /* 1e109 */
+    { 0xBD4B46F0599FD415ULL, 0xAA51823E34A7EEDEULL }, /* 1e110 */
+    { 0x6C9E18AC7007C91AULL, 0xD4E5E2CDC1D1EA96ULL }, /* 1e111 */
+    { 0x03E2CF6BC604DDB0ULL, 0x850FADC09923329EULL }, /* 1e112 */
+    { 0x84DB8346B786151CULL, 0xA6539930BF6BFF45ULL }, /* 1e113 */
+    { 0xE612641865679A63ULL, 0xCFE87F7CEF46FF16ULL }, /* 1e114 */
+    { 0x4FCB7E8F3F60C07EULL, 0x81F14FAE158C5F6EULL }, /* 1e115 */
+    { 0xE3BE5E330F38F09DULL, 0xA26DA3999AEF7749ULL }, /* 1e116 */
+    { 0x5CADF5BFD3072CC5ULL, 0xCB090C8001AB551CULL }, /* 1e117 */
+    { 0x73D9732FC7C8F7F6ULL, 0xFDCB4FA002162A63ULL }, /* 1e118 */
+    { 0x2867E7FDDCDD9AFAULL, 0x9E9F11C4014DDA7EULL }, /* 1e119 */
+    { 0xB281E1FD541501B8ULL, 0xC646D63501A1511DULL }, /* 1e120 */
+    { 0x1F225A7CA91A4226ULL, 0xF7D88BC24209A565ULL }, /* 1e121 */
+    { 0x3375788DE9B06958ULL, 0x9AE757596946075FULL }, /* 1e122 */
+    { 0x0052D6B1641C83AEULL, 0xC1A12D2FC3978937ULL }, /* 1e123 */
+    { 0xC0678C5DBD23A49AULL, 0xF209787BB47D6B84ULL }, /* 1e124 */
+    { 0xF840B7BA963646E0ULL, 0x9745EB4D50CE6332ULL }, /* 1e125 */
+    { 0xB650E5A93BC3D898ULL, 0xBD176620A501FBFFULL }, /* 1e126 */
+    { 0xA3E51F138AB4CEBEULL, 0xEC5D3FA8CE427AFFULL }, /* 1e127 */
+    { 0xC66F336C36B10137ULL, 0x93BA47C980E98CDFULL }, /* 1e128 */
+    { 0xB80B0047445D4184ULL, 0xB8A8D9BBE123F017ULL }, /* 1e129 */
+    { 0xA60DC059157491E5ULL, 0xE6D3102AD96CEC1DULL }, /* 1e130 */
+    { 0x87C89837AD68DB2FULL, 0x9043EA1AC7E41392ULL }, /* 1e131 */
+    { 0x29BABE4598C311FBULL, 0xB454E4A179DD1877ULL }, /* 1e132 */
+    { 0xF4296DD6FEF3D67AULL, 0xE16A1DC9D8545E94ULL }, /* 1e133 */
+    { 0x1899E4A65F58660CULL, 0x8CE2529E2734BB1DULL }, /* 1e134 */
+    { 0x5EC05DCFF72E7F8FULL, 0xB01AE745B101E9E4ULL }, /* 1e135 */
+    { 0x76707543F4FA1F73ULL, 0xDC21A1171D42645DULL }, /* 1e136 */
+    { 0x6A06494A791C53A8ULL, 0x899504AE72497EBAULL }, /* 1e137 */
+    { 0x0487DB9D17636892ULL, 0xABFA45DA0EDBDE69ULL }, /* 1e138 */
+    { 0x45A9D2845D3C42B6ULL, 0xD6F8D7509292D603ULL }, /* 1e139 */
+    { 0x0B8A2392BA45A9B2ULL, 0x865B86925B9BC5C2ULL }, /* 1e140 */
+    { 0x8E6CAC7768D7141EULL, 0xA7F26836F282B732ULL }, /* 1e141 */
+    { 0x3207D795430CD926ULL, 0xD1EF0244AF2364FFULL }, /* 1e142 */
+    { 0x7F44E6BD49E807B8ULL, 0x8335616AED761F1FULL }, /* 1e143 */
+    { 0x5F16206C9C6209A6ULL, 0xA402B9C5A8D3A6E7ULL }, /* 1e144 */
+    { 0x36DBA887C37A8C0FULL, 0xCD036837130890A1ULL }, /* 1e145 */
+    { 0xC2494954DA2C9789ULL, 0x802221226BE55A64ULL }, /* 1e146 */
+    { 0xF2DB9BAA10B7BD6CULL, 0xA02AA96B06DEB0FDULL }, /* 1e147 */
+    { 0x6F92829494E5ACC7ULL, 0xC83553C5C8965D3DULL }, /* 1e148 */
+    { 0xCB772339BA1F17F9ULL, 0xFA42A8B73ABBF48CULL }, /* 1e149 */
+    { 0xFF2A760414536EFBULL, 0x9C69A97284B578D7ULL }, /* 1e150 */
+    { 0xFEF5138519684ABAULL, 0xC38413CF25E2D70DULL }, /* 1e151 */
+    { 0x7EB258665FC25D69ULL, 0xF46518C2EF5B8CD1ULL }, /* 1e152 */
+    { 0xEF2F773FFBD97A61ULL, 0x98BF2F79D5993802ULL }, /* 1e153 */
+    { 0xAAFB550FFACFD8FAULL, 0xBEEEFB584AFF8603ULL }, /* 1e154 */
+    { 0x95BA2A53F983CF38ULL, 0xEEAABA2E5DBF6784ULL }, /* 1e155 */
+    { 0xDD945A747BF26183ULL, 0x952AB45CFA97A0B2ULL }, /* 1e156 */
+    { 0x94F971119AEEF9E4ULL, 0xBA756174393D88DFULL }, /* 1e157 */
+    { 0x7A37CD5601AAB85DULL, 0xE912B9D1478CEB17ULL }, /* 1e158 */
+    { 0xAC62E055C10AB33AULL, 0x91ABB422CCB812EEULL }, /* 1e159 */
+    { 0x577B986B314D6009ULL, 0xB616A12B7FE617AAULL }, /* 1e160 */
+    { 0xED5A7E85FDA0B80BULL, 0xE39C49765FDF9D94ULL }, /* 1e161 */
+    { 0x14588F13BE847307ULL, 0x8E41ADE9FBEBC27DULL }, /* 1e162 */
+    { 0x596EB2D8AE258FC8ULL, 0xB1D219647AE6B31CULL }, /* 1e163 */
+    { 0x6FCA5F8ED9AEF3BBULL, 0xDE469FBD99A05FE3ULL }, /* 1e164 */
+    { 0x25DE7BB9480D5854ULL, 0x8AEC23D680043BEEULL }, /* 1e165 */
+    { 0xAF561AA79A10AE6AULL, 0xADA72CCC20054AE9ULL }, /* 1e166 */
+    { 0x1B2BA1518094DA04ULL, 0xD910F7FF28069DA4ULL }, /* 1e167 */
+    { 0x90FB44D2F05D0842ULL, 0x87AA9AFF79042286ULL }, /* 1e168 */
+    { 0x353A1607AC744A53ULL, 0xA99541BF57452B28ULL }, /* 1e169 */
+    { 0x42889B8997915CE8ULL, 0xD3FA922F2D1675F2ULL }, /* 1e170 */
+    { 0x69956135FEBADA11ULL, 0x847C9B5D7C2E09B7ULL }, /* 1e171 */
+    { 0x43FAB9837E699095ULL, 0xA59BC234DB398C25ULL }, /* 1e172 */
+    { 0x94F967E45E03F4BBULL, 0xCF02B2C21207EF2EULL }, /* 1e173 */
+    { 0x1D1BE0EEBAC278F5ULL, 0x8161AFB94B44F57DULL }, /* 1e174 */
+    { 0x6462D92A69731732ULL, 0xA1BA1BA79E1632DCULL }, /* 1e175 */
+    { 0x7D7B8F7503CFDCFEULL, 0xCA28A291859BBF93ULL }, /* 1e176 */
+    { 0x5CDA735244C3D43EULL, 0xFCB2CB35E702AF78ULL }, /* 1e177 */
+    { 0x3A0888136AFA64A7ULL, 0x9DEFBF01B061ADABULL }, /* 1e178 */
+    { 0x088AAA1845B8FDD0ULL, 0xC56BAEC21C7A1916ULL }, /* 1e179 */
+    { 0x8AAD549E57273D45ULL, 0xF6C69A72A3989F5BULL }, /* 1e180 */
+    { 0x36AC54E2F678864BULL, 0x9A3C2087A63F6399ULL }, /* 1e181 */
+    { 0x84576A1BB416A7DDULL, 0xC0CB28A98FCF3C7FULL }, /* 1e182 */
+    { 0x656D44A2A11C51D5ULL, 0xF0FDF2D3F3C30B9FULL }, /* 1e183 */
+    { 0x9F644AE5A4B1B325ULL, 0x969EB7C47859E743ULL }, /* 1e184 */
+    { 0x873D5D9F0DDE1FEEULL, 0xBC4665B596706114ULL }, /* 1e185 */
+    { 0xA90CB506D155A7EAULL, 0xEB57FF22FC0C7959ULL }, /* 1e186 */
+    { 0x09A7F12442D588F2ULL, 0x9316FF75DD87CBD8ULL }, /* 1e187 */
+    { 0x0C11ED6D538AEB2FULL, 0xB7DCBF5354E9BECEULL }, /* 1e188 */
+    { 0x8F1668C8A86DA5FAULL, 0xE5D3EF282A242E81ULL }, /* 1e189 */
+    { 0xF96E017D694487BCULL, 0x8FA475791A569D10ULL }, /* 1e190 */
+    { 0x37C981DCC395A9ACULL, 0xB38D92D760EC4455ULL }, /* 1e191 */
+    { 0x85BBE253F47B1417ULL, 0xE070F78D3927556AULL }, /* 1e192 */
+    { 0x93956D7478CCEC8EULL, 0x8C469AB843B89562ULL }, /* 1e193 */
+    { 0x387AC8D1970027B2ULL, 0xAF58416654A6BABBULL }, /* 1e194 */
+    { 0x06997B05FCC0319EULL, 0xDB2E51BFE9D0696AULL }, /* 1e195 */
+    { 0x441FECE3BDF81F03ULL, 0x88FCF317F22241E2ULL }, /* 1e196 */
+    { 0xD527E81CAD7626C3ULL, 0xAB3C2FDDEEAAD25AULL }, /* 1e197 */
+    { 0x8A71E223D8D3B074ULL, 0xD60B3BD56A5586F1ULL }, /* 1e198 */
+    { 0xF6872D5667844E49ULL, 0x85C7056562757456ULL }, /* 1e199 */
+    { 0xB428F8AC016561DBULL, 0xA738C6BEBB12D16CULL }, /* 1e200 */
+    { 0xE13336D701BEBA52ULL, 0xD106F86E69D785C7ULL }, /* 1e201 */
+    { 0xECC0024661173473ULL, 0x82A45B450226B39CULL }, /* 1e202 */
+    { 0x27F002D7F95D0190ULL, 0xA34D721642B06084ULL }, /* 1e203 */
+    { 0x31EC038DF7B441F4ULL, 0xCC20CE9BD35C78A5ULL }, /* 1e204 */
+    { 0x7E67047175A15271ULL, 0xFF290242C83396CEULL }, /* 1e205 */
+    { 0x0F0062C6E984D386ULL, 0x9F79A169BD203E41ULL }, /* 1e206 */
+    { 0x52C07B78A3E60868ULL, 0xC75809C42C684DD1ULL }, /* 1e207 */
+    { 0xA7709A56CCDF8A82ULL, 0xF92E0C3537826145ULL }, /* 1e208 */
+    { 0x88A66076400BB691ULL, 0x9BBCC7A142B17CCBULL }, /* 1e209 */
+    { 0x6ACFF893D00EA435ULL, 0xC2ABF989935DDBFEULL }, /* 1e210 */
+    { 0x0583F6B8C4124D43ULL, 0xF356F7EBF83552FEULL }, /* 1e211 */
+    { 0xC3727A337A8B704AULL, 0x98165AF37B2153DEULL }, /* 1e212 */
+    { 0x744F18C0592E4C5CULL, 0xBE1BF1B059E9A8D6ULL }, /* 1e213 */
+    { 0x1162DEF06F79DF73ULL, 0xEDA2EE1C7064130CULL }, /* 1e214 */
+    { 0x8ADDCB5645AC2BA8ULL, 0x9485D4D1C63E8BE7ULL }, /* 1e215 */
+    { 0x6D953E2BD7173692ULL, 0xB9A74A0637CE2EE1ULL }, /* 1e216 */
+    { 0xC8FA8DB6CCDD0437ULL, 0xE8111C87C5C1BA99ULL }, /* 1e217 */
+    { 0x1D9C9892400A22A2ULL, 0x910AB1D4DB9914A0ULL }, /* 1e218 */
+    { 0x2503BEB6D00CAB4BULL, 0xB54D5E4A127F59C8ULL }, /* 1e219 */
+    { 0x2E44AE64840FD61DULL, 0xE2A0B5DC971F303AULL }, /* 1e220 */
+    { 0x5CEAECFED289E5D2ULL, 0x8DA471A9DE737E24ULL }, /* 1e221 */
+    { 0x7425A83E872C5F47ULL, 0xB10D8E1456105DADULL }, /* 1e222 */
+    { 0xD12F124E28F77719ULL, 0xDD50F1996B947518ULL }, /* 1e223 */
+    { 0x82BD6B70D99AAA6FULL, 0x8A5296FFE33CC92FULL }, /* 1e224 */
+    { 0x636CC64D1001550BULL, 0xACE73CBFDC0BFB7BULL }, /* 1e225 */
+    { 0x3C47F7E05401AA4EULL, 0xD8210BEFD30EFA5AULL }, /* 1e226 */
+    { 0x65ACFAEC34810A71ULL, 0x8714A775E3E95C78ULL }, /* 1e227 */
+    { 0x7F1839A741A14D0DULL, 0xA8D9D1535CE3B396ULL }, /* 1e228 */
+    { 0x1EDE48111209A050ULL, 0xD31045A8341CA07CULL }, /* 1e229 */
+    { 0x934AED0AAB460432ULL, 0x83EA2B892091E44DULL }, /* 1e230 */
+    { 0xF81DA84D5617853FULL, 0xA4E4B66B68B65D60ULL }, /* 1e231 */
+    { 0x36251260AB9D668EULL, 0xCE1DE40642E3F4B9ULL }, /* 1e232 */
+    { 0xC1D72B7C6B426019ULL, 0x80D2AE83E9CE78F3ULL }, /* 1e233 */
+    { 0xB24CF65B8612F81FULL, 0xA1075A24E4421730ULL }, /* 1e234 */
+    { 0xDEE033F26797B627ULL, 0xC94930AE1D529CFCULL }, /* 1e235 */
+    { 0x169840EF017DA3B1ULL, 0xFB9B7CD9A4A7443CULL }, /* 1e236 */
+    { 0x8E1F289560EE864EULL, 0x9D412E0806E88AA5ULL }, /* 1e237 */
+    { 0xF1A6F2BAB92A27E2ULL, 0xC491798A08A2AD4EULL }, /* 1e238 */
+    { 0xAE10AF696774B1DBULL, 0xF5B5D7EC8ACB58A2ULL }, /* 1e239 */
+    { 0xACCA6DA1E0A8EF29ULL, 0x9991A6F3D6BF1765ULL }, /* 1e240 */
+    { 0x17FD090A58D32AF3ULL, 0xBFF610B0CC6EDD3FULL }, /* 1e241 */
+    { 0xDDFC4B4CEF07F5B0ULL, 0xEFF394DCFF8A948EULL }, /* 1e242 */
+    { 0x4ABDAF101564F98EULL, 0x95F83D0A1FB69CD9ULL }, /* 1e243 */
+    { 0x9D6D1AD41ABE37F1ULL, 0xBB764C4CA7A4440FULL }, /* 1e244 */
+    { 0x84C86189216DC5EDULL, 0xEA53DF5FD18D5513ULL }, /* 1e245 */
+    { 0x32FD3CF5B4E49BB4ULL, 0x92746B9BE2F8552CULL }, /* 1e246 */
+    { 0x3FBC8C33221DC2A1ULL, 0xB7118682DBB66A77ULL }, /* 1e247 */
+    { 0x0FABAF3FEAA5334AULL, 0xE4D5E82392A40515ULL }, /* 1e248 */
+    { 0x29CB4D87F2A7400EULL, 0x8F05B1163BA6832DULL }, /* 1e249 */
+    { 0x743E20E9EF511012ULL, 0xB2C71D5BCA9023F8ULL }, /* 1e250 */
+    { 0x914DA9246B255416ULL, 0xDF78E4B2BD342CF6ULL }, /* 1e251 */
+    { 0x1AD089B6C2F7548EULL, 0x8BAB8EEFB6409C1AULL }, /* 1e252 */
+    { 0xA184AC2473B529B1ULL, 0xAE9672ABA3D0C320ULL }, /* 1e253 */
+    { 0xC9E5D72D90A2741EULL, 0xDA3C0F568CC4F3E8ULL }, /* 1e254 */
+    { 0x7E2FA67C7A658892ULL, 0x8865899617FB1871ULL }, /* 1e255 */
+    { 0xDDBB901B98FEEAB7ULL, 0xAA7EEBFB9DF9DE8DULL }, /* 1e256 */
+    { 0x552A74227F3EA565ULL, 0xD51EA6FA85785631ULL }, /* 1e257 */
+    { 0xD53A88958F87275FULL, 0x8533285C936B35DEULL }, /* 1e258 */
+    { 0x8A892ABAF368F137ULL, 0xA67FF273B8460356ULL }, /* 1e259 */
+    { 0x2D2B7569B0432D85ULL, 0xD01FEF10A657842CULL }, /* 1e260 */
+    { 0x9C3B29620E29FC73ULL, 0x8213F56A67F6B29BULL }, /* 1e261 */
+    { 0x8349F3BA91B47B8FULL, 0xA298F2C501F45F42ULL }, /* 1e262 */
+    { 0x241C70A936219A73ULL, 0xCB3F2F7642717713ULL }, /* 1e263 */
+    { 0xED238CD383AA0110ULL, 0xFE0EFB53D30DD4D7ULL }, /* 1e264 */
+    { 0xF4363804324A40AAULL, 0x9EC95D1463E8A506ULL }, /* 1e265 */
+    { 0xB143C6053EDCD0D5ULL, 0xC67BB4597CE2CE48ULL }, /* 1e266 */
+    { 0xDD94B7868E94050AULL, 0xF81AA16FDC1B81DAULL }, /* 1e267 */
+    { 0xCA7CF2B4191C8326ULL, 0x9B10A4E5E9913128ULL }, /* 1e268 */
+    { 0xFD1C2F611F63A3F0ULL, 0xC1D4CE1F63F57D72ULL }, /* 1e269 */
+    { 0xBC633B39673C8CECULL, 0xF24A01A73CF2DCCFULL }, /* 1e270 */
+    { 0xD5BE0503E085D813ULL, 0x976E41088617CA01ULL }, /* 1e271 */
+    { 0x4B2D8644D8A74E18ULL, 0xBD49D14AA79DBC82ULL }, /* 1e272 */
+    { 0xDDF8E7D60ED1219EULL, 0xEC9C459D51852BA2ULL }, /* 1e273 */
+    { 0xCABB90E5C942B503ULL, 0x93E1AB8252F33B45ULL }, /* 1e274 */
+    { 0x3D6A751F3B936243ULL, 0xB8DA1662E7B00A17ULL }, /* 1e275 */
+    { 0x0CC512670A783AD4ULL, 0xE7109BFBA19C0C9DULL }, /* 1e276 */
+    { 0x27FB2B80668B24C5ULL, 0x906A617D450187E2ULL }, /* 1e277 */
+    { 0xB1F9F660802DEDF6ULL, 0xB484F9DC9641E9DAULL }, /* 1e278 */
+    { 0x5E7873F8A0396973ULL, 0xE1A63853BBD26451ULL }, /* 1e279 */
+    { 0xDB0B487B6423E1E8ULL, 0x8D07E33455637EB2ULL }, /* 1e280 */
+    { 0x91CE1A9A3D2CDA62ULL, 0xB049DC016ABC5E5FULL }, /* 1e281 */
+    { 0x7641A140CC7810FBULL, 0xDC5C5301C56B75F7ULL }, /* 1e282 */
+    { 0xA9E904C87FCB0A9DULL, 0x89B9B3E11B6329BAULL }, /* 1e283 */
+    { 0x546345FA9FBDCD44ULL, 0xAC2820D9623BF429ULL }, /* 1e284 */
+    { 0xA97C177947AD4095ULL, 0xD732290FBACAF133ULL }, /* 1e285 */
+    { 0x49ED8EABCCCC485DULL, 0x867F59A9D4BED6C0ULL }, /* 1e286 */
+    { 0x5C68F256BFFF5A74ULL, 0xA81F301449EE8C70ULL }, /* 1e287 */
+    { 0x73832EEC6FFF3111ULL, 0xD226FC195C6A2F8CULL }, /* 1e288 */
+    { 0xC831FD53C5FF7EABULL, 0x83585D8FD9C25DB7ULL }, /* 1e289 */
+    { 0xBA3E7CA8B77F5E55ULL, 0xA42E74F3D032F525ULL }, /* 1e290 */
+    { 0x28CE1BD2E55F35EBULL, 0xCD3A1230C43FB26FULL }, /* 1e291 */
+    { 0x7980D163CF5B81B3ULL, 0x80444B5E7AA7CF85ULL }, /* 1e292 */
+    { 0xD7E105BCC332621FULL, 0xA0555E361951C366ULL }, /* 1e293 */
+    { 0x8DD9472BF3FEFAA7ULL, 0xC86AB5C39FA63440ULL }, /* 1e294 */
+    { 0xB14F98F6F0FEB951ULL, 0xFA856334878FC150ULL }, /* 1e295 */
+    { 0x6ED1BF9A569F33D3ULL, 0x9C935E00D4B9D8D2ULL }, /* 1e296 */
+    { 0x0A862F80EC4700C8ULL, 0xC3B8358109E84F07ULL }, /* 1e297 */
+    { 0xCD27BB612758C0FAULL, 0xF4A642E14C6262C8ULL }, /* 1e298 */
+    { 0x8038D51CB897789CULL, 0x98E7E9CCCFBD7DBDULL }, /* 1e299 */
+    { 0xE0470A63E6BD56C3ULL, 0xBF21E44003ACDD2CULL }, /* 1e300 */
+    { 0x1858CCFCE06CAC74ULL, 0xEEEA5D5004981478ULL }, /* 1e301 */
+    { 0x0F37801E0C43EBC8ULL, 0x95527A5202DF0CCBULL }, /* 1e302 */
+    { 0xD30560258F54E6BAULL, 0xBAA718E68396CFFDULL }, /* 1e303 */
+    { 0x47C6B82EF32A2069ULL, 0xE950DF20247C83FDULL }, /* 1e304 */
+    { 0x4CDC331D57FA5441ULL, 0x91D28B7416CDD27EULL }, /* 1e305 */
+    { 0xE0133FE4ADF8E952ULL, 0xB6472E511C81471DULL }, /* 1e306 */
+    { 0x58180FDDD97723A6ULL, 0xE3D8F9E563A198E5ULL }, /* 1e307 */
+    { 0x570F09EAA7EA7648ULL, 0x8E679C2F5E44FF8FULL }, /* 1e308 */
+    { 0x2CD2CC6551E513DAULL, 0xB201833B35D63F73ULL }, /* 1e309 */
+    { 0xF8077F7EA65E58D1ULL, 0xDE81E40A034BCF4FULL }, /* 1e310 */
+    { 0xFB04AFAF27FAF782ULL, 0x8B112E86420F6191ULL }, /* 1e311 */
+    { 0x79C5DB9AF1F9B563ULL, 0xADD57A27D29339F6ULL }, /* 1e312 */
+    { 0x18375281AE7822BCULL, 0xD94AD8B1C7380874ULL }, /* 1e313 */
+    { 0x8F2293910D0B15B5ULL, 0x87CEC76F1C830548ULL }, /* 1e314 */
+    { 0xB2EB3875504DDB22ULL, 0xA9C2794AE3A3C69AULL }, /* 1e315 */
+    { 0x5FA60692A46151EBULL, 0xD433179D9C8CB841ULL }, /* 1e316 */
+    { 0xDBC7C41BA6BCD333ULL, 0x849FEEC281D7F328ULL }, /* 1e317 */
+    { 0x12B9B522906C0800ULL, 0xA5C7EA73224DEFF3ULL }, /* 1e318 */
+    { 0xD768226B34870A00ULL, 0xCF39E50FEAE16BEFULL }, /* 1e319 */
+    { 0xE6A1158300D46640ULL, 0x81842F29F2CCE375ULL }, /* 1e320 */
+    { 0x60495AE3C1097FD0ULL, 0xA1E53AF46F801C53ULL }, /* 1e321 */
+    { 0x385BB19CB14BDFC4ULL, 0xCA5E89B18B602368ULL }, /* 1e322 */
+    { 0x46729E03DD9ED7B5ULL, 0xFCF62C1DEE382C42ULL }, /* 1e323 */
+    { 0x6C07A2C26A8346D1ULL, 0x9E19DB92B4E31BA9ULL }, /* 1e324 */
+    { 0xC7098B7305241885ULL, 0xC5A05277621BE293ULL }, /* 1e325 */
+    { 0xB8CBEE4FC66D1EA7ULL, 0xF70867153AA2DB38ULL }, /* 1e326 */
+    { 0x737F74F1DC043328ULL, 0x9A65406D44A5C903ULL }, /* 1e327 */
+    { 0x505F522E53053FF2ULL, 0xC0FE908895CF3B44ULL }, /* 1e328 */
+    { 0x647726B9E7C68FEFULL, 0xF13E34AABB430A15ULL }, /* 1e329 */
+    { 0x5ECA783430DC19F5ULL, 0x96C6E0EAB509E64DULL }, /* 1e330 */
+    { 0xB67D16413D132072ULL, 0xBC789925624C5FE0ULL }, /* 1e331 */
+    { 0xE41C5BD18C57E88FULL, 0xEB96BF6EBADF77D8ULL }, /* 1e332 */
+    { 0x8E91B962F7B6F159ULL, 0x933E37A534CBAAE7ULL }, /* 1e333 */
+    { 0x723627BBB5A4ADB0ULL, 0xB80DC58E81FE95A1ULL }, /* 1e334 */
+    { 0xCEC3B1AAA30DD91CULL, 0xE61136F2227E3B09ULL }, /* 1e335 */
+    { 0x213A4F0AA5E8A7B1ULL, 0x8FCAC257558EE4E6ULL }, /* 1e336 */
+    { 0xA988E2CD4F62D19DULL, 0xB3BD72ED2AF29E1FULL }, /* 1e337 */
+    { 0x93EB1B80A33B8605ULL, 0xE0ACCFA875AF45A7ULL }, /* 1e338 */
+    { 0xBC72F130660533C3ULL, 0x8C6C01C9498D8B88ULL }, /* 1e339 */
+    { 0xEB8FAD7C7F8680B4ULL, 0xAF87023B9BF0EE6AULL }, /* 1e340 */
+    { 0xA67398DB9F6820E1ULL, 0xDB68C2CA82ED2A05ULL }, /* 1e341 */
+    { 0x88083F8943A1148CULL, 0x892179BE91D43A43ULL }, /* 1e342 */
+    { 0x6A0A4F6B948959B0ULL, 0xAB69D82E364948D4ULL }, /* 1e343 */
+    { 0x848CE34679ABB01CULL, 0xD6444E39C3DB9B09ULL }, /* 1e344 */
+    { 0xF2D80E0C0C0B4E11ULL, 0x85EAB0E41A6940E5ULL }, /* 1e345 */
+    { 0x6F8E118F0F0E2195ULL, 0xA7655D1D2103911FULL }, /* 1e346 */
+    { 0x4B7195F2D2D1A9FBULL, 0xD13EB46469447567ULL }, /* 1e347 */
+};
+
+#define JULE_POW10_128_MIN_EXP (-348)
+#define JULE_POW10_128_MAX_EXP (347)
+
+static const double jule_exact_pow10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+static inline void jule_mul_64x64(unsigned long long a, unsigned long long b, unsigned long long *hi, unsigned long long *lo) {
+    unsigned long long a_lo;
+    unsigned long long a_hi;
+    unsigned long long b_lo;
+    unsigned long long b_hi;
+    unsigned long long p0;
+    unsigned long long p1;
+    unsigned long long p2;
+    unsigned long long p3;
+    unsigned long long mid;
+
+    a_lo = a & 0xffffffffULL;
+    a_hi = a >> 32;
+    b_lo = b & 0xffffffffULL;
+    b_hi = b >> 32;
+
+    p0 = a_lo * b_lo;
+    p1 = a_lo * b_hi;
+    p2 = a_hi * b_lo;
+    p3 = a_hi * b_hi;
+
+    mid = (p0 >> 32) + (p1 & 0xffffffffULL) + (p2 & 0xffffffffULL);
+
+    *lo = (mid << 32) | (p0 & 0xffffffffULL);
+    *hi = p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+}
+
+/* Returns 0 when the result can't be determined cheaply. */
+static int jule_eisel_lemire(unsigned long long man, int exp10, int neg, double *out) {
+    int                clz;
+    unsigned long long exp2;
+    unsigned long long x_hi;
+    unsigned long long x_lo;
+    unsigned long long y_hi;
+    unsigned long long y_lo;
+    unsigned long long merged_hi;
+    unsigned long long merged_lo;
+    unsigned long long msb;
+    unsigned long long ret_man;
+    unsigned long long bits;
+    const unsigned long long *pow;
+
+    if (exp10 < JULE_POW10_128_MIN_EXP || exp10 > JULE_POW10_128_MAX_EXP) { return 0; }
+
+    clz   = __builtin_clzll(man);
+    man <<= clz;
+    exp2  = (unsigned long long)(((217706LL * exp10) >> 16) + 64 + 1023) - clz;
+    pow   = jule_pow10_128[exp10 - JULE_POW10_128_MIN_EXP];
+
+    jule_mul_64x64(man, pow[1], &x_hi, &x_lo);
+
+    if ((x_hi & 0x1ff) == 0x1ff && x_lo + man < man) {
+        jule_mul_64x64(man, pow[0], &y_hi, &y_lo);
+
+        merged_hi = x_hi;
+        merged_lo = x_lo + y_hi;
+        if (merged_lo < x_lo) { merged_hi += 1; }
+
+        if ((merged_hi & 0x1ff) == 0x1ff && merged_lo + 1 == 0 && y_lo + man < man) { return 0; }
+
+        x_hi = merged_hi;
+        x_lo = merged_lo;
+    }
+
+    msb      = x_hi >> 63;
+    ret_man  = x_hi >> (msb + 9);
+    exp2    -= 1 ^ msb;
+
+    if (x_lo == 0 && (x_hi & 0x1ff) == 0 && (ret_man & 3) == 1) { return 0; }
+
+    ret_man += ret_man & 1;
+    ret_man >>= 1;
+    if (ret_man >> 53) {
+        ret_man >>= 1;
+        exp2    += 1;
+    }
+
+    /* Subnormals, infinities and NaNs are left to strtod(). */
+    if (exp2 - 1 >= 0x7ff - 1) { return 0; }
+
+    bits = (exp2 << 52) | (ret_man & 0x000fffffffffffffULL);
+    if (neg) { bits |= 0x8000000000000000ULL; }
+
+    memcpy(out, &bits, sizeof(*out));
+
+    return 1;
+}
+
+/* Returns the number of characters consumed, or 0 if s doesn't start with a
+ * number. */
+static unsigned long long jule_parse_number(const char *s, unsigned long long len, double *out) {
+    unsigned long long i;
+    unsigned long long j;
+    int                neg;
+    int                any;
+    int                trunc;
+    int                n_digits;
+    unsigned long long man;
+    long long          exp10;
+    long long          e;
+    int                eneg;
+    int                d;
+    char              *copy;
+
+    i        = 0;
+    neg      = 0;
+    any      = 0;
+    trunc    = 0;
+    n_digits = 0;
+    man      = 0;
+    exp10    = 0;
+
+    if (i < len && (s[i] == '-' || s[i] == '+')) {
+        neg  = s[i] == '-';
+        i   += 1;
+    }
+
+    for (; i < len && DIG(s[i]); i += 1) {
+        any = 1;
+        d   = s[i] - '0';
+        if (man == 0 && d == 0) { continue; }
+        if (n_digits < 19) {
+            man       = man * 10 + d;
+            n_digits += 1;
+        } else {
+            trunc  = 1;
+            exp10 += 1;
+        }
+    }
+
+    if (i < len && s[i] == '.') {
+        i += 1;
+        for (; i < len && DIG(s[i]); i += 1) {
+            any = 1;
+            d   = s[i] - '0';
+            if (man == 0 && d == 0) {
+                exp10 -= 1;
+            } else if (n_digits < 19) {
+                man       = man * 10 + d;
+                n_digits += 1;
+                exp10    -= 1;
+            } else {
+                trunc = 1;
+            }
+        }
+    }
+
+    if (!any) { return 0; }
+
+    if (i < len && (s[i] == 'e' || s[i] == 'E')) {
+        j    = i + 1;
+        eneg = 0;
+
+        if (j < len && (s[j] == '-' || s[j] == '+')) {
+            eneg  = s[j] == '-';
+            j    += 1;
+        }
+
+        if (j < len && DIG(s[j])) {
+            e = 0;
+            for (; j < len && DIG(s[j]); j += 1) {
+                if (e < 100000) { e = e * 10 + (s[j] - '0'); }
+            }
+            exp10 += eneg ? -e : e;
+            i      = j;
+        }
+    }
+
+    if (man == 0) {
+        *out = neg ? -0.0 : 0.0;
+        return i;
+    }
+
+    if (!trunc) {
+        if (exp10 >= -22 && exp10 <= 22 && man <= (1ULL << 53)) {
+            *out = exp10 < 0
+                    ? (double)man / jule_exact_pow10[-exp10]
+                    : (double)man * jule_exact_pow10[exp10];
+            if (neg) { *out = -*out; }
+            return i;
+        }
+
+        if (jule_eisel_lemire(man, exp10, neg, out)) { return i; }
+    }
+
+    copy = jule_charptr_ndup(s, i);
+    *out = strtod(copy, NULL);
+    JULE_FREE(copy);
+
+    return i;
+}
+
+/* Same as jule_parse_number(), but for integers (no fraction or exponent).
+ * Values that don't fit in 64 bits saturate like strtoll(). */
+static unsigned long long jule_parse_integer(const char *s, unsigned long long len, long long *out) {
+    unsigned long long i;
+    int                neg;
+    unsigned long long u;
+    unsigned long long start;
+    char              *copy;
+
+    i   = 0;
+    neg = 0;
+    u   = 0;
+
+    if (i < len && (s[i] == '-' || s[i] == '+')) {
+        neg  = s[i] == '-';
+        i   += 1;
+    }
+
+    start = i;
+
+    for (; i < len && DIG(s[i]); i += 1) {
+        u = u * 10 + (s[i] - '0');
+    }
+
+    if (i == start) { return 0; }
+
+    if (i - start > 18) {
+        copy = jule_charptr_ndup(s, i);
+        *out = strtoll(copy, NULL, 10);
+        JULE_FREE(copy);
+        return i;
+    }
+
+    *out = neg ? -(long long)u : (long long)u;
+
+    return i;
+}
+
+/* Parses the leading number of a string value the way "%lg" would: leading
+ * whitespace is skipped and trailing characters are ignored. */
+static int jule_parse_float_chars(const char *s, unsigned long long len, double *out) {
+    unsigned long long  i;
+    unsigned long long  n;
+    char               *copy;
+    char               *end;
+
+    for (i = 0; i < len && SPC(s[i]); i += 1);
+
+    n = jule_parse_number(s + i, len - i, out);
+
+    /* Hex floats, inf and nan. */
+    if (n == 0 || (i + n < len && (s[i + n] == 'x' || s[i + n] == 'X'))) {
+        copy = jule_charptr_ndup(s + i, len - i);
+        *out = strtod(copy, &end);
+        n    = end - copy;
+        JULE_FREE(copy);
+    }
+
+    return n > 0;
+}
+
+static int jule_parse_int_chars(const char *s, unsigned long long len, long long *out) {
+    unsigned long long i;
+
+    for (i = 0; i < len && SPC(s[i]); i += 1);
+
+    return jule_parse_integer(s + i, len - i, out) > 0;
+}
+
+/*
+ * Tokenizer scanning
+ *
+ * These return the first byte in [p, end) that ends the current run (or end)
+ * and look at 32 (AVX2) or 16 (SSE2) bytes at a time, with a scalar loop for
+ * the tail and for other targets. NUL bytes stop every scan since PEEK_CHAR()
+ * treats them as the end of input.
+ */
+#if defined(__AVX2__)
+typedef __m256i Jule_Vec;
+#define JULE_VEC_BYTES       (32)
+#define JULE_VEC_LOAD(_p)    (_mm256_loadu_si256((const __m256i*)(_p)))
+#define JULE_VEC_SET1(_c)    (_mm256_set1_epi8((_c)))
+#define JULE_VEC_EQ(_a, _b)  (_mm256_cmpeq_epi8((_a), (_b)))
+#define JULE_VEC_OR(_a, _b)  (_mm256_or_si256((_a), (_b)))
+#define JULE_VEC_AND(_a, _b) (_mm256_and_si256((_a), (_b)))
+#define JULE_VEC_SUB(_a, _b) (_mm256_sub_epi8((_a), (_b)))
+#define JULE_VEC_MIN(_a, _b) (_mm256_min_epu8((_a), (_b)))
+#define JULE_VEC_MASK(_v)    ((unsigned)_mm256_movemask_epi8((_v)))
+#define JULE_VEC_ALL         (0xffffffffu)
+#elif defined(__SSE2__)
+typedef __m128i Jule_Vec;
+#define JULE_VEC_BYTES       (16)
+#define JULE_VEC_LOAD(_p)    (_mm_loadu_si128((const __m128i*)(_p)))
+#define JULE_VEC_SET1(_c)    (_mm_set1_epi8((_c)))
+#define JULE_VEC_EQ(_a, _b)  (_mm_cmpeq_epi8((_a), (_b)))
+#define JULE_VEC_OR(_a, _b)  (_mm_or_si128((_a), (_b)))
+#define JULE_VEC_AND(_a, _b) (_mm_and_si128((_a), (_b)))
+#define JULE_VEC_SUB(_a, _b) (_mm_sub_epi8((_a), (_b)))
+#define JULE_VEC_MIN(_a, _b) (_mm_min_epu8((_a), (_b)))
+#define JULE_VEC_MASK(_v)    ((unsigned)_mm_movemask_epi8((_v)))
+#define JULE_VEC_ALL         (0xffffu)
+#endif
+
+#ifdef JULE_VEC_BYTES
+/* Bytes that are '\t', '\n', '\v', '\f' or '\r' (9 through 13). */
+#define JULE_VEC_CTRL_SPACE(_v)                                               \
+    (JULE_VEC_EQ(JULE_VEC_MIN(JULE_VEC_SUB((_v), JULE_VEC_SET1(9)), JULE_VEC_SET1(4)), \
+                 JULE_VEC_SUB((_v), JULE_VEC_SET1(9))))
+#endif
+
+/* Stops at '"', '\\', '\n' and NUL. */
+static inline const char *jule_scan_string(const char *p, const char *end) {
+#ifdef JULE_VEC_BYTES
+    Jule_Vec v;
+    unsigned mask;
+
+    while (end - p >= JULE_VEC_BYTES) {
+        v    = JULE_VEC_LOAD(p);
+        mask = JULE_VEC_MASK(JULE_VEC_OR(JULE_VEC_OR(JULE_VEC_EQ(v, JULE_VEC_SET1('"')),
+                                                     JULE_VEC_EQ(v, JULE_VEC_SET1('\\'))),
+                                         JULE_VEC_OR(JULE_VEC_EQ(v, JULE_VEC_SET1('\n')),
+                                                     JULE_VEC_EQ(v, JULE_VEC_SET1(0)))));
+        if (mask) { return p + __builtin_ctz(mask); }
+        p += JULE_VEC_BYTES;
+    }
+#endif
+
+    while (p < end && *p != '"' && *p != '\\' && *p != '\n' && *p != 0) { p += 1; }
+
+    return p;
+}
+
+/* Stops at whitespace, '#', '(', ')' and NUL. */
+static inline const char *jule_scan_symbol(const char *p, const char *end) {
+#ifdef JULE_VEC_BYTES
+    Jule_Vec v;
+    unsigned mask;
+
+    while (end - p >= JULE_VEC_BYTES) {
+        v    = JULE_VEC_LOAD(p);
+        mask = JULE_VEC_MASK(JULE_VEC_OR(JULE_VEC_OR(JULE_VEC_OR(JULE_VEC_EQ(v, JULE_VEC_SET1(' ')),
+                                                                 JULE_VEC_EQ(v, JULE_VEC_SET1('#'))),
+                                                     JULE_VEC_OR(JULE_VEC_EQ(v, JULE_VEC_SET1('(')),
+                                                                 JULE_VEC_EQ(v, JULE_VEC_SET1(')')))),
+                                         JULE_VEC_OR(JULE_VEC_EQ(v, JULE_VEC_SET1(0)),
+                                                     JULE_VEC_CTRL_SPACE(v))));
+        if (mask) { return p + __builtin_ctz(mask); }
+        p += JULE_VEC_BYTES;
+    }
+#endif
+
+    while (p < end && *p != 0 && !SPC(*p) && *p != '#' && *p != '(' && *p != ')') { p += 1; }
+
+    return p;
+}
+
+/* Stops at anything that isn't whitespace, and at '\n'. */
+static inline const char *jule_scan_ws(const char *p, const char *end) {
+#ifdef JULE_VEC_BYTES
+    Jule_Vec v;
+    Jule_Vec ws;
+    unsigned mask;
+
+    while (end - p >= JULE_VEC_BYTES) {
+        v    = JULE_VEC_LOAD(p);
+        ws   = JULE_VEC_OR(JULE_VEC_EQ(v, JULE_VEC_SET1(' ')), JULE_VEC_CTRL_SPACE(v));
+        mask = (~JULE_VEC_MASK(ws) & JULE_VEC_ALL) | JULE_VEC_MASK(JULE_VEC_EQ(v, JULE_VEC_SET1('\n')));
+        if (mask) { return p + __builtin_ctz(mask); }
+        p += JULE_VEC_BYTES;
+    }
+#endif
+
+    while (p < end && *p != '\n' && SPC(*p)) { p += 1; }
+
+    return p;
+}
+
 static Jule_Token jule_parse_token(Jule_Parse_Context *cxt) {
     int         c;
-    int         last;
     const char *start;
 
     if (!PEEK_CHAR(cxt, c)) { return JULE_TK_NONE; }
@@ -1967,11 +4272,19 @@ static Jule_Token jule_parse_token(Jule_Parse_Context *cxt) {
         NEXT(cxt);
         return JULE_TK_RPAREN;
     } else if (c == '"') {
-        do {
-            if (c == '\n') { return JULE_TK_EOS_ERR; }
-            last = c;
+        NEXT(cxt);
+
+        for (;;) {
+            cxt->cursor = jule_scan_string(cxt->cursor, cxt->end);
+
+            if (!PEEK_CHAR(cxt, c) || c == '\n') { return JULE_TK_EOS_ERR; }
+            if (c == '"')                        { break;                 }
+
+            /* Skip the escaped character. */
+            NEXT(cxt);
+            if (!PEEK_CHAR(cxt, c) || c == '\n') { return JULE_TK_EOS_ERR; }
             NEXT(cxt);
-        } while (PEEK_CHAR(cxt, c) && (c != '"' || last == '\\'));
+        }
 
         NEXT(cxt);
 
@@ -1991,16 +4304,8 @@ digits:;
         return JULE_TK_NUMBER;
     }
 
-    start = cxt->cursor;
-
-    while (PEEK_CHAR(cxt, c)
-    &&     !SPC(c)
-    &&     c != '#'
-    &&     c != '('
-    &&     c != ')') {
-
-        NEXT(cxt);
-    }
+    start       = cxt->cursor;
+    cxt->cursor = jule_scan_symbol(cxt->cursor, cxt->end);
 
     if (cxt->cursor > start) {
         return JULE_TK_SYMBOL;
@@ -2010,31 +4315,23 @@ digits:;
 }
 
 static int jule_trim_leading_ws(Jule_Parse_Context *cxt) {
-    int w;
-    int c;
-
-    w = 0;
+    const char *start;
 
-    while (PEEK_CHAR(cxt, c) && c != '\n' && SPC(c)) {
-        NEXT(cxt);
-        w += 1;
-    }
+    start       = cxt->cursor;
+    cxt->cursor = jule_scan_ws(cxt->cursor, cxt->end);
 
-    return w;
+    return cxt->cursor - start;
 }
 
 static void jule_push_tree(Jule_Parse_Context *cxt) {
     Jule_Value *value;
 
-    value = _jule_value();
-    value->type        = _JULE_TREE;
-    value->ind_level   = cxt->ind;
-    value->line        = cxt->line;
-    value->col         = cxt->col;
+    value = jule_arena_value(cxt->arena, _JULE_TREE);
     value->eval_values = JULE_ARRAY_INIT;
     value->eval_values = jule_array_set_aux(value->eval_values, (void*)cxt->interp->cur_file);
 
     cxt->stack = jule_push(cxt->stack, value);
+    cxt->inds  = jule_push(cxt->inds, (void*)(intptr_t)cxt->ind);
 }
 
 static void jule_ensure_top_is_line_leader(Jule_Parse_Context *cxt) {
@@ -2045,26 +4342,23 @@ static void jule_ensure_top_is_line_leader(Jule_Parse_Context *cxt) {
 
     if (top->type == _JULE_TREE_LINE_LEADER) { return; }
 
-    value = _jule_value();
+    value = jule_arena_value(cxt->arena, top->type);
     memcpy(value, top, sizeof(*value));
     memset(top, 0, sizeof(*top));
     top->type        = _JULE_TREE_LINE_LEADER;
-    top->ind_level   = value->ind_level;
-    top->line        = value->line;
-    top->col         = value->col;
+    top->in_arena    = 1;
+    top->loc         = value->loc;
     top->eval_values = jule_push(top->eval_values, value);
     top->eval_values = jule_array_set_aux(top->eval_values, (void*)cxt->interp->cur_file);
 }
 
 static int jule_consume_comment(Jule_Parse_Context *cxt) {
-    int c;
+    int         c;
+    const char *nl;
 
     if (PEEK_CHAR(cxt, c) && c == '#') {
-        NEXT(cxt);
-        while (PEEK_CHAR(cxt, c)) {
-            if (c == '\n') { break; }
-            NEXT(cxt);
-        }
+        nl          = memchr(cxt->cursor, '\n', cxt->end - cxt->cursor);
+        cxt->cursor = nl == NULL ? cxt->end : nl;
         return 1;
     }
 
@@ -2075,6 +4369,7 @@ static Jule_Status jule_parse_next_value(Jule_Parse_Context *cxt, Jule_Value **v
     int                 status;
     Jule_Value         *val;
     int                 start_col;
+    unsigned            loc;
     const char         *tk_start;
     Jule_Token          tk;
     const char         *tk_end;
@@ -2083,7 +4378,7 @@ static Jule_Status jule_parse_next_value(Jule_Parse_Context *cxt, Jule_Value **v
     int                 c;
     char               *sbuff;
     unsigned long long  slen;
-    char                d_copy[128];
+    const char         *s_end;
     double              d;
 
     status  = JULE_SUCCESS;
@@ -2098,11 +4393,8 @@ static Jule_Status jule_parse_next_value(Jule_Parse_Context *cxt, Jule_Value **v
     if ((tk = jule_parse_token(cxt)) == JULE_TK_NONE) { goto out; }
     tk_end = cxt->cursor;
 
-    if (cxt->col >= (1 << JULE_MAX_COL_POT)) {
-        PARSE_ERR_RET(cxt->interp, JULE_ERR_LINE_TOO_LONG, cxt->line, cxt->col);
-    }
-
     start_col = cxt->col;
+    loc       = tk_start - cxt->start + cxt->base + 1;
 
     if (tk == JULE_TK_LPAREN) {
         jule_push_tree(cxt);
@@ -2118,15 +4410,18 @@ static Jule_Status jule_parse_next_value(Jule_Parse_Context *cxt, Jule_Value **v
         }
 
         if (status != JULE_SUCCESS) {
-            PARSE_ERR_RET(cxt->interp, status, cxt->line, cxt->col);
+            jule_arena_seal(cxt->arena, top);
+            PARSE_ERR_RET(cxt, status, cxt->line, cxt->col);
         }
 
         if (*tkout != JULE_TK_RPAREN) {
-            PARSE_ERR_RET(cxt->interp, JULE_ERR_MISSING_RPAREN, cxt->line, cxt->col);
+            jule_arena_seal(cxt->arena, top);
+            PARSE_ERR_RET(cxt, JULE_ERR_MISSING_RPAREN, cxt->line, cxt->col);
         }
 
         if (jule_len(top->eval_values) == 0) {
-            PARSE_ERR_RET(cxt->interp, JULE_ERR_EMPTY_PARENS, cxt->line, cxt->col - 1);
+            jule_arena_seal(cxt->arena, top);
+            PARSE_ERR_RET(cxt, JULE_ERR_EMPTY_PARENS, cxt->line, cxt->col - 1);
         }
 
         cxt->plevel -= 1;
@@ -2134,11 +4429,12 @@ static Jule_Status jule_parse_next_value(Jule_Parse_Context *cxt, Jule_Value **v
         *tkout = JULE_TK_LPAREN;
 
         jule_pop(cxt->stack);
+        jule_pop(cxt->inds);
 
         goto out_val;
     } else if (tk == JULE_TK_RPAREN) {
         if (cxt->plevel <= 0) {
-            PARSE_ERR_RET(cxt->interp, JULE_ERR_EXTRA_RPAREN, cxt->line, cxt->col);
+            PARSE_ERR_RET(cxt, JULE_ERR_EXTRA_RPAREN, cxt->line, cxt->col);
         }
 
         *tkout = JULE_TK_RPAREN;
@@ -2154,19 +4450,26 @@ static Jule_Status jule_parse_next_value(Jule_Parse_Context *cxt, Jule_Value **v
     switch (tk) {
         case JULE_TK_SYMBOL:
             if (tk_end - tk_start == 3 && strncmp(tk_start, "nil", tk_end - tk_start) == 0) {
-                val = jule_nil_value();
+                val = jule_arena_value(cxt->arena, JULE_NIL);
             } else {
-                sbuff = alloca(tk_end - tk_start + 1);
-                memcpy(sbuff, tk_start, tk_end - tk_start);
-                sbuff[tk_end - tk_start] = 0;
-                val = jule_symbol_value(cxt->interp, sbuff);
+                val            = jule_arena_value(cxt->arena, JULE_SYMBOL);
+                val->symbol_id = jule_get_string_id_n_in(cxt->strings == NULL ? cxt->interp->strings : cxt->strings,
+                                                         tk_start, tk_end - tk_start);
             }
             break;
         case JULE_TK_STRING:
             JULE_ASSERT(tk_start[0] == '"' && "string doesn't start with quote");
             tk_start += 1;
 
-            sbuff = alloca(tk_end - tk_start + 1);
+            /* Literals without escapes are created straight from the source. */
+            for (s_end = tk_start; s_end < tk_end && *s_end != '"' && *s_end != '\\'; s_end += 1);
+
+            if (s_end >= tk_end || *s_end == '"') {
+                val = jule_arena_string_value_n(cxt->arena, tk_start, s_end - tk_start);
+                break;
+            }
+
+            sbuff = JULE_MALLOC(tk_end - tk_start + 1);
             slen  = 0;
 
             for (; tk_start < tk_end; tk_start += 1) {
@@ -2208,16 +4511,15 @@ add_char:;
 
             sbuff[slen] = 0;
 
-            val = jule_string_value(cxt->interp, sbuff);
+            val = jule_arena_string_value_consume(cxt->arena, sbuff, slen);
             break;
         case JULE_TK_NUMBER:
-            strncpy(d_copy, tk_start, tk_end - tk_start);
-            d_copy[tk_end - tk_start] = 0;
-            sscanf(d_copy, "%lg", &d);
-            val = jule_number_value(d);
+            jule_parse_number(tk_start, tk_end - tk_start, &d);
+            val         = jule_arena_value(cxt->arena, JULE_NUMBER);
+            val->number = d;
             break;
         case JULE_TK_EOS_ERR:
-            PARSE_ERR_RET(cxt->interp, JULE_ERR_UNEXPECTED_EOS, cxt->line, start_col + (tk_end - tk_start));
+            PARSE_ERR_RET(cxt, JULE_ERR_UNEXPECTED_EOS, cxt->line, start_col + (tk_end - tk_start));
             break;
         default:
             break;
@@ -2227,9 +4529,7 @@ out_val:;
 
     JULE_ASSERT(val != NULL);
 
-    val->ind_level = cxt->ind;
-    val->line      = cxt->line;
-    val->col       = start_col;
+    val->loc = loc;
 
     *valout = val;
 
@@ -2237,32 +4537,133 @@ out:;
     return status;
 }
 
-static Jule_Status jule_parse_line(Jule_Parse_Context *cxt) {
-    int         status;
-    int         c;
-    Jule_Value *top;
-    int         first;
-    Jule_Value *val;
-    Jule_Token  tk;
+/*
+ * Lazy function bodies
+ *
+ * A line that starts with fn or localfn and names the function is usually
+ * followed by an indented body. Rather than parsing it, the parser copies
+ * the body's text into the arena and appends a single _JULE_LAZY node to
+ * the definition. The body is parsed by jule_expand_lazy() the first time
+ * the node is evaluated, i.e. when the function is first called, so bodies
+ * that are never run cost little more than a memcpy. The node remembers
+ * where the text came from so that the parsed nodes get the same locations
+ * (and parse errors the same line numbers) as an eager parse would give.
+ */
+
+static void jule_defer_body(Jule_Parse_Context *cxt) {
+    const char     *p;
+    const char     *line_start;
+    const char     *nl;
+    const char     *body_end;
+    size_t          rest;
+    unsigned        n_lines;
+    unsigned        n_body_lines;
+    unsigned        save_n_lines;
+    unsigned        len;
+    Jule_Lazy_Body *lazy;
+    Jule_Value     *val;
+    Jule_Value     *top;
+
+    p            = cxt->cursor;
+    body_end     = p;
+    n_lines      = 0;
+    n_body_lines = 0;
+    save_n_lines = cxt->lines == NULL ? 0 : cxt->lines->n_lines;
+
+    /* The body runs up to the last line indented deeper than the definition.
+     * Blank and comment lines don't end it. */
+    while (p < cxt->end) {
+        line_start = p;
+        p          = jule_scan_ws(p, cxt->end);
+
+        if (p >= cxt->end) {
+            nl = cxt->end;
+        } else {
+            rest = (size_t)(cxt->end - p);
+            nl   = memchr(p, '\n', rest);
+            nl   = nl == NULL ? cxt->end : nl + 1;
+        }
 
-    status = JULE_SUCCESS;
+        if (p < cxt->end && *p != '\n' && *p != '#') {
+            if (p - line_start <= cxt->ind) { break; }
+
+            body_end     = nl;
+            n_body_lines = n_lines + 1;
+        }
+
+        if (cxt->lines != NULL) {
+            jule_line_table_push(cxt->lines, line_start - cxt->start + cxt->base);
+        }
+        n_lines += 1;
+
+        p = nl;
+    }
+
+    if (cxt->lines != NULL) {
+        cxt->lines->n_lines = save_n_lines + n_body_lines;
+    }
+
+    if (n_body_lines == 0) { return; }
+
+    len  = body_end - cxt->cursor;
+    lazy = jule_arena_alloc(cxt->arena, sizeof(*lazy) + len);
+
+    lazy->file  = cxt->interp->cur_file;
+    lazy->nodes = NULL;
+    lazy->base  = cxt->cursor - cxt->start + cxt->base;
+    lazy->line  = cxt->line + 1;
+    lazy->len   = len;
+    memcpy(lazy->src, cxt->cursor, len);
+
+    val       = jule_arena_value(cxt->arena, _JULE_LAZY);
+    val->lazy = lazy;
+    val->loc  = lazy->base + 1;
+
+    jule_ensure_top_is_line_leader(cxt);
+    top              = jule_top(cxt->stack);
+    top->eval_values = jule_push(top->eval_values, val);
+
+    cxt->line   += n_body_lines;
+    cxt->cursor  = body_end;
+}
+
+static Jule_Status jule_parse_line(Jule_Parse_Context *cxt) {
+    int         status;
+    int         c;
+    Jule_Value *top;
+    int         first;
+    Jule_Value *val;
+    Jule_Token  tk;
+    int         is_fn;
+    int         n_vals;
+
+    status = JULE_SUCCESS;
 
     cxt->ind = jule_trim_leading_ws(cxt);
     cxt->col = 1 + cxt->ind;
     first    = 1;
+    is_fn    = 0;
+    n_vals   = 0;
 
     if (!PEEK_CHAR(cxt, c))                     { goto done; }
     if (c == '\n' || jule_consume_comment(cxt)) { goto eol;  }
 
     while ((top = jule_top(cxt->stack)) != NULL
-    &&     cxt->ind <= top->ind_level) {
+    &&     cxt->ind <= (intptr_t)jule_top(cxt->inds)) {
 
         jule_pop(cxt->stack);
+        jule_pop(cxt->inds);
     }
 
     val = NULL;
     while ((status = jule_parse_next_value(cxt, &val, &tk)) == JULE_SUCCESS && val != NULL) {
+        n_vals += 1;
+
         if (first) {
+            is_fn = cxt->lazy
+                 && val->type == JULE_SYMBOL
+                 && (val->symbol_id == cxt->fn_id || val->symbol_id == cxt->localfn_id);
+
             if (top != NULL) {
                 jule_ensure_top_is_line_leader(cxt);
                 top->eval_values = jule_push(top->eval_values, val);
@@ -2270,6 +4671,7 @@ static Jule_Status jule_parse_line(Jule_Parse_Context *cxt) {
                 cxt->roots = jule_push(cxt->roots, val);
             }
             cxt->stack = jule_push(cxt->stack, val);
+            cxt->inds  = jule_push(cxt->inds, (void*)(intptr_t)cxt->ind);
             top = val;
         } else {
             jule_ensure_top_is_line_leader(cxt);
@@ -2280,7 +4682,7 @@ static Jule_Status jule_parse_line(Jule_Parse_Context *cxt) {
     }
 
     if (status != JULE_SUCCESS) {
-        PARSE_ERR_RET(cxt->interp, status, cxt->line, cxt->col);
+        PARSE_ERR_RET(cxt, status, cxt->line, cxt->col);
     }
 
 eol:;
@@ -2288,15 +4690,240 @@ eol:;
         if (c == '\n') {
             NEXT(cxt);
         } else {
-            PARSE_ERR_RET(cxt->interp, JULE_ERR_UNEXPECTED_TOK, cxt->line, cxt->col);
+            PARSE_ERR_RET(cxt, JULE_ERR_UNEXPECTED_TOK, cxt->line, cxt->col);
         }
     }
 
+    if (is_fn && n_vals >= 2) {
+        jule_defer_body(cxt);
+    }
+
 done:;
     return status;
 }
 
-static void _jule_string_print(Jule_Interp *interp, char **buff, int *len, int *cap, const Jule_Value *value, unsigned ind, int flags) {
+/* d * 10^exp10, rounded along the way. */
+static double jule_scale_pow10(double d, int exp10) {
+    while (exp10 > 22)  { d *= 1e22; exp10 -= 22; }
+    while (exp10 < -22) { d /= 1e22; exp10 += 22; }
+
+    return exp10 < 0 ? d / jule_exact_pow10[-exp10] : d * jule_exact_pow10[exp10];
+}
+
+/* Rounds d, which must be finite and positive, to n_digits (<= 15)
+ * significant digits as man * 10^exp10. The scaling is done in floating
+ * point, so when the result lands too close to a rounding tie to be sure of
+ * the direction this gives up and returns 0; otherwise it returns 1. */
+static int jule_round_decimal(double d, int n_digits, unsigned long long *man, int *exp10) {
+    unsigned long long bits;
+    unsigned long long lo;
+    unsigned long long hi;
+    unsigned long long m;
+    int                x;
+    int                q;
+    int                tries;
+    double             v;
+    double             frac;
+
+    /* Guess the decimal exponent from the binary one; log10(2) ~ 78913 / 2^18. */
+    memcpy(&bits, &d, sizeof(bits));
+    x = (int)((bits >> 52) & 0x7ff) - 1023;
+    x = x >= 0 ? (x * 78913) >> 18 : -((-x * 78913 + (1 << 18) - 1) >> 18);
+
+    lo = (unsigned long long)jule_exact_pow10[n_digits - 1];
+    hi = lo * 10;
+
+    for (tries = 0; tries < 3; tries += 1) {
+        q = x - (n_digits - 1);
+        v = jule_scale_pow10(d, -q);
+
+        /* The guess can put the leading digit one place off. This has to
+         * look at the unrounded value: rounding may carry into hi, and that
+         * must not change which digits get rounded. */
+        if (v >= (double)hi) { x += 1; continue; }
+        if (v < (double)lo)  { x -= 1; continue; }
+
+        m    = (unsigned long long)v;
+        frac = v - (double)m;
+
+        if (frac > 0.5 - 1e-14 * (double)hi && frac < 0.5 + 1e-14 * (double)hi) { return 0; }
+
+        m += frac > 0.5;
+
+        if (m == hi) {
+            m  = lo;
+            q += 1;
+        }
+
+        *man   = m;
+        *exp10 = q;
+
+        return 1;
+    }
+
+    return 0;
+}
+
+/* Writes the same text as "%g" into buff, which must hold at least 32 bytes,
+ * and returns its length. Only infinities, NaNs, zeros and near-ties fall
+ * back to snprintf(). */
+static int jule_number_to_chars(double d, char *buff) {
+    long long           i;
+    char                digits[24];
+    int                 n;
+    int                 len;
+    unsigned long long  man;
+    int                 exp10;
+    int                 x;
+    int                 j;
+
+    if (d > -1000000.0 && d < 1000000.0 && d == (double)(i = (long long)d) && !(i == 0 && signbit(d))) {
+        len = 0;
+
+        if (i < 0) {
+            buff[len]  = '-';
+            len       += 1;
+            i          = -i;
+        }
+
+        n = 0;
+        do {
+            digits[n]  = '0' + (i % 10);
+            n         += 1;
+            i         /= 10;
+        } while (i > 0);
+
+        while (n > 0) {
+            n         -= 1;
+            buff[len]  = digits[n];
+            len       += 1;
+        }
+
+        buff[len] = 0;
+
+        return len;
+    }
+
+    if (!isfinite(d) || d == 0.0 || !jule_round_decimal(d < 0 ? -d : d, 6, &man, &exp10)) {
+        return snprintf(buff, 32, "%g", d);
+    }
+
+    n = 6;
+    for (j = n - 1; j >= 0; j -= 1) {
+        digits[j]  = '0' + (man % 10);
+        man       /= 10;
+    }
+
+    while (n > 1 && digits[n - 1] == '0') {
+        n     -= 1;
+        exp10 += 1;
+    }
+
+    x   = exp10 + n - 1;
+    len = 0;
+
+    if (d < 0) {
+        buff[len]  = '-';
+        len       += 1;
+    }
+
+    if (x < -4 || x >= 6) {
+        buff[len]  = digits[0];
+        len       += 1;
+        if (n > 1) {
+            buff[len]  = '.';
+            len       += 1;
+            memcpy(buff + len, digits + 1, n - 1);
+            len       += n - 1;
+        }
+        len += snprintf(buff + len, 32 - len, "e%c%02d", x < 0 ? '-' : '+', x < 0 ? -x : x);
+    } else if (x >= 0) {
+        for (j = 0; j <= x; j += 1) {
+            buff[len]  = j < n ? digits[j] : '0';
+            len       += 1;
+        }
+        if (n > x + 1) {
+            buff[len]  = '.';
+            len       += 1;
+            memcpy(buff + len, digits + x + 1, n - (x + 1));
+            len       += n - (x + 1);
+        }
+        buff[len] = 0;
+    } else {
+        buff[len]     = '0';
+        buff[len + 1] = '.';
+        len          += 2;
+        for (j = 0; j < -x - 1; j += 1) {
+            buff[len]  = '0';
+            len       += 1;
+        }
+        memcpy(buff + len, digits, n);
+        len       += n;
+        buff[len]  = 0;
+    }
+
+    return len;
+}
+
+/*
+ * The printer appends with memcpy() into a buffer that either grows (when
+ * building a string) or is handed to jule_output() whenever it fills up, so
+ * printing a value of any size needs only a fixed amount of memory.
+ */
+
+#define JULE_PRINT_CHUNK_SIZE (4096)
+
+typedef struct {
+    Jule_Interp *interp;
+    char        *buff;
+    int          len;
+    int          cap;
+    int          to_output;
+} Jule_Printer;
+
+static void jule_output(Jule_Interp *interp, const char *s, int n_bytes);
+
+static void jule_printer_make_room(Jule_Printer *p) {
+    if (p->to_output) {
+        jule_output(p->interp, p->buff, p->len);
+        p->len = 0;
+    } else {
+        p->cap  <<= 1;
+        p->buff   = JULE_REALLOC(p->buff, p->cap);
+    }
+}
+
+static void jule_printer_push(Jule_Printer *p, const char *s, int n) {
+    int space;
+
+    while (p->len + n > p->cap) {
+        space = p->cap - p->len;
+        if (p->to_output && space > 0) {
+            memcpy(p->buff + p->len, s, space);
+            p->len += space;
+            s      += space;
+            n      -= space;
+        }
+        jule_printer_make_room(p);
+    }
+
+    memcpy(p->buff + p->len, s, n);
+    p->len += n;
+}
+
+static void jule_printer_pad(Jule_Printer *p, unsigned n) {
+    static const char spaces[] = "                                ";
+    unsigned          chunk;
+
+    while (n > 0) {
+        chunk = n < sizeof(spaces) - 1 ? n : sizeof(spaces) - 1;
+        jule_printer_push(p, spaces, chunk);
+        n -= chunk;
+    }
+}
+
+static void _jule_string_print(Jule_Printer *p, const Jule_Value *value, unsigned ind, int flags) {
+    Jule_Interp        *interp;
     unsigned            i;
     char                b[128];
     const Jule_String  *string;
@@ -2312,216 +4939,1264 @@ static void _jule_string_print(Jule_Interp *interp, char **buff, int *len, int *
 
 #define PUSHC(_c)                               \
 do {                                            \
-    if (*len == *cap) {                         \
-        *cap <<= 1;                             \
-        *buff = JULE_REALLOC(*buff, *cap);      \
+    if (p->len == p->cap) {                     \
+        jule_printer_make_room(p);              \
     }                                           \
-    (*buff)[*len]  = (_c);                      \
-    *len        += 1;                           \
+    p->buff[p->len]  = (_c);                    \
+    p->len          += 1;                       \
 } while (0)
 
-#define PUSHSN(_s, _n)                          \
-do {                                            \
-    for (unsigned _i = 0; _i < (_n); _i += 1) { \
-        PUSHC((_s)[_i]);                        \
-    }                                           \
-} while (0)
+#define PUSHSN(_s, _n) jule_printer_push(p, (_s), (_n))
+
+#define PUSHS(_s) PUSHSN((_s), strlen(_s))
+
+    interp = p->interp;
+
+    if ((value->type != _JULE_TREE) && (value->type != _JULE_TREE_LINE_LEADER) && (value->type != _JULE_LAZY)) {
+        jule_printer_pad(p, ind);
+    }
+
+    switch (value->type) {
+        case JULE_NIL:
+            PUSHS("nil");
+            break;
+        case JULE_NUMBER:
+            PUSHSN(b, jule_number_to_chars(value->number, b));
+            break;
+        case JULE_STRING:
+            if (flags & JULE_NO_QUOTE) {
+                PUSHSN(jule_string_chars(value), jule_string_len(value));
+            } else {
+                PUSHC('"');
+                PUSHSN(jule_string_chars(value), jule_string_len(value));
+                PUSHC('"');
+            }
+            break;
+        case JULE_BUILDER:
+            if (flags & JULE_NO_QUOTE) {
+                PUSHSN(value->builder->chars, value->builder->len);
+            } else {
+                PUSHC('"');
+                PUSHSN(value->builder->chars, value->builder->len);
+                PUSHC('"');
+            }
+            break;
+        case JULE_HANDLE:
+            snprintf(b, sizeof(b), "<%s@%p%s>", value->handle->type->name, (void*)value->handle,
+                     value->handle->data == NULL ? " closed" : "");
+            PUSHS(b);
+            break;
+        case JULE_SYMBOL:
+            string = jule_get_string(interp, value->symbol_id);
+            PUSHS(string->chars);
+            break;
+        case JULE_LIST:
+            PUSHC('[');
+            PUSHC((flags & JULE_MULTILINE) ? '\n' : ' ');
+            FOR_EACH(value->list, child) {
+                _jule_string_print(p, child, (flags & JULE_MULTILINE) ? ind + 2 : 0, flags & ~JULE_NO_QUOTE);
+                PUSHC((flags & JULE_MULTILINE) ? '\n' : ' ');
+            }
+            if (flags & JULE_MULTILINE) {
+                jule_printer_pad(p, ind);
+            }
+            PUSHC(']');
+            break;
+        case JULE_OBJECT:
+            PUSHC('{');
+            PUSHC((flags & JULE_MULTILINE) ? '\n' : ' ');
+            hash_table_traverse((_Jule_Object)value->object, key, val) {
+                _jule_string_print(p, key, (flags & JULE_MULTILINE) ? ind + 2 : 0, flags & ~JULE_NO_QUOTE);
+                PUSHC(':');
+                _jule_string_print(p, *val, (flags & JULE_MULTILINE) ? ind + 2 : 0, flags & ~JULE_NO_QUOTE);
+                PUSHC((flags & JULE_MULTILINE) ? '\n' : ' ');
+            }
+            if (flags & JULE_MULTILINE) {
+                jule_printer_pad(p, ind);
+            }
+            PUSHC('}');
+            break;
+        case _JULE_FN:
+            fsym = NULL;
+
+            for (i = jule_len(interp->local_symtab_stack); i > 0; i -= 1) {
+                hash_table_traverse((_Jule_Symbol_Table)jule_elem(interp->local_symtab_stack, i - 1), sym, val) {
+                    if ((*val) == value) {
+                        fsym = sym;
+                        goto found_fsym;
+                    }
+                }
+            }
+            hash_table_traverse(interp->symtab, sym, val) {
+                if ((*val) == value) {
+                    fsym = sym;
+                    goto found_fsym;
+                }
+            }
+            goto print_tree; /* Not sure that this could ever happen, but just to be safe. */
+found_fsym:;
+            snprintf(b, sizeof(b), "<fn@%p> %s", (void*)value, fsym->chars);
+            PUSHS(b);
+            break;
+        case _JULE_TREE:
+        case _JULE_TREE_LINE_LEADER:
+        case _JULE_LAMBDA:
+print_tree:;
+            if (flags & JULE_MULTILINE) {
+                _jule_string_print(p, value->eval_values->data[0], ind, flags & ~JULE_NO_QUOTE);
+                for (i = 1; i < jule_len(value->eval_values); i += 1) {
+                    PUSHC('\n');
+                    _jule_string_print(p, value->eval_values->data[i], ind + 2, flags & ~JULE_NO_QUOTE);
+                }
+            } else {
+                PUSHC('(');
+                _jule_string_print(p, value->eval_values->data[0], ind, flags & ~JULE_NO_QUOTE);
+                for (i = 1; i < jule_len(value->eval_values); i += 1) {
+                    PUSHC(' ');
+                    _jule_string_print(p, value->eval_values->data[i], 0, flags & ~JULE_NO_QUOTE);
+                }
+                PUSHC(')');
+            }
+            break;
+        case _JULE_LAZY:
+            if (value->lazy->nodes == NULL) {
+                /* Not parsed yet, so show the source. */
+                PUSHSN(value->lazy->src, value->lazy->len - (value->lazy->src[value->lazy->len - 1] == '\n'));
+                break;
+            }
+            for (i = 0; i < jule_len(value->lazy->nodes); i += 1) {
+                if (i > 0) { PUSHC((flags & JULE_MULTILINE) ? '\n' : ' '); }
+                _jule_string_print(p, value->lazy->nodes->data[i], ind, flags & ~JULE_NO_QUOTE);
+            }
+            break;
+        case _JULE_BUILTIN_FN:
+            fsym = NULL;
+            hash_table_traverse(interp->symtab, sym, val) {
+                if ((*val)->type == _JULE_BUILTIN_FN
+                &&  (*val)->builtin_fn == value->builtin_fn) {
+
+                    fsym = sym;
+                    break;
+                }
+            }
+            prfn.f = value->builtin_fn;
+            if (fsym != NULL) {
+                snprintf(b, sizeof(b), "<fn@%p> %s", prfn.v, fsym->chars);
+            } else {
+                snprintf(b, sizeof(b), "<fn@%p>", prfn.v);
+            }
+            PUSHS(b);
+            break;
+        default:
+            JULE_ASSERT(0);
+            break;
+
+    }
+
+#undef PUSHS
+#undef PUSHSN
+#undef PUSHC
+}
+
+char *jule_to_string(Jule_Interp *interp, const Jule_Value *value, int flags) {
+    Jule_Printer p;
+
+    p.interp    = interp;
+    p.buff      = JULE_MALLOC(16);
+    p.len       = 0;
+    p.cap       = 16;
+    p.to_output = 0;
+
+    _jule_string_print(&p, value, 0, flags);
+    jule_printer_push(&p, "", 1);
+
+    return p.buff;
+}
+
+/*
+ * Output
+ *
+ * Everything printed goes through a buffer owned by the interpreter and is
+ * handed to the sink (the data callback, the plain callback or stdout) in
+ * batches. With JULE_OUTPUT_AUTO the buffer is flushed at every newline
+ * when writing to a terminal or a callback, and only when full otherwise.
+ * It is always flushed before an error is reported, when the sink or the
+ * policy changes, by jule_flush_output() and by jule_free().
+ */
+
+#define JULE_OUTPUT_BUFFER_SIZE (64 * 1024)
+
+static void jule_output_write(Jule_Interp *interp, const char *s, int n_bytes) {
+    if (n_bytes <= 0) { return; }
+
+    if (interp->output_data_callback != NULL) {
+        interp->output_data_callback(interp->output_data, s, n_bytes);
+    } else if (interp->output_callback != NULL) {
+        interp->output_callback(s, n_bytes);
+    } else {
+        fwrite(s, 1, n_bytes, stdout);
+        fflush(stdout);
+    }
+}
+
+Jule_Status jule_flush_output(Jule_Interp *interp) {
+    if (interp->output_len > 0) {
+        jule_output_write(interp, interp->output_buff, interp->output_len);
+        interp->output_len = 0;
+    }
+    return JULE_SUCCESS;
+}
+
+static void jule_output(Jule_Interp *interp, const char *s, int n_bytes) {
+    if (interp->output_mode == JULE_OUTPUT_AUTO) {
+        interp->output_mode = interp->output_buffering;
+        if (interp->output_mode == JULE_OUTPUT_AUTO) {
+            interp->output_mode = (interp->output_data_callback != NULL || interp->output_callback != NULL || isatty(1))
+                                    ? JULE_OUTPUT_LINE_BUFFERED
+                                    : JULE_OUTPUT_BLOCK_BUFFERED;
+        }
+    }
+
+    if (interp->output_mode == JULE_OUTPUT_UNBUFFERED) {
+        jule_output_write(interp, s, n_bytes);
+        return;
+    }
+
+    if (interp->output_buff == NULL) {
+        interp->output_buff = JULE_MALLOC(JULE_OUTPUT_BUFFER_SIZE);
+    }
+
+    if (interp->output_len + n_bytes > JULE_OUTPUT_BUFFER_SIZE) {
+        jule_flush_output(interp);
+
+        if (n_bytes >= JULE_OUTPUT_BUFFER_SIZE) {
+            jule_output_write(interp, s, n_bytes);
+            return;
+        }
+    }
+
+    memcpy(interp->output_buff + interp->output_len, s, n_bytes);
+    interp->output_len += n_bytes;
+
+    if (interp->output_mode == JULE_OUTPUT_LINE_BUFFERED && memchr(s, '\n', n_bytes) != NULL) {
+        jule_flush_output(interp);
+    }
+}
+
+static void jule_print(Jule_Interp *interp, Jule_Value *value, unsigned ind) {
+    char         chunk[JULE_PRINT_CHUNK_SIZE];
+    Jule_Printer p;
+
+    /* Strings and builders are written straight from their own buffers. */
+    if (ind == 0) {
+        if (value->type == JULE_STRING) {
+            jule_output(interp, jule_string_chars(value), jule_string_len(value));
+            return;
+        }
+        if (value->type == JULE_BUILDER) {
+            jule_output(interp, value->builder->chars, value->builder->len);
+            return;
+        }
+    }
+
+    p.interp    = interp;
+    p.buff      = chunk;
+    p.len       = 0;
+    p.cap       = sizeof(chunk);
+    p.to_output = 1;
+
+    _jule_string_print(&p, value, ind, JULE_NO_QUOTE | JULE_MULTILINE);
+    jule_output(interp, p.buff, p.len);
+}
+
+static void jule_init_parse_context(Jule_Parse_Context *cxt, Jule_Interp *interp, Jule_Arena *arena, const char *str, int size) {
+    memset(cxt, 0, sizeof(*cxt));
+
+    cxt->interp     = interp;
+    cxt->arena      = arena;
+    cxt->start      = str;
+    cxt->cursor     = str;
+    cxt->end        = str + size;
+    cxt->lazy       = interp->lazy_parse;
+    cxt->fn_id      = jule_get_string_id(interp, "fn");
+    cxt->localfn_id = jule_get_string_id(interp, "localfn");
+}
+
+/* Parse every line of the context's input and seal the resulting roots. */
+static Jule_Status jule_parse_lines(Jule_Parse_Context *cxt) {
+    Jule_Status  status;
+    Jule_Value  *it;
+
+    status = JULE_SUCCESS;
+    while (status == JULE_SUCCESS && MORE_INPUT(cxt)) {
+        cxt->line += 1;
+        if (cxt->lines != NULL) {
+            jule_line_table_push(cxt->lines, cxt->cursor - cxt->start + cxt->base);
+        }
+
+        status = jule_parse_line(cxt);
+    }
+
+    FOR_EACH(cxt->roots, it) {
+        jule_arena_seal(cxt->arena, it);
+    }
+
+    jule_free_array(cxt->stack);
+    jule_free_array(cxt->inds);
+
+    return status;
+}
+
+/*
+ * Parallel parsing
+ *
+ * Roots start at column zero and nothing (parentheses, strings, indented
+ * blocks) continues past a line that starts with a token in column zero, so
+ * a large input can be cut before such lines into chunks that parse
+ * independently. Each chunk gets its own thread, arena, line table and
+ * symbol table. Once all of them are done, the chunk symbol tables are
+ * merged into the interpreter's, symbols in the chunk trees are pointed at
+ * the merged strings, and the arenas, line tables and roots are
+ * concatenated in order.
+ *
+ * Chunks parse quietly. If any of them fails, the results are thrown away
+ * and the input is parsed again on one thread so that the error is reported
+ * exactly as before.
+ */
+
+#define JULE_PARSE_CHUNK_MIN  (1024 * 1024)
+#define JULE_PARSE_MAX_CHUNKS (64)
+
+typedef struct {
+    Jule_Parse_Context  cxt;
+    Jule_Status         status;
+    pthread_t           thread;
+    int                 started;
+} Jule_Parse_Chunk;
+
+static void *jule_parse_chunk(void *arg) {
+    Jule_Parse_Chunk *chunk;
+
+    chunk         = arg;
+    chunk->status = jule_parse_lines(&chunk->cxt);
+
+    return NULL;
+}
+
+/* Point the symbols of a chunk's tree at the interpreter's strings and make
+ * the line numbers of its lazy bodies file-relative. */
+static void jule_fixup_chunk_value(_Jule_String_Table strings, unsigned line_offset, Jule_Value *value) {
+    Jule_Value *child;
+
+    switch (value->type) {
+        case JULE_SYMBOL:
+            value->symbol_id = *hash_table_get_val(strings, value->symbol_id);
+            break;
+        case _JULE_TREE:
+        case _JULE_TREE_LINE_LEADER:
+            FOR_EACH(value->eval_values, child) {
+                jule_fixup_chunk_value(strings, line_offset, child);
+            }
+            break;
+        case _JULE_LAZY:
+            value->lazy->line += line_offset;
+            break;
+    }
+}
+
+/* Returns the start of the first line at or after p that begins with a token. */
+static const char *jule_next_root_line(const char *p, const char *end) {
+    const char *nl;
+
+    while (p < end) {
+        if (!SPC(*p) && *p != '#') { return p; }
+
+        nl = memchr(p, '\n', end - p);
+        if (nl == NULL) { break; }
+
+        p = nl + 1;
+    }
+
+    return end;
+}
+
+/* Returns 1 and appends the roots to out_nodes if every chunk parsed. */
+static int jule_parse_nodes_parallel(Jule_Interp *interp, Jule_Arena *arena, const char *str, int size, int n_chunks, Jule_Array **out_nodes) {
+    int                  ok;
+    Jule_Parse_Chunk    *chunks;
+    const char          *end;
+    const char          *p;
+    const char          *chunk_start;
+    int                  n;
+    int                  i;
+    Jule_Parse_Chunk    *chunk;
+    _Jule_String_Table   strings;
+    Jule_String_ID       key;
+    Jule_String_ID      *valp;
+    Jule_String_ID      *lookup;
+    Jule_Line_Table     *lines;
+    unsigned             line_offset;
+    unsigned             j;
+    Jule_Value          *it;
+
+    ok     = 1;
+    chunks = JULE_MALLOC(n_chunks * sizeof(*chunks));
+    memset(chunks, 0, n_chunks * sizeof(*chunks));
+    end    = str + size;
+    n      = 0;
+
+    chunk_start = str;
+    for (i = 1; i <= n_chunks; i += 1) {
+        if (i == n_chunks) {
+            p = end;
+        } else {
+            p = str + (long long)size * i / n_chunks;
+            if (p <= chunk_start) { continue; }
+
+            /* Back up to the start of the line so that a root beginning
+             * right at p is not skipped. */
+            while (p > chunk_start && *(p - 1) != '\n') { p -= 1; }
+            if (p == chunk_start) { continue; }
+
+            p = jule_next_root_line(p, end);
+        }
+
+        if (p == chunk_start) { continue; }
+
+        chunk = chunks + n;
+        jule_init_parse_context(&chunk->cxt, interp, jule_arena(), chunk_start, p - chunk_start);
+        chunk->cxt.base       = chunk_start - str;
+        chunk->cxt.lines      = jule_line_table();
+        chunk->cxt.quiet      = 1;
+        strings               = hash_table_make_e(Jule_String_ID, Jule_String_ID, jule_string_hash, jule_string_equ);
+        chunk->cxt.strings    = strings;
+        chunk->cxt.fn_id      = jule_get_string_id_n_in(strings, "fn", 2);
+        chunk->cxt.localfn_id = jule_get_string_id_n_in(strings, "localfn", 7);
+        n += 1;
+
+        chunk_start = p;
+    }
+
+    for (i = 0; i < n; i += 1) {
+        chunks[i].started = pthread_create(&chunks[i].thread, NULL, jule_parse_chunk, chunks + i) == 0;
+        if (!chunks[i].started) {
+            jule_parse_chunk(chunks + i);
+        }
+    }
+
+    for (i = 0; i < n; i += 1) {
+        if (chunks[i].started) {
+            pthread_join(chunks[i].thread, NULL);
+        }
+        if (chunks[i].status != JULE_SUCCESS) { ok = 0; }
+    }
+
+    if (ok) {
+        lines       = jule_line_table();
+        line_offset = 0;
+
+        for (i = 0; i < n; i += 1) {
+            chunk   = chunks + i;
+            strings = chunk->cxt.strings;
+
+            hash_table_traverse(strings, key, valp) {
+                lookup = hash_table_get_key(interp->strings, key);
+                if (lookup == NULL) {
+                    hash_table_insert(interp->strings, key, key);
+                } else {
+                    *valp = *lookup;
+                }
+            }
+
+            FOR_EACH(chunk->cxt.roots, it) {
+                jule_fixup_chunk_value(strings, line_offset, it);
+                *out_nodes = jule_push(*out_nodes, it);
+            }
+
+            for (j = 0; j < chunk->cxt.lines->n_lines; j += 1) {
+                jule_line_table_push(lines, chunk->cxt.lines->starts[j]);
+            }
+            line_offset += chunk->cxt.lines->n_lines;
+
+            jule_arena_merge(arena, chunk->cxt.arena);
+            chunk->cxt.arena = NULL;
+        }
+
+        jule_set_line_table(interp, interp->cur_file, lines);
+    }
+
+    for (i = 0; i < n; i += 1) {
+        chunk   = chunks + i;
+        strings = chunk->cxt.strings;
+
+        /* Strings that moved into the interpreter's table map to themselves. */
+        hash_table_traverse(strings, key, valp) {
+            if (!ok || *valp != key) {
+                jule_free_string((Jule_String*)key);
+                JULE_FREE((void*)key);
+            }
+        }
+        hash_table_free(strings);
+
+        if (chunk->cxt.arena != NULL) { jule_free_arena(chunk->cxt.arena); }
+        jule_free_line_table(chunk->cxt.lines);
+        jule_free_array(chunk->cxt.roots);
+    }
+
+    JULE_FREE(chunks);
+
+    return ok;
+}
+
+static int jule_parse_n_chunks(Jule_Interp *interp, int size) {
+    long n;
+
+    n = interp->parse_threads;
+    if (n <= 0) {
+        n = sysconf(_SC_NPROCESSORS_ONLN);
+    }
+
+    if (n > size / JULE_PARSE_CHUNK_MIN) { n = size / JULE_PARSE_CHUNK_MIN; }
+    if (n > JULE_PARSE_MAX_CHUNKS)       { n = JULE_PARSE_MAX_CHUNKS;       }
+    if (n < 1)                           { n = 1;                           }
+
+    return n;
+}
+
+Jule_Status jule_set_parse_threads(Jule_Interp *interp, int n_threads) {
+    interp->parse_threads = n_threads;
+    return JULE_SUCCESS;
+}
+
+static Jule_Status jule_parse_nodes(Jule_Interp *interp, Jule_Arena *arena, const char *str, int size, Jule_Array **out_nodes) {
+    Jule_Parse_Context  cxt;
+    Jule_Status         status;
+    Jule_Value         *it;
+    int                 n_chunks;
+
+    n_chunks = jule_parse_n_chunks(interp, size);
+    if (n_chunks > 1 && jule_parse_nodes_parallel(interp, arena, str, size, n_chunks, out_nodes)) {
+        return JULE_SUCCESS;
+    }
+
+    jule_init_parse_context(&cxt, interp, arena, str, size);
+    cxt.lines = jule_line_table();
+
+    status = jule_parse_lines(&cxt);
+
+    FOR_EACH(cxt.roots, it) {
+        *out_nodes = jule_push(*out_nodes, it);
+    }
+
+    jule_set_line_table(interp, interp->cur_file, cxt.lines);
+
+    jule_free_array(cxt.roots);
+
+    return status;
+}
+
+static Jule_Status jule_expand_lazy(Jule_Interp *interp, Jule_Value *value) {
+    Jule_Status         status;
+    Jule_Lazy_Body     *lazy;
+    Jule_Arena         *arena;
+    Jule_Line_Table    *lines;
+    Jule_String_ID      save_file;
+    Jule_Parse_Context  cxt;
+
+    status = JULE_SUCCESS;
+    lazy   = value->lazy;
+
+    if (lazy->nodes != NULL) { goto out; }
+
+    /* Bodies from a replaced version of a module go in that version's arena
+     * so that they are located with its line table. */
+    arena = jule_old_arena(interp, lazy, &lines);
+
+    if (arena == NULL) {
+        if (interp->lazy_arena == NULL) {
+            interp->lazy_arena = jule_arena();
+            interp->arenas     = jule_push(interp->arenas, interp->lazy_arena);
+        }
+        arena = interp->lazy_arena;
+    }
+
+    save_file        = interp->cur_file;
+    interp->cur_file = lazy->file;
+
+    jule_init_parse_context(&cxt, interp, arena, lazy->src, lazy->len);
+    cxt.base = lazy->base;
+    cxt.line = lazy->line - 1;
+
+    status = jule_parse_lines(&cxt);
+
+    if (status == JULE_SUCCESS) {
+        lazy->nodes = jule_arena_array(arena, cxt.roots);
+    } else {
+        jule_free_array(cxt.roots);
+    }
+
+    interp->cur_file = save_file;
+
+out:;
+    return status;
+}
+
+Jule_Status jule_set_lazy_parse(Jule_Interp *interp, int enabled) {
+    interp->lazy_parse = !!enabled;
+    return JULE_SUCCESS;
+}
+
+Jule_Status jule_parse(Jule_Interp *interp, const char *str, int size) {
+    Jule_Arena *arena;
+
+    arena          = jule_arena();
+    interp->arenas = jule_push(interp->arenas, arena);
+
+    return jule_parse_nodes(interp, arena, str, size, &interp->roots);
+}
+
+/*
+ * Streaming
+ *
+ * jule_parse_stream() takes the input in pieces of any size. A root is
+ * complete once a later line starts with a token in column zero, so every
+ * call parses the buffered input up to the last such line, appends the
+ * roots to interp->roots and keeps only the rest. jule_interp() can be
+ * called in between to run the roots that have arrived so far.
+ * jule_parse_stream_end() parses whatever is left.
+ */
+
+static Jule_Status jule_parse_stream_flush(Jule_Interp *interp, unsigned long long size) {
+    Jule_Parse_Stream  *stream;
+    Jule_Parse_Context  cxt;
+    Jule_Status         status;
+    Jule_Value         *it;
+
+    stream = interp->stream;
+
+    jule_init_parse_context(&cxt, interp, stream->arena, stream->buff, size);
+    cxt.base  = stream->offset;
+    cxt.line  = stream->line;
+    cxt.lines = stream->lines;
+
+    status = jule_parse_lines(&cxt);
+
+    FOR_EACH(cxt.roots, it) {
+        interp->roots = jule_push(interp->roots, it);
+    }
+    jule_free_array(cxt.roots);
+
+    stream->line     = cxt.line;
+    stream->offset  += size;
+    stream->len     -= size;
+    stream->scanned -= size;
+    stream->split    = 0;
+    memmove(stream->buff, stream->buff + size, stream->len);
+
+    return status;
+}
+
+static void jule_free_parse_stream(Jule_Parse_Stream *stream) {
+    if (stream->buff != NULL) { JULE_FREE(stream->buff); }
+    JULE_FREE(stream);
+}
+
+Jule_Status jule_parse_stream(Jule_Interp *interp, const char *str, int size) {
+    Jule_Parse_Stream *stream;
+    const char        *p;
+    const char        *end;
+    const char        *nl;
+
+    if (interp->stream == NULL) {
+        stream = JULE_MALLOC(sizeof(*stream));
+        memset(stream, 0, sizeof(*stream));
+
+        stream->lines  = jule_line_table();
+        stream->arena  = jule_arena();
+        interp->arenas = jule_push(interp->arenas, stream->arena);
+        jule_set_line_table(interp, interp->cur_file, stream->lines);
+
+        interp->stream = stream;
+    }
+
+    stream = interp->stream;
+
+    if (stream->len + size > stream->cap) {
+        stream->cap = stream->cap == 0 ? 4096 : stream->cap;
+        while (stream->cap < stream->len + size) { stream->cap *= 2; }
+        stream->buff = JULE_REALLOC(stream->buff, stream->cap);
+    }
+
+    memcpy(stream->buff + stream->len, str, size);
+    stream->len += size;
+
+    p   = stream->buff + stream->scanned;
+    end = stream->buff + stream->len;
+
+    while ((nl = memchr(p, '\n', end - p)) != NULL && nl + 1 < end) {
+        if (!SPC(nl[1]) && nl[1] != '#') {
+            stream->split = nl + 1 - stream->buff;
+        }
+        p = nl + 1;
+    }
+
+    stream->scanned = p - stream->buff;
+
+    if (stream->split == 0) { return JULE_SUCCESS; }
+
+    return jule_parse_stream_flush(interp, stream->split);
+}
+
+Jule_Status jule_parse_stream_end(Jule_Interp *interp) {
+    Jule_Status status;
+
+    status = JULE_SUCCESS;
+
+    if (interp->stream == NULL) { goto out; }
+
+    if (interp->stream->len > 0) {
+        status = jule_parse_stream_flush(interp, interp->stream->len);
+    }
+
+    jule_free_parse_stream(interp->stream);
+    interp->stream = NULL;
+
+out:;
+    return status;
+}
+
+/*
+ * AST cache
+ *
+ * When enabled with jule_set_ast_cache(), every file parsed through
+ * jule_parse_file() or eval-file has its roots serialized to a .julec file,
+ * either next to the source (foo.j -> foo.julec) or, if a directory is
+ * given, in that directory under a name derived from the source's real
+ * path. A later parse of the same file maps the cache and rebuilds the nodes
+ * from it instead of tokenizing.
+ *
+ * The cache is used if the source's size, mtime and ctime match the header,
+ * or, failing the time check (e.g. after a fresh checkout), if the hash of
+ * the source matches. In the latter case the header's times are refreshed.
+ * The header also holds a hash of everything after it, so a cache that was
+ * truncated or corrupted behind a valid header is a miss.
+ *
+ * The format is position-independent: symbols are stored once in a table at
+ * the front of the file and nodes refer to them by index, so each distinct
+ * symbol is interned once per load. The file's line table comes next, then
+ * the nodes in pre-order, children directly after their tree. Function
+ * bodies that were deferred by the parser are stored as their source text
+ * and stay lazy when loaded. Any inconsistency in a cache file is treated
+ * as a miss.
+ */
+
+#define JULE_AST_CACHE_MAGIC   "JULEAST"
+#define JULE_AST_CACHE_VERSION (4)
+
+typedef struct {
+    char               magic[8];
+    unsigned           version;
+    unsigned           n_symbols;
+    unsigned           n_lines;
+    unsigned long long n_roots;
+    unsigned long long size;
+    unsigned long long body_hash;
+    unsigned long long source_size;
+    unsigned long long source_hash;
+    long long          source_mtime_sec;
+    long long          source_mtime_nsec;
+    long long          source_ctime_sec;
+    long long          source_ctime_nsec;
+} Jule_AST_Cache_Header;
+
+use_hash_table(Jule_String_ID, unsigned)
+typedef hash_table(Jule_String_ID, unsigned) _Jule_Symbol_Index_Table;
+
+typedef struct {
+    Jule_Interp              *interp;
+    Jule_Builder             *out;
+    _Jule_Symbol_Index_Table  sym_idx;
+    Jule_Array               *syms;
+} Jule_AST_Cache_Writer;
+
+typedef struct {
+    Jule_Interp        *interp;
+    Jule_Arena         *arena;
+    const char         *cursor;
+    const char         *end;
+    Jule_String_ID     *syms;
+    unsigned            n_syms;
+    int                 ok;
+} Jule_AST_Cache_Reader;
+
+Jule_Status jule_set_ast_cache(Jule_Interp *interp, int enabled, const char *dir) {
+    if (interp->ast_cache_dir != NULL) {
+        JULE_FREE(interp->ast_cache_dir);
+        interp->ast_cache_dir = NULL;
+    }
+
+    interp->ast_cache_enabled = enabled;
+
+    if (enabled && dir != NULL) {
+        interp->ast_cache_dir = jule_charptr_dup(dir);
+    }
+
+    return JULE_SUCCESS;
+}
+
+static char *jule_ast_cache_path(Jule_Interp *interp, const char *path) {
+    char               *cpath;
+    unsigned long long  len;
+    char               *real;
+    unsigned long long  hash;
+
+    if (interp->ast_cache_dir == NULL) {
+        len   = strlen(path);
+        cpath = JULE_MALLOC(len + strlen(".julec") + 1);
+        memcpy(cpath, path, len + 1);
+
+        if (len >= 2 && strcmp(path + len - 2, ".j") == 0) {
+            strcat(cpath, "ulec");
+        } else {
+            strcat(cpath, ".julec");
+        }
+
+        return cpath;
+    }
+
+    real = realpath(path, NULL);
+    hash = real == NULL
+            ? jule_hash_bytes(path, strlen(path))
+            : jule_hash_bytes(real, strlen(real));
+    if (real != NULL) { free(real); }
+
+    len   = strlen(interp->ast_cache_dir) + 1 + 16 + strlen(".julec") + 1;
+    cpath = JULE_MALLOC(len);
+    snprintf(cpath, len, "%s/%016llx.julec", interp->ast_cache_dir, hash);
+
+    return cpath;
+}
+
+#define JULE_AST_PUT(_w, _v)                                         \
+do {                                                                 \
+    __typeof__(_v) _put = (_v);                                      \
+    jule_builder_append((_w)->out, (const char*)&_put, sizeof(_put)); \
+} while (0)
+
+static void jule_ast_cache_write_value(Jule_AST_Cache_Writer *w, const Jule_Value *value) {
+    unsigned    *idx;
+    unsigned     i;
+    Jule_Value  *child;
+
+    JULE_AST_PUT(w, (unsigned char)value->type);
+    JULE_AST_PUT(w, (unsigned)value->loc);
+
+    switch (value->type) {
+        case JULE_NIL:
+            break;
+        case JULE_NUMBER:
+            JULE_AST_PUT(w, value->number);
+            break;
+        case JULE_STRING:
+            JULE_AST_PUT(w, (unsigned long long)jule_string_len(value));
+            jule_builder_append(w->out, jule_string_chars(value), jule_string_len(value));
+            break;
+        case JULE_SYMBOL:
+            idx = hash_table_get_val(w->sym_idx, value->symbol_id);
+            if (idx == NULL) {
+                i = jule_len(w->syms);
+                hash_table_insert(w->sym_idx, value->symbol_id, i);
+                w->syms = jule_push(w->syms, (void*)value->symbol_id);
+            } else {
+                i = *idx;
+            }
+            JULE_AST_PUT(w, i);
+            break;
+        case _JULE_TREE:
+        case _JULE_TREE_LINE_LEADER:
+            JULE_AST_PUT(w, (unsigned)jule_len(value->eval_values));
+            FOR_EACH(value->eval_values, child) {
+                jule_ast_cache_write_value(w, child);
+            }
+            break;
+        case _JULE_LAZY:
+            JULE_AST_PUT(w, value->lazy->line);
+            JULE_AST_PUT(w, value->lazy->len);
+            jule_builder_append(w->out, value->lazy->src, value->lazy->len);
+            break;
+        default:
+            JULE_ASSERT(0 && "unexpected type in parsed tree");
+            break;
+    }
+}
+
+static unsigned long long jule_ast_cache_symbol_hash(Jule_String_ID id) {
+    return jule_string_id_hash(id);
+}
+
+static void jule_ast_cache_write(Jule_Interp *interp, const char *cpath, const struct stat *fs, const char *src, int size, Jule_Array *nodes) {
+    Jule_AST_Cache_Writer  w;
+    Jule_Builder          *file;
+    Jule_AST_Cache_Header  header;
+    Jule_Value            *it;
+    Jule_String_ID         sym;
+    Jule_Line_Table_Ptr   *lines;
+    char                  *tmp;
+    unsigned long long     tmp_len;
+    int                    fd;
+    unsigned long long     off;
+    ssize_t                n;
+
+    memset(&w, 0, sizeof(w));
+
+    w.interp  = interp;
+    w.out     = jule_builder();
+    w.sym_idx = hash_table_make(Jule_String_ID, unsigned, jule_ast_cache_symbol_hash);
+
+    FOR_EACH(nodes, it) {
+        jule_ast_cache_write_value(&w, it);
+    }
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, JULE_AST_CACHE_MAGIC, sizeof(JULE_AST_CACHE_MAGIC));
+    header.version           = JULE_AST_CACHE_VERSION;
+    header.n_symbols         = jule_len(w.syms);
+    header.n_roots           = jule_len(nodes);
+    lines                    = hash_table_get_val(interp->line_tables, interp->cur_file);
+    header.n_lines           = lines == NULL ? 0 : (*lines)->n_lines;
+    header.source_size       = size;
+    header.source_hash       = jule_hash_bytes(src, size);
+    header.source_mtime_sec  = fs->st_mtim.tv_sec;
+    header.source_mtime_nsec = fs->st_mtim.tv_nsec;
+    header.source_ctime_sec  = fs->st_ctim.tv_sec;
+    header.source_ctime_nsec = fs->st_ctim.tv_nsec;
+
+    file = jule_builder();
+    jule_builder_append(file, (const char*)&header, sizeof(header));
+
+    FOR_EACH(w.syms, sym) {
+        jule_builder_append(file, (const char*)&sym->len, sizeof(sym->len));
+        jule_builder_append(file, sym->chars, sym->len);
+    }
+
+    if (header.n_lines > 0) {
+        jule_builder_append(file, (const char*)(*lines)->starts, sizeof(*(*lines)->starts) * header.n_lines);
+    }
+
+    jule_builder_append(file, w.out->chars, w.out->len);
+
+    ((Jule_AST_Cache_Header*)(void*)file->chars)->size      = file->len;
+    ((Jule_AST_Cache_Header*)(void*)file->chars)->body_hash = jule_hash_bytes(file->chars + sizeof(header), file->len - sizeof(header));
+
+    /* Write to a temporary file and rename it into place so that concurrent
+     * runs never see a partial cache. Failures just mean no cache. */
+    tmp_len = strlen(cpath) + 32;
+    tmp     = JULE_MALLOC(tmp_len);
+    snprintf(tmp, tmp_len, "%s.%ld.tmp", cpath, (long)getpid());
+
+    fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0) {
+        for (off = 0; off < file->len; off += n) {
+            n = write(fd, file->chars + off, file->len - off);
+            if (n <= 0) { break; }
+        }
+        close(fd);
+
+        if (off != file->len || rename(tmp, cpath) != 0) {
+            unlink(tmp);
+        }
+    }
+
+    JULE_FREE(tmp);
+    jule_free_builder(file);
+    jule_free_builder(w.out);
+    jule_free_array(w.syms);
+    hash_table_free(w.sym_idx);
+}
+
+#undef JULE_AST_PUT
+
+static int jule_ast_cache_get(Jule_AST_Cache_Reader *r, void *dst, unsigned long long n) {
+    if (!r->ok || (unsigned long long)(r->end - r->cursor) < n) {
+        r->ok = 0;
+        return 0;
+    }
 
-#define PUSHS(_s) PUSHSN((_s), strlen(_s))
+    memcpy(dst, r->cursor, n);
+    r->cursor += n;
+
+    return 1;
+}
+
+static Jule_Value *jule_ast_cache_read_value(Jule_AST_Cache_Reader *r) {
+    Jule_Value         *value;
+    Jule_Value         *child;
+    unsigned char       type;
+    unsigned            loc;
+    double              number;
+    unsigned long long  len;
+    unsigned            idx;
+    unsigned            n;
+    unsigned            i;
+    unsigned            line;
+    Jule_Lazy_Body     *lazy;
 
-    if ((value->type != _JULE_TREE) && (value->type != _JULE_TREE_LINE_LEADER)) {
-        for (i = 0; i < ind; i += 1) { PUSHC(' '); }
+    if (!jule_ast_cache_get(r, &type,      sizeof(type))
+    ||  !jule_ast_cache_get(r, &loc,       sizeof(loc))) {
+        return NULL;
     }
 
-    switch (value->type) {
+    switch (type) {
         case JULE_NIL:
-            PUSHS("nil");
+            value = jule_arena_value(r->arena, JULE_NIL);
             break;
         case JULE_NUMBER:
-            snprintf(b, sizeof(b), "%g", value->number);
-            PUSHS(b);
+            if (!jule_ast_cache_get(r, &number, sizeof(number))) { return NULL; }
+            value         = jule_arena_value(r->arena, JULE_NUMBER);
+            value->number = number;
             break;
         case JULE_STRING:
-            string = jule_get_string(interp, value->string_id);
-            if (flags & JULE_NO_QUOTE) {
-                PUSHSN(string->chars, string->len);
-            } else {
-                PUSHC('"');
-                PUSHSN(string->chars, string->len);
-                PUSHC('"');
+            if (!jule_ast_cache_get(r, &len, sizeof(len))
+            ||  (unsigned long long)(r->end - r->cursor) < len) {
+                r->ok = 0;
+                return NULL;
             }
+            value      = jule_arena_string_value_n(r->arena, r->cursor, len);
+            r->cursor += len;
             break;
         case JULE_SYMBOL:
-            string = jule_get_string(interp, value->symbol_id);
-            PUSHS(string->chars);
-            break;
-        case JULE_LIST:
-            PUSHC('[');
-            PUSHC((flags & JULE_MULTILINE) ? '\n' : ' ');
-            FOR_EACH(value->list, child) {
-                _jule_string_print(interp, buff, len, cap, child, (flags & JULE_MULTILINE) ? ind + 2 : 0, flags & ~JULE_NO_QUOTE);
-                PUSHC((flags & JULE_MULTILINE) ? '\n' : ' ');
-            }
-            if (flags & JULE_MULTILINE) {
-                for (i = 0; i < ind; i += 1) { PUSHC(' '); }
-            }
-            PUSHC(']');
-            break;
-        case JULE_OBJECT:
-            PUSHC('{');
-            PUSHC((flags & JULE_MULTILINE) ? '\n' : ' ');
-            hash_table_traverse((_Jule_Object)value->object, key, val) {
-                _jule_string_print(interp, buff, len, cap, key, (flags & JULE_MULTILINE) ? ind + 2 : 0, flags & ~JULE_NO_QUOTE);
-                PUSHC(':');
-                _jule_string_print(interp, buff, len, cap, *val, (flags & JULE_MULTILINE) ? ind + 2 : 0, flags & ~JULE_NO_QUOTE);
-                PUSHC((flags & JULE_MULTILINE) ? '\n' : ' ');
-            }
-            if (flags & JULE_MULTILINE) {
-                for (i = 0; i < ind; i += 1) { PUSHC(' '); }
-            }
-            PUSHC('}');
-            break;
-        case _JULE_FN:
-            fsym = NULL;
-
-            for (i = jule_len(interp->local_symtab_stack); i > 0; i -= 1) {
-                hash_table_traverse((_Jule_Symbol_Table)jule_elem(interp->local_symtab_stack, i - 1), sym, val) {
-                    if ((*val) == value) {
-                        fsym = sym;
-                        goto found_fsym;
-                    }
-                }
-            }
-            hash_table_traverse(interp->symtab, sym, val) {
-                if ((*val) == value) {
-                    fsym = sym;
-                    goto found_fsym;
-                }
+            if (!jule_ast_cache_get(r, &idx, sizeof(idx)) || idx >= r->n_syms) {
+                r->ok = 0;
+                return NULL;
             }
-            goto print_tree; /* Not sure that this could ever happen, but just to be safe. */
-found_fsym:;
-            snprintf(b, sizeof(b), "<fn@%p> %s", (void*)value, fsym->chars);
-            PUSHS(b);
+            value            = jule_arena_value(r->arena, JULE_SYMBOL);
+            value->symbol_id = r->syms[idx];
             break;
         case _JULE_TREE:
         case _JULE_TREE_LINE_LEADER:
-        case _JULE_LAMBDA:
-print_tree:;
-            if (flags & JULE_MULTILINE) {
-                _jule_string_print(interp, buff, len, cap, value->eval_values->data[0], ind, flags & ~JULE_NO_QUOTE);
-                for (i = 1; i < jule_len(value->eval_values); i += 1) {
-                    PUSHC('\n');
-                    _jule_string_print(interp, buff, len, cap, value->eval_values->data[i], ind + 2, flags & ~JULE_NO_QUOTE);
-                }
-            } else {
-                PUSHC('(');
-                _jule_string_print(interp, buff, len, cap, value->eval_values->data[0], ind, flags & ~JULE_NO_QUOTE);
-                for (i = 1; i < jule_len(value->eval_values); i += 1) {
-                    PUSHC(' ');
-                    _jule_string_print(interp, buff, len, cap, value->eval_values->data[i], 0, flags & ~JULE_NO_QUOTE);
-                }
-                PUSHC(')');
+            /* Every node takes at least 5 bytes, which bounds n. */
+            if (!jule_ast_cache_get(r, &n, sizeof(n))
+            ||  n == 0
+            ||  n > (unsigned long long)(r->end - r->cursor) / 5) {
+                r->ok = 0;
+                return NULL;
             }
-            break;
-        case _JULE_BUILTIN_FN:
-            fsym = NULL;
-            hash_table_traverse(interp->symtab, sym, val) {
-                if ((*val)->type == _JULE_BUILTIN_FN
-                &&  (*val)->builtin_fn == value->builtin_fn) {
-
-                    fsym = sym;
-                    break;
-                }
+            value                   = jule_arena_value(r->arena, type);
+            value->eval_values      = jule_arena_alloc(r->arena, sizeof(Jule_Array) + (n * sizeof(void*)));
+            value->eval_values->len = n;
+            value->eval_values->cap = n;
+            value->eval_values->aux = (void*)r->interp->cur_file;
+            for (i = 0; i < n; i += 1) {
+                if ((child = jule_ast_cache_read_value(r)) == NULL) { return NULL; }
+                value->eval_values->data[i] = child;
             }
-            prfn.f = value->builtin_fn;
-            if (fsym != NULL) {
-                snprintf(b, sizeof(b), "<fn@%p> %s", prfn.v, fsym->chars);
-            } else {
-                snprintf(b, sizeof(b), "<fn@%p>", prfn.v);
+            break;
+        case _JULE_LAZY:
+            if (!jule_ast_cache_get(r, &line, sizeof(line))
+            ||  !jule_ast_cache_get(r, &n,    sizeof(n))
+            ||  loc == 0
+            ||  n == 0
+            ||  n > (unsigned long long)(r->end - r->cursor)) {
+                r->ok = 0;
+                return NULL;
             }
-            PUSHS(b);
+            lazy        = jule_arena_alloc(r->arena, sizeof(*lazy) + n);
+            lazy->file  = r->interp->cur_file;
+            lazy->nodes = NULL;
+            lazy->base  = loc - 1;
+            lazy->line  = line;
+            lazy->len   = n;
+            memcpy(lazy->src, r->cursor, n);
+            r->cursor += n;
+
+            value       = jule_arena_value(r->arena, _JULE_LAZY);
+            value->lazy = lazy;
             break;
         default:
-            JULE_ASSERT(0);
-            break;
-
+            r->ok = 0;
+            return NULL;
     }
 
-    PUSHC(0);
-    *len -= 1;
+    value->loc = loc;
+
+    return value;
 }
 
-char *jule_to_string(Jule_Interp *interp, const Jule_Value *value, int flags) {
-    char *buff;
-    int   len;
-    int   cap;
+/* Returns 1 and appends the cached roots to out_nodes on a hit. */
+static int jule_ast_cache_load(Jule_Interp *interp, Jule_Arena *arena, const char *cpath, const struct stat *fs, const char *path, Jule_Array **out_nodes) {
+    int                    hit;
+    int                    fd;
+    struct stat            cfs;
+    const char            *mem;
+    Jule_AST_Cache_Header  header;
+    const char            *src;
+    int                    src_size;
+    Jule_AST_Cache_Reader  r;
+    Jule_Array            *nodes = JULE_ARRAY_INIT;
+    Jule_Value            *it;
+    unsigned long long     len;
+    unsigned               i;
+    unsigned               line_start;
+    Jule_Line_Table       *lines;
 
-    buff = JULE_MALLOC(16);
-    len  = 0;
-    cap  = 16;
+    hit   = 0;
+    lines = NULL;
 
-    _jule_string_print(interp, &buff, &len, &cap, value, 0, flags);
+    if ((fd = open(cpath, O_RDONLY)) < 0) { goto out; }
 
-    return buff;
-}
+    if (fstat(fd, &cfs) != 0 || (unsigned long long)cfs.st_size < sizeof(header)) { goto out_close; }
 
-static void jule_output(Jule_Interp *interp, const char *s, int n_bytes) {
-    if (interp->output_callback == NULL) {
-        printf("%.*s", n_bytes, s);
-        fflush(stdout);
-    } else {
-        interp->output_callback(s, n_bytes);
+    mem = mmap(NULL, cfs.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mem == MAP_FAILED) { goto out_close; }
+
+    memcpy(&header, mem, sizeof(header));
+
+    if (memcmp(header.magic, JULE_AST_CACHE_MAGIC, sizeof(JULE_AST_CACHE_MAGIC)) != 0
+    ||  header.version     != JULE_AST_CACHE_VERSION
+    ||  header.size        != (unsigned long long)cfs.st_size
+    ||  header.source_size != (unsigned long long)fs->st_size
+    ||  header.body_hash   != jule_hash_bytes(mem + sizeof(header), cfs.st_size - sizeof(header))) {
+        goto out_unmap;
     }
-}
 
-static void jule_print(Jule_Interp *interp, Jule_Value *value, unsigned ind) {
-    char *buff;
-    int   len;
-    int   cap;
+    if (header.source_mtime_sec  != fs->st_mtim.tv_sec
+    ||  header.source_mtime_nsec != fs->st_mtim.tv_nsec
+    ||  header.source_ctime_sec  != fs->st_ctim.tv_sec
+    ||  header.source_ctime_nsec != fs->st_ctim.tv_nsec) {
 
-    buff = JULE_MALLOC(16);
-    len  = 0;
-    cap  = 16;
+        if (jule_map_file_into_readonly_memory(path, &src, &src_size) != JULE_SUCCESS) { goto out_unmap; }
 
-    _jule_string_print(interp, &buff, &len, &cap, value, ind, JULE_NO_QUOTE | JULE_MULTILINE);
-    jule_output(interp, buff, len);
-    JULE_FREE(buff);
-}
+        if (src_size != fs->st_size || jule_hash_bytes(src, src_size) != header.source_hash) {
+            if (src != NULL) { munmap((void*)src, src_size); }
+            goto out_unmap;
+        }
 
-static Jule_Status jule_parse_nodes(Jule_Interp *interp, const char *str, int size, Jule_Array **out_nodes) {
-    Jule_Parse_Context  cxt;
-    Jule_Status         status;
-    Jule_Value         *it;
+        if (src != NULL) { munmap((void*)src, src_size); }
+
+        /* Same contents, new times: refresh the header so that the next load
+         * doesn't have to hash the source again. */
+        header.source_mtime_sec  = fs->st_mtim.tv_sec;
+        header.source_mtime_nsec = fs->st_mtim.tv_nsec;
+        header.source_ctime_sec  = fs->st_ctim.tv_sec;
+        header.source_ctime_nsec = fs->st_ctim.tv_nsec;
+        close(fd);
+        if ((fd = open(cpath, O_WRONLY)) >= 0) {
+            if (pwrite(fd, &header, sizeof(header), 0) != sizeof(header)) { /* Not fatal. */ }
+        }
+    }
 
-    memset(&cxt, 0, sizeof(cxt));
+    memset(&r, 0, sizeof(r));
 
-    cxt.interp = interp;
-    cxt.cursor = str;
-    cxt.end    = str + size;
+    r.interp = interp;
+    r.arena  = jule_arena();
+    r.cursor = mem + sizeof(header);
+    r.end    = mem + cfs.st_size;
+    r.ok     = 1;
+    r.n_syms = header.n_symbols;
+    r.syms   = JULE_MALLOC(sizeof(*r.syms) * (r.n_syms + 1));
 
-    status = JULE_SUCCESS;
-    while (status == JULE_SUCCESS && MORE_INPUT(&cxt)) {
-        cxt.line += 1;
+    for (i = 0; i < r.n_syms; i += 1) {
+        if (!jule_ast_cache_get(&r, &len, sizeof(len))
+        ||  (unsigned long long)(r.end - r.cursor) < len) {
+            goto out_free;
+        }
+        r.syms[i]  = jule_get_string_id_n(interp, r.cursor, len);
+        r.cursor  += len;
+    }
+
+    lines = jule_line_table();
+    for (i = 0; i < header.n_lines; i += 1) {
+        if (!jule_ast_cache_get(&r, &line_start, sizeof(line_start))) { goto out_free; }
+        jule_line_table_push(lines, line_start);
+    }
+
+    for (i = 0; i < header.n_roots; i += 1) {
+        if ((it = jule_ast_cache_read_value(&r)) == NULL) { goto out_free; }
+        nodes = jule_push(nodes, it);
+    }
+
+    if (r.cursor != r.end) { goto out_free; }
+
+    FOR_EACH(nodes, it) {
+        *out_nodes = jule_push(*out_nodes, it);
+    }
+
+    jule_arena_merge(arena, r.arena);
+    r.arena = NULL;
 
-        if (cxt.line >= (1 << JULE_MAX_LINE_POT)) {
-            PARSE_ERR_RET(cxt.interp, JULE_ERR_TOO_MANY_LINES, cxt.line, 1);
+    jule_set_line_table(interp, interp->cur_file, lines);
+    lines = NULL;
+
+    hit = 1;
+
+out_free:;
+    jule_free_array(nodes);
+    JULE_FREE(r.syms);
+    if (r.arena != NULL) { jule_free_arena(r.arena); }
+    if (lines != NULL)   { jule_free_line_table(lines); }
+
+out_unmap:;
+    munmap((void*)mem, cfs.st_size);
+
+out_close:;
+    if (fd >= 0) { close(fd); }
+
+out:;
+    return hit;
+}
+
+/* Parses the file at path (which should already be interp->cur_file) into
+ * arena, going through the AST cache if it's enabled. File errors are
+ * returned without being reported; parse errors are reported as usual. */
+static Jule_Status jule_parse_file_nodes(Jule_Interp *interp, const char *path, Jule_Arena *arena, Jule_Array **out_nodes) {
+    Jule_Status  status;
+    struct stat  fs;
+    char        *cpath;
+    const char  *mem;
+    int          size;
+    Jule_Array  *nodes = JULE_ARRAY_INIT;
+    Jule_Value  *it;
+
+    cpath = NULL;
+
+    if (interp->ast_cache_enabled && stat(path, &fs) == 0 && S_ISREG(fs.st_mode)) {
+        cpath = jule_ast_cache_path(interp, path);
+
+        if (jule_ast_cache_load(interp, arena, cpath, &fs, path, out_nodes)) {
+            status = JULE_SUCCESS;
+            goto out;
         }
+    }
+
+    status = jule_map_file_into_readonly_memory(path, &mem, &size);
+    if (status != JULE_SUCCESS) { goto out; }
+
+    status = jule_parse_nodes(interp, arena, mem, size, &nodes);
 
-        status = jule_parse_line(&cxt);
+    if (status == JULE_SUCCESS && cpath != NULL) {
+        jule_ast_cache_write(interp, cpath, &fs, mem, size, nodes);
     }
 
-    FOR_EACH(cxt.roots, it) {
+    if (mem != NULL) { munmap((void*)mem, size); }
+
+    FOR_EACH(nodes, it) {
         *out_nodes = jule_push(*out_nodes, it);
     }
+    jule_free_array(nodes);
 
-    jule_free_array(cxt.roots);
-    jule_free_array(cxt.stack);
+out:;
+    if (cpath != NULL) { JULE_FREE(cpath); }
 
     return status;
 }
 
-Jule_Status jule_parse(Jule_Interp *interp, const char *str, int size) {
-    return jule_parse_nodes(interp, str, size, &interp->roots);
+Jule_Status jule_parse_file(Jule_Interp *interp, const char *path) {
+    Jule_Arena *arena;
+
+    arena          = jule_arena();
+    interp->arenas = jule_push(interp->arenas, arena);
+
+    return jule_parse_file_nodes(interp, path, arena, &interp->roots);
 }
 
 static void jule_pushlocal_symtab(Jule_Interp *interp, _Jule_Symbol_Table local_symtab) {
@@ -2735,10 +6410,11 @@ static Jule_Status jule_invoke(Jule_Interp *interp, Jule_Value *tree, Jule_Value
 
     bt_entry = JULE_MALLOC(sizeof(*bt_entry));
 
-    bt_entry->file = interp->cur_file;
+    bt_entry->file = jule_tree_file(interp, tree);
     bt_entry->fn   = (fn->type == JULE_LIST || fn->type == JULE_OBJECT)
                         ? tree
                         : fn;
+    bt_entry->tree = tree;
 
     interp->backtrace = jule_push(interp->backtrace, bt_entry);
 
@@ -2930,8 +6606,6 @@ static Jule_Status jule_invoke(Jule_Interp *interp, Jule_Value *tree, Jule_Value
         }
     } else if (fn->type == JULE_LIST || fn->type == JULE_OBJECT) {
         builtin.type = _JULE_BUILTIN_FN;
-        builtin.line = fn->line;
-        builtin.col  = fn->col;
 
         if (fn->type == JULE_LIST) {
             builtin.builtin_fn = jule_builtin_elem;
@@ -2941,8 +6615,9 @@ static Jule_Status jule_invoke(Jule_Interp *interp, Jule_Value *tree, Jule_Value
 
         container_bt_entry = JULE_MALLOC(sizeof(*container_bt_entry));
 
-        container_bt_entry->file = interp->cur_file;
+        container_bt_entry->file = jule_tree_file(interp, tree);
         container_bt_entry->fn   = &builtin;
+        container_bt_entry->tree = tree;
 
         container_args    = alloca(sizeof(*container_args) * (n_values + 1));
         container_args[0] = fn;
@@ -2979,6 +6654,7 @@ static Jule_Status jule_eval(Jule_Interp *interp, Jule_Value *value, Jule_Value
     Jule_Value   *fn;
     Jule_Value  **arg_values;
     unsigned      n_args;
+    Jule_Value   *it;
 
     status  = JULE_SUCCESS;
     *result = NULL;
@@ -2997,6 +6673,8 @@ static Jule_Status jule_eval(Jule_Interp *interp, Jule_Value *value, Jule_Value
         case JULE_STRING:
         case JULE_LIST:
         case JULE_OBJECT:
+        case JULE_BUILDER:
+        case JULE_HANDLE:
             *result = jule_copy(value);
             goto out;
 
@@ -3068,9 +6746,6 @@ static Jule_Status jule_eval(Jule_Interp *interp, Jule_Value *value, Jule_Value
             }
 
 invoke:;
-            fn->line = value->line; /* @bad */
-            fn->col  = value->col; /* @bad */
-
             status = jule_invoke(interp, value, fn, n_args, arg_values, result);
             if (status != JULE_SUCCESS) {
                 jule_free_value(fn);
@@ -3080,17 +6755,31 @@ invoke:;
             jule_free_value(fn);
             break;
 
+        case _JULE_LAZY:
+            status = jule_expand_lazy(interp, value);
+            if (status != JULE_SUCCESS) { goto out; }
+
+            FOR_EACH(value->lazy->nodes, it) {
+                if (*result != NULL) {
+                    jule_free_value(*result);
+                }
+                status = jule_eval(interp, it, result);
+                if (status != JULE_SUCCESS) {
+                    *result = NULL;
+                    goto out;
+                }
+            }
+            if (*result == NULL) {
+                *result = jule_nil_value();
+            }
+            break;
+
         default:
             JULE_ASSERT(0);
             break;
     }
 
 out:;
-    if (*result != NULL) {
-        (*result)->line = value->line;
-        (*result)->col  = value->col;
-    }
-
     return status;
 }
 
@@ -3168,9 +6857,6 @@ static Jule_Status jule_args(Jule_Interp *interp, Jule_Value *tree, const char *
             }
         }
 
-        (*ve_ptr)->line = v->line;
-        (*ve_ptr)->col  = v->col;
-
         switch (c) {
             case '0': t = JULE_NIL;             break;
             case 'n': t = JULE_NUMBER;          break;
@@ -3178,6 +6864,8 @@ static Jule_Status jule_args(Jule_Interp *interp, Jule_Value *tree, const char *
             case '$': t = JULE_SYMBOL;          break;
             case 'l': t = JULE_LIST;            break;
             case 'o': t = JULE_OBJECT;          break;
+            case 'b': t = JULE_BUILDER;         break;
+            case 'h': t = JULE_HANDLE;          break;
             case '#': t = _JULE_LIST_OR_OBJECT; break;
             case 'k': t = _JULE_KEYLIKE;        break;
             case 'x': t = _JULE_TREE;           break;
@@ -3685,6 +7373,8 @@ static Jule_Status jule_builtin_id(Jule_Interp *interp, Jule_Value *tree, unsign
         case JULE_STRING:
         case JULE_LIST:
         case JULE_OBJECT:
+        case JULE_BUILDER:
+        case JULE_HANDLE:
         case _JULE_TREE:
         case _JULE_TREE_LINE_LEADER:
             status = jule_eval(interp, value, &ev);
@@ -4075,7 +7765,7 @@ static Jule_Status jule_builtin_and(Jule_Interp *interp, Jule_Value *tree, unsig
 
         if (ev->type != JULE_NUMBER) {
             status = JULE_ERR_TYPE;
-            jule_make_type_error(interp, ev, JULE_NUMBER, ev->type);
+            jule_make_type_error(interp, cond, JULE_NUMBER, ev->type);
             jule_free_value(ev);
             *result = NULL;
             goto out;
@@ -4125,7 +7815,7 @@ static Jule_Status jule_builtin_or(Jule_Interp *interp, Jule_Value *tree, unsign
 
         if (ev->type != JULE_NUMBER) {
             status = JULE_ERR_TYPE;
-            jule_make_type_error(interp, ev, JULE_NUMBER, ev->type);
+            jule_make_type_error(interp, cond, JULE_NUMBER, ev->type);
             jule_free_value(ev);
             *result = NULL;
             goto out;
@@ -4159,8 +7849,7 @@ static Jule_Status jule_builtin_string(Jule_Interp *interp, Jule_Value *tree, un
     }
 
     s = jule_to_string(interp, val, JULE_NO_QUOTE);
-    *result = jule_string_value(interp, s);
-    JULE_FREE(s);
+    *result = jule_string_value_consume(interp, s, strlen(s));
 
     jule_free_value(val);
 
@@ -4171,7 +7860,6 @@ out:;
 static Jule_Status jule_builtin_symbol(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
     Jule_Status        status;
     Jule_Value        *str;
-    const Jule_String *string;
 
     status = jule_args(interp, tree, "s", n_values, values, &str);
     if (status != JULE_SUCCESS) {
@@ -4179,8 +7867,7 @@ static Jule_Status jule_builtin_symbol(Jule_Interp *interp, Jule_Value *tree, un
         goto out;
     }
 
-    string  = jule_get_string(interp, str->string_id);
-    *result = jule_symbol_value(interp, string->chars);
+    *result = jule_symbol_value_n(interp, jule_string_chars(str), jule_string_len(str));
 
     jule_free_value(str);
 
@@ -4221,9 +7908,8 @@ static Jule_Status jule_builtin_pad(Jule_Interp *interp, Jule_Value *tree, unsig
     memcpy(padded + ((!ljust) * padding), s, len);
     padded[len + padding] = 0;
 
-    *result = jule_string_value(interp, padded);
+    *result = jule_string_value_consume(interp, padded, len + padding);
 
-    JULE_FREE(padded);
     JULE_FREE(s);
 
     jule_free_value(w);
@@ -4269,129 +7955,271 @@ out:;
     return status;
 }
 
-static Jule_Status jule_builtin_print(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
-    return _jule_builtin_print(interp, tree, n_values, values, result, 0);
+static Jule_Status jule_builtin_print(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    return _jule_builtin_print(interp, tree, n_values, values, result, 0);
+}
+
+static Jule_Status jule_builtin_println(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    return _jule_builtin_print(interp, tree, n_values, values, result, 1);
+}
+
+static Jule_Fmt_Template *jule_compile_fmt(const Jule_Value *site, const char *chars, unsigned long long len) {
+    Jule_Fmt_Template  *t;
+    unsigned long long  i;
+    char                last;
+    char                c;
+
+    t = JULE_MALLOC(sizeof(*t));
+
+    t->site     = site;
+    t->src      = jule_charptr_ndup(chars, len);
+    t->src_len  = len;
+    t->text     = JULE_MALLOC(len + 1);
+    t->text_len = 0;
+    t->n_args   = 0;
+
+    for (i = 0; i < len; i += 1) {
+        if (chars[i] == '%') { t->n_args += 1; }
+    }
+
+    t->splits = JULE_MALLOC(sizeof(*t->splits) * (t->n_args + 1));
+    t->n_args = 0;
+
+    /* A '%' preceded by '\' is a literal '%' and the '\' is dropped. */
+    last = 0;
+    for (i = 0; i < len; i += 1) {
+        c = chars[i];
+        if (c == '\\' && i < len - 1 && chars[i + 1] == '%') {
+            /* skip */
+        } else if (c == '%' && last != '\\') {
+            t->splits[t->n_args]  = t->text_len;
+            t->n_args            += 1;
+        } else {
+            t->text[t->text_len]  = c;
+            t->text_len          += 1;
+        }
+        last = c;
+    }
+
+    t->text[t->text_len] = 0;
+
+    return t;
+}
+
+static void jule_free_fmt(Jule_Fmt_Template *t) {
+    JULE_FREE(t->src);
+    JULE_FREE(t->text);
+    JULE_FREE(t->splits);
+    JULE_FREE(t);
+}
+
+/* Format strings that are literals in the tree are compiled once and cached
+ * per call site. The cache is JULE_FMT_CACHE_WAYS-way set-associative on the
+ * site's address, with the most recently used template of a set first.
+ * Parsed sites live in an arena until the interpreter is freed, so the site
+ * alone identifies the template. Other trees can be freed and their memory
+ * reused, so their entries are only used if the text is still the same. */
+static Jule_Fmt_Template *jule_get_fmt(Jule_Interp *interp, const Jule_Value *site, const Jule_Value *literal, const Jule_Value *fmt, int *cached) {
+    Jule_Fmt_Template **set;
+    Jule_Fmt_Template  *t;
+    const char         *chars;
+    unsigned long long  len;
+    int                 i;
+
+    chars = jule_string_chars(fmt);
+    len   = jule_string_len(fmt);
+
+    if (literal->type != JULE_STRING) {
+        *cached = 0;
+        return jule_compile_fmt(site, chars, len);
+    }
+
+    *cached = 1;
+
+    set = &interp->fmt_cache[((((unsigned long long)(void*)site) >> 4) % (JULE_FMT_CACHE_SIZE / JULE_FMT_CACHE_WAYS)) * JULE_FMT_CACHE_WAYS];
+
+    for (i = 0; i < JULE_FMT_CACHE_WAYS && set[i] != NULL; i += 1) {
+        t = set[i];
+
+        if (t->site == site
+        &&  (site->in_arena || (t->src_len == len && memcmp(t->src, chars, len) == 0))) {
+            goto found;
+        }
+    }
+
+    /* Miss: the least recently used template makes room. */
+    if (i == JULE_FMT_CACHE_WAYS) {
+        i -= 1;
+        jule_free_fmt(set[i]);
+    }
+
+    t = jule_compile_fmt(site, chars, len);
+
+found:;
+    for (; i > 0; i -= 1) {
+        set[i] = set[i - 1];
+    }
+    set[0] = t;
+
+    return t;
+}
+
+/* Bulk versions of parse-int and parse-float: convert every string in a list.
+ * Elements that don't parse become nil. */
+static Jule_Status _jule_builtin_parse_list(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result, int is_float) {
+    Jule_Status  status;
+    Jule_Value  *list;
+    Jule_Value  *it;
+    long long    i;
+    double       d;
+    int          ok;
+
+    status = jule_args(interp, tree, "l", n_values, values, &list);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    FOR_EACH(list->list, it) {
+        if (it->type != JULE_STRING) {
+            status = JULE_ERR_TYPE;
+            jule_make_type_error(interp, values[0], JULE_STRING, it->type);
+            *result = NULL;
+            goto out_free;
+        }
+    }
+
+    *result = jule_list_value();
+
+    FOR_EACH(list->list, it) {
+        if (is_float) {
+            ok = jule_parse_float_chars(jule_string_chars(it), jule_string_len(it), &d);
+        } else {
+            ok = jule_parse_int_chars(jule_string_chars(it), jule_string_len(it), &i);
+            d  = i;
+        }
+
+        (*result)->list = jule_push((*result)->list, ok ? jule_number_value(d) : jule_nil_value());
+    }
+
+out_free:;
+    jule_free_value(list);
+
+out:;
+    return status;
+}
+
+static Jule_Status jule_builtin_parse_ints(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    return _jule_builtin_parse_list(interp, tree, n_values, values, result, 0);
 }
 
-static Jule_Status jule_builtin_println(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
-    return _jule_builtin_print(interp, tree, n_values, values, result, 1);
+static Jule_Status jule_builtin_parse_floats(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    return _jule_builtin_parse_list(interp, tree, n_values, values, result, 1);
 }
 
-static Jule_Status jule_builtin_fmt(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
-    Jule_Status        status;
-    Jule_Value        *fmt;
-    const Jule_String *fstring;
-    unsigned           n;
-    unsigned           extra;
-    char               last;
-    char               c;
-    unsigned           i;
-    Jule_Array        *strings = JULE_ARRAY_INIT;
-    Jule_Value        *it;
-    Jule_Value        *ev;
-    char              *s;
-    int                len;
-    char              *formatted;
-    char              *ins;
-    int                sublen;
+static void jule_builder_append_value(Jule_Interp *interp, Jule_Builder *builder, const Jule_Value *value) {
+    char  b[32];
+    int   len;
+    char *s;
+
+    switch (value->type) {
+        case JULE_NUMBER:
+            len = jule_number_to_chars(value->number, b);
+            jule_builder_append(builder, b, len);
+            break;
+        case JULE_STRING:
+            jule_builder_append(builder, jule_string_chars(value), jule_string_len(value));
+            break;
+        case JULE_BUILDER:
+            jule_builder_append(builder, value->builder->chars, value->builder->len);
+            break;
+        default:
+            s = jule_to_string(interp, value, JULE_NO_QUOTE);
+            jule_builder_append(builder, s, strlen(s));
+            JULE_FREE(s);
+            break;
+    }
+}
+
+/* Evaluates a fmt-style argument list and appends the result to builder. */
+static Jule_Status jule_fmt(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Builder *builder) {
+    Jule_Status         status;
+    Jule_Value         *fmt;
+    Jule_Fmt_Template  *t;
+    int                 cached;
+    unsigned            i;
+    unsigned long long  pos;
+    Jule_Value         *ev;
 
     status = JULE_SUCCESS;
 
     if (n_values < 1) {
         status = JULE_ERR_ARITY;
         jule_make_arity_error(interp, tree, 1, n_values, 1);
-        *result = NULL;
         goto out;
     }
 
     status = jule_eval(interp, values[0], &fmt);
     if (status != JULE_SUCCESS) {
-        *result = NULL;
         goto out;
     }
 
     if (fmt->type != JULE_STRING) {
         status = JULE_ERR_TYPE;
-        jule_make_type_error(interp, fmt, JULE_STRING, fmt->type);
-        *result = NULL;
+        jule_make_type_error(interp, values[0], JULE_STRING, fmt->type);
         goto out_free_fmt;
     }
 
-    fstring = jule_get_string(interp, fmt->string_id);
-    n       = 0;
-    extra   = 0;
-    last    = 0;
-    for (i = 0; i < fstring->len; i += 1) {
-        c = fstring->chars[i];
-        if (c == '%') {
-            extra += 1;
-            if (last != '\\') {
-                n += 1;
-            }
-        }
-        last = c;
-    }
+    t = jule_get_fmt(interp, tree, values[0], fmt, &cached);
 
-    if (n_values - 1 != n) {
+    if (n_values - 1 != t->n_args) {
         status = JULE_ERR_ARITY;
-        jule_make_arity_error(interp, tree, n + 1, n_values, 0);
-        *result = NULL;
-        goto out_free_fmt;
+        jule_make_arity_error(interp, tree, t->n_args + 1, n_values, 0);
+        goto out_free_template;
     }
 
-    for (i = 1; i < n_values; i += 1) {
-        it = values[i];
-        status = jule_eval(interp, it, &ev);
+    pos = 0;
+    for (i = 0; i < t->n_args; i += 1) {
+        status = jule_eval(interp, values[i + 1], &ev);
         if (status != JULE_SUCCESS) {
-            *result = NULL;
-            goto out_free_strings;
+            goto out_free_template;
         }
-        s = jule_to_string(interp, ev, JULE_NO_QUOTE);
-        strings = jule_push(strings, s);
+
+        jule_builder_append(builder, t->text + pos, t->splits[i] - pos);
+        pos = t->splits[i];
+
+        jule_builder_append_value(interp, builder, ev);
         jule_free_value(ev);
     }
 
-    len = fstring->len - extra;
-    FOR_EACH(strings, s) {
-        len += strlen(s);
-    }
+    jule_builder_append(builder, t->text + pos, t->text_len - pos);
 
-    formatted = JULE_MALLOC(len + 1);
-    ins       = formatted;
+out_free_template:;
+    if (!cached) { jule_free_fmt(t); }
 
-    n    = 0;
-    last = 0;
-    for (i = 0; i < fstring->len; i += 1) {
-        c = fstring->chars[i];
-        if (c == '\\' && i < fstring->len - 1 && fstring->chars[i + 1] == '%') {
-            /* skip */
-        } else if (c == '%' && last != '\\') {
-            s      = jule_elem(strings, n);
-            sublen = strlen(s);
-            memcpy(ins, s, sublen);
-            ins += sublen;
-            n += 1;
-        } else {
-            *ins  = c;
-            ins  += 1;
-        }
-        last = c;
-    }
+out_free_fmt:;
+    jule_free_value(fmt);
 
-    formatted[len] = 0;
+out:;
+    return status;
+}
 
-    *result = jule_string_value(interp, formatted);
+static Jule_Status jule_builtin_fmt(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status   status;
+    Jule_Builder *builder;
 
-    JULE_FREE(formatted);
+    builder = jule_builder();
 
-out_free_strings:;
-    FOR_EACH(strings, s) {
-        JULE_FREE(s);
+    status = jule_fmt(interp, tree, n_values, values, builder);
+    if (status != JULE_SUCCESS) {
+        jule_free_builder(builder);
+        *result = NULL;
+        goto out;
     }
-    jule_free_array(strings);
 
-out_free_fmt:;
-    jule_free_value(fmt);
+    builder->chars[builder->len] = 0;
+    *result = jule_string_value_consume(interp, builder->chars, builder->len);
+    JULE_FREE(builder);
 
 out:;
     return status;
@@ -4410,7 +8238,7 @@ static Jule_Status jule_builtin_num_fmt(Jule_Interp *interp, Jule_Value *tree, u
         goto out;
     }
 
-    snprintf(fbuff, sizeof(fbuff), "%%%s", jule_get_string(interp, fmt->string_id)->chars);
+    snprintf(fbuff, sizeof(fbuff), "%%%s", jule_string_cstr(fmt));
     snprintf(buff, sizeof(buff), fbuff, val->number);
 
     *result = jule_string_value(interp, buff);
@@ -4434,7 +8262,7 @@ static Jule_Status jule_builtin_parse_int(Jule_Interp *interp, Jule_Value *tree,
         goto out;
     }
 
-    if (sscanf(jule_get_string(interp, s->string_id)->chars, "%lld", &i) == 1) {
+    if (jule_parse_int_chars(jule_string_chars(s), jule_string_len(s), &i)) {
         *result = jule_number_value(i);
     } else {
         *result = jule_nil_value();
@@ -4457,7 +8285,7 @@ static Jule_Status jule_builtin_parse_hex(Jule_Interp *interp, Jule_Value *tree,
         goto out;
     }
 
-    if (sscanf(jule_get_string(interp, s->string_id)->chars, "%llx", &i) == 1) {
+    if (sscanf(jule_string_cstr(s), "%llx", &i) == 1) {
         *result = jule_number_value(i);
     } else {
         *result = jule_nil_value();
@@ -4480,7 +8308,7 @@ static Jule_Status jule_builtin_parse_float(Jule_Interp *interp, Jule_Value *tre
         goto out;
     }
 
-    if (sscanf(jule_get_string(interp, s->string_id)->chars, "%lg", &d) == 1) {
+    if (jule_parse_float_chars(jule_string_chars(s), jule_string_len(s), &d)) {
         *result = jule_number_value(d);
     } else {
         *result = jule_nil_value();
@@ -4492,6 +8320,162 @@ out:;
     return status;
 }
 
+/* Evaluates the first argument and checks that it is a builder. The caller
+ * owns the returned value. */
+static Jule_Status jule_eval_builder_arg(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **builder) {
+    Jule_Status status;
+
+    if (n_values < 1) {
+        status = JULE_ERR_ARITY;
+        jule_make_arity_error(interp, tree, 1, n_values, 1);
+        *builder = NULL;
+        goto out;
+    }
+
+    status = jule_eval(interp, values[0], builder);
+    if (status != JULE_SUCCESS) {
+        *builder = NULL;
+        goto out;
+    }
+
+    if ((*builder)->type != JULE_BUILDER) {
+        status = JULE_ERR_TYPE;
+        jule_make_type_error(interp, values[0], JULE_BUILDER, (*builder)->type);
+        jule_free_value(*builder);
+        *builder = NULL;
+        goto out;
+    }
+
+out:;
+    return status;
+}
+
+static Jule_Status _jule_builder_append_values(Jule_Interp *interp, Jule_Value *builder, unsigned n_values, Jule_Value **values) {
+    Jule_Status  status;
+    unsigned     i;
+    Jule_Value  *ev;
+
+    status = JULE_SUCCESS;
+
+    for (i = 0; i < n_values; i += 1) {
+        status = jule_eval(interp, values[i], &ev);
+        if (status != JULE_SUCCESS) { goto out; }
+
+        jule_builder_append_value(interp, builder->builder, ev);
+        jule_free_value(ev);
+    }
+
+out:;
+    return status;
+}
+
+static Jule_Status jule_builtin_builder(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status status;
+
+    (void)tree;
+
+    *result = jule_builder_value();
+
+    status = _jule_builder_append_values(interp, *result, n_values, values);
+    if (status != JULE_SUCCESS) {
+        jule_free_value(*result);
+        *result = NULL;
+    }
+
+    return status;
+}
+
+static Jule_Status jule_builtin_builder_append(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status  status;
+    Jule_Value  *builder;
+
+    status = jule_eval_builder_arg(interp, tree, n_values, values, &builder);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    status = _jule_builder_append_values(interp, builder, n_values - 1, values + 1);
+    if (status != JULE_SUCCESS) {
+        jule_free_value(builder);
+        *result = NULL;
+        goto out;
+    }
+
+    *result = builder;
+
+out:;
+    return status;
+}
+
+static Jule_Status jule_builtin_builder_append_fmt(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status  status;
+    Jule_Value  *builder;
+
+    status = jule_eval_builder_arg(interp, tree, n_values, values, &builder);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    status = jule_fmt(interp, tree, n_values - 1, values + 1, builder->builder);
+    if (status != JULE_SUCCESS) {
+        jule_free_value(builder);
+        *result = NULL;
+        goto out;
+    }
+
+    *result = builder;
+
+out:;
+    return status;
+}
+
+static Jule_Status jule_builtin_builder_len(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status  status;
+    Jule_Value  *builder;
+
+    status = jule_args(interp, tree, "b", n_values, values, &builder);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    *result = jule_number_value(builder->builder->len);
+
+    jule_free_value(builder);
+
+out:;
+    return status;
+}
+
+static Jule_Status jule_builtin_builder_finish(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    Jule_Status   status;
+    Jule_Value   *builder;
+    Jule_Builder *b;
+
+    status = jule_args(interp, tree, "b", n_values, values, &builder);
+    if (status != JULE_SUCCESS) {
+        *result = NULL;
+        goto out;
+    }
+
+    /* The buffer is handed to the string and the builder starts over empty. */
+    b = builder->builder;
+
+    b->chars[b->len] = 0;
+    *result = jule_string_value_consume(interp, b->chars, b->len);
+
+    b->len   = 0;
+    b->cap   = 64;
+    b->chars = JULE_MALLOC(b->cap);
+
+    jule_free_value(builder);
+
+out:;
+    return status;
+}
+
 static Jule_Status jule_builtin_select(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
     Jule_Status  status;
     Jule_Value  *cond;
@@ -4514,7 +8498,7 @@ static Jule_Status jule_builtin_select(Jule_Interp *interp, Jule_Value *tree, un
 
     if (cond->type != JULE_NUMBER) {
         status = JULE_ERR_TYPE;
-        jule_make_type_error(interp, cond, JULE_NUMBER, cond->type);
+        jule_make_type_error(interp, values[0], JULE_NUMBER, cond->type);
         goto out_free_cond;
     }
 
@@ -4601,7 +8585,7 @@ static Jule_Status jule_builtin_if(Jule_Interp *interp, Jule_Value *tree, unsign
 
     if (cond->type != JULE_NUMBER) {
         status = JULE_ERR_TYPE;
-        jule_make_type_error(interp, cond, JULE_NUMBER, cond->type);
+        jule_make_type_error(interp, values[0], JULE_NUMBER, cond->type);
         goto out_free_cond;
     }
 
@@ -4674,7 +8658,7 @@ static Jule_Status jule_builtin_elif(Jule_Interp *interp, Jule_Value *tree, unsi
 
         if (cond->type != JULE_NUMBER) {
             status = JULE_ERR_TYPE;
-            jule_make_type_error(interp, cond, JULE_NUMBER, cond->type);
+            jule_make_type_error(interp, values[0], JULE_NUMBER, cond->type);
             goto out_free_cond;
         }
 
@@ -4800,7 +8784,7 @@ static Jule_Status jule_builtin_while(Jule_Interp *interp, Jule_Value *tree, uns
 
         if (cond->type != JULE_NUMBER) {
             status = JULE_ERR_TYPE;
-            jule_make_type_error(interp, cond, JULE_NUMBER, cond->type);
+            jule_make_type_error(interp, _cond, JULE_NUMBER, cond->type);
             jule_free_value(cond);
             goto out;
         }
@@ -4877,7 +8861,7 @@ static Jule_Status jule_builtin_foreach(Jule_Interp *interp, Jule_Value *tree, u
     if (container->type != JULE_LIST
     &&  container->type != JULE_OBJECT) {
         status = JULE_ERR_TYPE;
-        jule_make_type_error(interp, container, _JULE_LIST_OR_OBJECT, container->type);
+        jule_make_type_error(interp, _container, _JULE_LIST_OR_OBJECT, container->type);
         goto out_free;
     }
 
@@ -5139,7 +9123,7 @@ static Jule_Status jule_builtin_object(Jule_Interp *interp, Jule_Value *tree, un
 
         if (ev->type != JULE_LIST) {
             status = JULE_ERR_TYPE;
-            jule_make_type_error(interp, ev, JULE_LIST, ev->type);
+            jule_make_type_error(interp, it, JULE_LIST, ev->type);
             *result = NULL;
             goto out_free_list;
         }
@@ -5156,13 +9140,14 @@ static Jule_Status jule_builtin_object(Jule_Interp *interp, Jule_Value *tree, un
 
         if (key->type != JULE_STRING && key->type != JULE_NUMBER) {
             status = JULE_ERR_OBJECT_KEY_TYPE;
-            jule_make_object_key_type_error(interp, key, key->type);
+            jule_make_object_key_type_error(interp, it, key->type);
             *result = NULL;
             goto out_free_list;
         }
 
         jule_free_value(ev);
 
+        jule_intern_value(interp, key);
         jule_insert(object, key, val);
     }
 
@@ -5213,7 +9198,7 @@ static Jule_Status jule_builtin_in(Jule_Interp *interp, Jule_Value *tree, unsign
     if (container->type == JULE_OBJECT) {
         if (key->type != JULE_NUMBER && key->type != JULE_STRING) {
             status = JULE_ERR_OBJECT_KEY_TYPE;
-            jule_make_object_key_type_error(interp, key, key->type);
+            jule_make_object_key_type_error(interp, values[1], key->type);
             *result = NULL;
             goto out_free_key;
         }
@@ -5231,7 +9216,7 @@ static Jule_Status jule_builtin_in(Jule_Interp *interp, Jule_Value *tree, unsign
         }
     } else {
         status = JULE_ERR_TYPE;
-        jule_make_type_error(interp, container, _JULE_LIST_OR_OBJECT, container->type);
+        jule_make_type_error(interp, values[0], _JULE_LIST_OR_OBJECT, container->type);
         *result = NULL;
         goto out_free_key;
     }
@@ -5266,7 +9251,7 @@ static Jule_Status jule_builtin_elem(Jule_Interp *interp, Jule_Value *tree, unsi
 
     if (i >= jule_len(list->list)) {
         status = JULE_ERR_BAD_INDEX;
-        jule_make_bad_index_error(interp, idx, jule_copy(idx));
+        jule_make_bad_index_error(interp, values[1], jule_copy(idx));
         *result = NULL;
         goto out_free;
     }
@@ -5422,7 +9407,7 @@ static Jule_Status jule_builtin_field(Jule_Interp *interp, Jule_Value *tree, uns
 
     if (object->type != JULE_OBJECT) {
         status = JULE_ERR_TYPE;
-        jule_make_type_error(interp, object, JULE_OBJECT, object->type);
+        jule_make_type_error(interp, values[0], JULE_OBJECT, object->type);
         *result = NULL;
         goto out_free_object;
     }
@@ -5435,7 +9420,7 @@ static Jule_Status jule_builtin_field(Jule_Interp *interp, Jule_Value *tree, uns
 
     if (key->type != JULE_NUMBER && key->type != JULE_STRING) {
         status = JULE_ERR_OBJECT_KEY_TYPE;
-        jule_make_object_key_type_error(interp, key, key->type);
+        jule_make_object_key_type_error(interp, values[1], key->type);
         *result = NULL;
         goto out_free_key;
     }
@@ -5444,7 +9429,7 @@ static Jule_Status jule_builtin_field(Jule_Interp *interp, Jule_Value *tree, uns
 
     if (field == NULL) {
         status = JULE_ERR_BAD_INDEX;
-        jule_make_bad_index_error(interp, key, jule_copy(key));
+        jule_make_bad_index_error(interp, values[1], jule_copy(key));
         *result = NULL;
         goto out_free_key;
     } else {
@@ -5488,6 +9473,8 @@ static Jule_Status jule_builtin_insert(Jule_Interp *interp, Jule_Value *tree, un
         }
     }
 
+    jule_intern_value(interp, key);
+
     if (jule_insert(object, key, val) == JULE_ERR_RELEASE_WHILE_BORROWED) {
         jule_make_install_error(interp, tree, JULE_ERR_RELEASE_WHILE_BORROWED, NULL);
         *result = NULL;
@@ -5572,6 +9559,7 @@ static Jule_Status jule_builtin_update_object(Jule_Interp *interp, Jule_Value *t
     hash_table_traverse((_Jule_Object)o2->object, key, val) {
         kcpy = jule_copy_force(key);
         vcpy = jule_copy_force(*val);
+        jule_intern_value(interp, kcpy);
         if (jule_insert(o1, kcpy, vcpy) == JULE_ERR_RELEASE_WHILE_BORROWED) {
             jule_free_value_force(kcpy);
             jule_free_value_force(vcpy);
@@ -5622,7 +9610,7 @@ static Jule_Status jule_builtin_erase(Jule_Interp *interp, Jule_Value *tree, uns
 
     if (i >= jule_len(list->list)) {
         status = JULE_ERR_BAD_INDEX;
-        jule_make_bad_index_error(interp, idx, jule_copy(idx));
+        jule_make_bad_index_error(interp, values[1], jule_number_value(i));
         *result = NULL;
         jule_free_value(list);
         goto out;
@@ -5735,11 +9723,15 @@ static int jule_sort_value_cmp(const void *_a, const void *_b, void *_arg) {
         JULE_ASSERT(arg->sort_type == JULE_STRING);
 
         ac = bc = NULL;
+        if (a->type == JULE_STRING && b->type == JULE_STRING) {
+            return jule_string_value_cmp(a, b);
+        }
+
         as = a->type == JULE_STRING
-                ? jule_get_string(arg->interp, a->string_id)->chars
+                ? jule_string_cstr((Jule_Value*)a)
                 : (ac = jule_to_string(arg->interp, a, JULE_NO_QUOTE));
         bs = b->type == JULE_STRING
-                ? jule_get_string(arg->interp, b->string_id)->chars
+                ? jule_string_cstr((Jule_Value*)b)
                 : (bc = jule_to_string(arg->interp, b, JULE_NO_QUOTE));
 
         r = strcmp(as, bs);
@@ -5878,7 +9870,7 @@ static Jule_Status jule_builtin_filter(Jule_Interp *interp, Jule_Value *tree, un
         }
         if (ev->type != JULE_NUMBER) {
             status = JULE_ERR_TYPE;
-            jule_make_type_error(interp, ev, JULE_NUMBER, ev->type);
+            jule_make_type_error(interp, t, JULE_NUMBER, ev->type);
             jule_free_value(ev);
             jule_free_value(filtered);
             *result = NULL;
@@ -5976,51 +9968,158 @@ out:;
     return status;
 }
 
-static Jule_Status jule_parse_nodes(Jule_Interp *interp, const char *str, int size, Jule_Array **out_nodes);
+static void jule_free_module(Jule_Module *module) {
+    Jule_Array      *it;
+    Jule_Arena      *arena;
+    Jule_Line_Table *lines;
 
-static Jule_Status jule_builtin_eval_file(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    jule_free_arena(module->arena);
+    jule_free_array(module->nodes);
+    FOR_EACH(module->retired, it) {
+        jule_free_array(it);
+    }
+    jule_free_array(module->retired);
+    FOR_EACH(module->old_arenas, arena) {
+        jule_free_arena(arena);
+    }
+    jule_free_array(module->old_arenas);
+    FOR_EACH(module->old_lines, lines) {
+        if (lines != NULL) { jule_free_line_table(lines); }
+    }
+    jule_free_array(module->old_lines);
+    JULE_FREE(module);
+}
+
+/* Find the module for path (keyed by its canonical path), parsing it if it
+ * isn't loaded yet or if the file has changed since it was. */
+static Jule_Status jule_get_module(Jule_Interp *interp, const char *path, Jule_Module **out) {
+    Jule_Status       status;
+    struct stat       fs;
+    char             *real;
+    Jule_String_ID    key;
+    Jule_Module_Ptr  *lookup;
+    Jule_Module      *module;
+    Jule_Arena       *arena;
+    Jule_Line_Table  *old_lines;
+    Jule_Array       *nodes = JULE_ARRAY_INIT;
+
+    if (stat(path, &fs) != 0) { return JULE_ERR_FILE_NOT_FOUND; }
+    if (S_ISDIR(fs.st_mode))  { return JULE_ERR_FILE_IS_DIR;    }
+
+    real = realpath(path, NULL);
+    key  = jule_get_string_id(interp, real == NULL ? path : real);
+    if (real != NULL) { free(real); }
+
+    lookup = hash_table_get_val(interp->modules, key);
+
+    if (lookup != NULL) {
+        module = *lookup;
+
+        if (module->size       == (unsigned long long)fs.st_size
+        &&  module->mtime_sec  == fs.st_mtim.tv_sec
+        &&  module->mtime_nsec == fs.st_mtim.tv_nsec) {
+
+            *out = module;
+            return JULE_SUCCESS;
+        }
+    } else {
+        module = NULL;
+    }
+
+    /* Parsing replaces the file's line table, which the old version's
+     * nodes still need. */
+    old_lines = module == NULL ? NULL : jule_take_line_table(interp, interp->cur_file);
+
+    arena  = jule_arena();
+    status = jule_parse_file_nodes(interp, path, arena, &nodes);
+    if (status != JULE_SUCCESS) {
+        jule_free_array(nodes);
+        jule_free_arena(arena);
+        if (old_lines != NULL) { jule_set_line_table(interp, interp->cur_file, old_lines); }
+        return status;
+    }
+
+    if (module == NULL) {
+        module             = JULE_MALLOC(sizeof(*module));
+        memset(module, 0, sizeof(*module));
+        module->retired    = JULE_ARRAY_INIT;
+        module->old_arenas = JULE_ARRAY_INIT;
+        module->old_lines  = JULE_ARRAY_INIT;
+        hash_table_insert(interp->modules, key, module);
+    } else {
+        /* Functions defined by the old version may still share its nodes. */
+        module->old_arenas = jule_push(module->old_arenas, module->arena);
+        module->old_lines  = jule_push(module->old_lines, old_lines);
+
+        if (module->active) {
+            module->retired = jule_push(module->retired, module->nodes);
+        } else {
+            jule_free_array(module->nodes);
+        }
+    }
+
+    module->arena      = arena;
+    module->nodes      = nodes;
+    module->size       = fs.st_size;
+    module->mtime_sec  = fs.st_mtim.tv_sec;
+    module->mtime_nsec = fs.st_mtim.tv_nsec;
+
+    *out = module;
+    return JULE_SUCCESS;
+}
+
+static Jule_Status jule_eval_file(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, int once, Jule_Value **result) {
     Jule_Status        status;
     Jule_Value        *path;
     const Jule_String *pstring;
     Jule_String_ID     save_file;
-    const char        *mem;
-    int                size;
-    Jule_Array        *nodes = JULE_ARRAY_INIT;
+    Jule_Module       *module;
+    Jule_Array        *nodes;
     unsigned           i;
     Jule_Value        *it;
     Jule_Value        *ev;
 
+    *result = NULL;
+
     status = jule_args(interp, tree, "s", n_values, values, &path);
-    if (status != JULE_SUCCESS) {
-        *result = NULL;
-        goto out;
-    }
+    if (status != JULE_SUCCESS) { goto out; }
 
-    pstring = jule_get_string(interp, path->string_id);
+    pstring = jule_get_string(interp, jule_get_string_id(interp, jule_string_cstr(path)));
     jule_free_value(path);
 
-    status = jule_map_file_into_readonly_memory(pstring->chars, &mem, &size);
-    if (status != JULE_SUCCESS) {
-        *result = NULL;
-        jule_make_file_error(interp, tree, status, pstring->chars);
-        goto out_free;
-    }
-
     save_file        = interp->cur_file;
     interp->cur_file = pstring;
 
-    status = jule_parse_nodes(interp, mem, size, &nodes);
+    status = jule_get_module(interp, pstring->chars, &module);
     if (status != JULE_SUCCESS) {
-        *result = NULL;
+        if (status == JULE_ERR_FILE_NOT_FOUND
+        ||  status == JULE_ERR_FILE_IS_DIR
+        ||  status == JULE_ERR_MMAP_FAILED) {
+
+            interp->cur_file = save_file;
+            jule_make_file_error(interp, tree, status, pstring->chars);
+        }
+        goto out_restore_file;
+    }
+
+    if (once && module->evaluated) {
+        *result = jule_nil_value();
         goto out_restore_file;
     }
 
+    module->evaluated  = 1;
+    module->active    += 1;
+
+    /* Hold on to this list: a nested load of the same file may replace
+     * module->nodes while we're still walking it. */
+    nodes = module->nodes;
+
     i = 0;
     FOR_EACH(nodes, it) {
         status = jule_eval(interp, it, &ev);
         if (status != JULE_SUCCESS) {
             *result = NULL;
-            goto out_restore_file;
+            break;
         }
 
         i += 1;
@@ -6032,8 +10131,14 @@ static Jule_Status jule_builtin_eval_file(Jule_Interp *interp, Jule_Value *tree,
         }
     }
 
+    module->active -= 1;
+
+    if (status != JULE_SUCCESS) { goto out_restore_file; }
+
     if (*result != NULL) {
-        *result = jule_copy_force(*result);
+        ev      = *result;
+        *result = jule_copy_force(ev);
+        jule_free_value(ev);
     } else {
         *result = jule_nil_value();
     }
@@ -6041,16 +10146,18 @@ static Jule_Status jule_builtin_eval_file(Jule_Interp *interp, Jule_Value *tree,
 out_restore_file:;
     interp->cur_file = save_file;
 
-out_free:;
-    FOR_EACH(nodes, it) {
-        jule_free_value_force(it);
-    }
-    jule_free_array(nodes);
-
 out:;
     return status;
 }
 
+static Jule_Status jule_builtin_eval_file(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    return jule_eval_file(interp, tree, n_values, values, 0, result);
+}
+
+static Jule_Status jule_builtin_require(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
+    return jule_eval_file(interp, tree, n_values, values, 1, result);
+}
+
 static Jule_Status jule_builtin_use_package(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
     Jule_Status        status;
     Jule_Value        *name;
@@ -6069,7 +10176,7 @@ static Jule_Status jule_builtin_use_package(Jule_Interp *interp, Jule_Value *tre
         goto out;
     }
 
-    name_string = jule_get_string(interp, name->string_id);
+    name_string = jule_get_string(interp, jule_get_string_id(interp, jule_string_cstr(name)));
     jule_free_value(name);
 
     status = jule_load_package(interp, name_string->chars, result);
@@ -6086,7 +10193,6 @@ out:;
 static Jule_Status jule_builtin_add_package_directory(Jule_Interp *interp, Jule_Value *tree, unsigned n_values, Jule_Value **values, Jule_Value **result) {
     Jule_Status        status;
     Jule_Value        *path;
-    const Jule_String *pstring;
 
     if (interp->add_package_directory_forbidden) {
         *result = NULL;
@@ -6101,12 +10207,9 @@ static Jule_Status jule_builtin_add_package_directory(Jule_Interp *interp, Jule_
         goto out;
     }
 
-    pstring = jule_get_string(interp, path->string_id);
-    jule_free_value(path);
-
-    jule_add_package_directory(interp, pstring->chars);
+    jule_add_package_directory(interp, jule_string_cstr(path));
 
-    *result = jule_string_value(interp, pstring->chars);
+    *result = path;
 
 out:;
     return status;
@@ -6131,13 +10234,15 @@ static Jule_Status jule_builtin_exit(Jule_Interp *interp, Jule_Value *tree, unsi
 
         if (exit_code->type != JULE_NUMBER) {
             status = JULE_ERR_TYPE;
-            jule_make_type_error(interp, exit_code, JULE_NUMBER, exit_code->type);
+            jule_make_type_error(interp, values[0], JULE_NUMBER, exit_code->type);
             goto out_free;
         }
     }
 
     code = exit_code != NULL ? (int)exit_code->number : 0;
 
+    jule_flush_output(interp);
+
     exit(code);
 
 out_free:;
@@ -6168,8 +10273,7 @@ static Jule_Status jule_builtin_len(Jule_Interp *interp, Jule_Value *tree, unsig
             *result = jule_copy(ev);
             break;
         case JULE_STRING:
-            string  = jule_get_string(interp, ev->string_id);
-            *result = jule_number_value(string->len);
+            *result = jule_number_value(jule_string_len(ev));
             break;
         case JULE_SYMBOL:
             string  = jule_get_string(interp, ev->symbol_id);
@@ -6181,6 +10285,9 @@ static Jule_Status jule_builtin_len(Jule_Interp *interp, Jule_Value *tree, unsig
         case JULE_OBJECT:
             *result = jule_number_value(hash_table_len((_Jule_Object)ev->object));
             break;
+        case JULE_BUILDER:
+            *result = jule_number_value(ev->builder->len);
+            break;
         case _JULE_TREE:
         case _JULE_TREE_LINE_LEADER:
         case _JULE_LAMBDA:
@@ -6226,10 +10333,13 @@ Jule_Status jule_init_interp(Jule_Interp *interp) {
     memset(interp, 0, sizeof(*interp));
 
     interp->roots        = JULE_ARRAY_INIT;
-    interp->strings      = hash_table_make_e(Char_Ptr, Jule_String_ID, jule_charptr_hash, jule_charptr_equ);
+    interp->strings      = hash_table_make_e(Jule_String_ID, Jule_String_ID, jule_string_hash, jule_string_equ);
     interp->symtab       = hash_table_make(Jule_String_ID, Jule_Value_Ptr, jule_string_id_hash);
     jule_pushlocal_symtab(interp, hash_table_make(Jule_String_ID, Jule_Value_Ptr, jule_string_id_hash));
     interp->iter_vals    = JULE_ARRAY_INIT;
+    interp->modules      = hash_table_make(Jule_String_ID, Jule_Module_Ptr, jule_string_id_hash);
+    interp->line_tables  = hash_table_make(Jule_String_ID, Jule_Line_Table_Ptr, jule_string_id_hash);
+    interp->lazy_parse   = 1;
 
 #define JULE_INSTALL_FN(_name, _fn) jule_install_fn(interp, jule_get_string_id(interp, (_name)), (_fn))
 
@@ -6274,6 +10384,13 @@ Jule_Status jule_init_interp(Jule_Interp *interp) {
     JULE_INSTALL_FN("parse-int",             jule_builtin_parse_int);
     JULE_INSTALL_FN("parse-hex",             jule_builtin_parse_hex);
     JULE_INSTALL_FN("parse-float",           jule_builtin_parse_float);
+    JULE_INSTALL_FN("parse-ints",            jule_builtin_parse_ints);
+    JULE_INSTALL_FN("parse-floats",          jule_builtin_parse_floats);
+    JULE_INSTALL_FN("builder",               jule_builtin_builder);
+    JULE_INSTALL_FN("builder-append",        jule_builtin_builder_append);
+    JULE_INSTALL_FN("builder-append-fmt",    jule_builtin_builder_append_fmt);
+    JULE_INSTALL_FN("builder-len",           jule_builtin_builder_len);
+    JULE_INSTALL_FN("builder-finish",        jule_builtin_builder_finish);
     JULE_INSTALL_FN("do",                    jule_builtin_do);
     JULE_INSTALL_FN("if",                    jule_builtin_if);
     JULE_INSTALL_FN("elif",                  jule_builtin_elif);
@@ -6305,6 +10422,8 @@ Jule_Status jule_init_interp(Jule_Interp *interp) {
     JULE_INSTALL_FN("reduce",                jule_builtin_reduce);
     JULE_INSTALL_FN("apply",                 jule_builtin_apply);
     JULE_INSTALL_FN("eval-file",             jule_builtin_eval_file);
+    JULE_INSTALL_FN("require",               jule_builtin_require);
+    JULE_INSTALL_FN("include-once",          jule_builtin_require);
     JULE_INSTALL_FN("use-package",           jule_builtin_use_package);
     JULE_INSTALL_FN("add-package-directory", jule_builtin_add_package_directory);
     JULE_INSTALL_FN("exit",                  jule_builtin_exit);
@@ -6325,7 +10444,10 @@ Jule_Status jule_interp(Jule_Interp *interp) {
         return JULE_ERR_NO_INPUT;
     }
 
-    FOR_EACH(interp->roots, root) {
+    while (interp->next_root < jule_len(interp->roots)) {
+        root               = jule_elem(interp->roots, interp->next_root);
+        interp->next_root += 1;
+
         status = jule_eval(interp, root, &result);
         if (status != JULE_SUCCESS) {
             goto out;
@@ -6338,14 +10460,24 @@ out:;
 }
 
 void jule_free(Jule_Interp *interp) {
+    unsigned              i;
     _Jule_Symbol_Table    symtab;
     Jule_Value           *it;
-    char                 *key;
+    Jule_String_ID        key;
     Jule_String_ID       *id;
+    Jule_Module_Ptr      *mod;
+    Jule_Line_Table_Ptr  *lines;
+    Jule_Arena           *arena;
     void                 *handle;
     Jule_Backtrace_Entry *bt;
 
 
+    jule_flush_output(interp);
+    if (interp->output_buff != NULL) {
+        JULE_FREE(interp->output_buff);
+        interp->output_buff = NULL;
+    }
+
     while ((symtab = jule_pop(interp->local_symtab_stack)) != NULL) {
         jule_free_symtab(symtab);
     }
@@ -6358,11 +10490,29 @@ void jule_free(Jule_Interp *interp) {
     }
     jule_free_array(interp->package_values);
 
-    FOR_EACH(interp->roots, it) {
-        jule_free_value_force(it);
-    }
     jule_free_array(interp->roots);
 
+    if (interp->stream != NULL) {
+        jule_free_parse_stream(interp->stream);
+    }
+
+    hash_table_traverse(interp->line_tables, key, lines) {
+        (void)key;
+        jule_free_line_table(*lines);
+    }
+    hash_table_free(interp->line_tables);
+
+    hash_table_traverse(interp->modules, key, mod) {
+        (void)key;
+        jule_free_module(*mod);
+    }
+    hash_table_free(interp->modules);
+
+    FOR_EACH(interp->arenas, arena) {
+        jule_free_arena(arena);
+    }
+    jule_free_array(interp->arenas);
+
     hash_table_traverse(interp->strings, key, id) {
         (void)key;
         jule_free_string((Jule_String*)jule_get_string(interp, *id));
@@ -6370,6 +10520,12 @@ void jule_free(Jule_Interp *interp) {
     }
     hash_table_free(interp->strings);
 
+    for (i = 0; i < JULE_FMT_CACHE_SIZE; i += 1) {
+        if (interp->fmt_cache[i] != NULL) { jule_free_fmt(interp->fmt_cache[i]); }
+    }
+
+    if (interp->ast_cache_dir != NULL) { JULE_FREE(interp->ast_cache_dir); }
+
     FOR_EACH(interp->package_handles, handle) {
         dlclose(handle);
     }